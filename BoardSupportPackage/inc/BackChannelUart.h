@@ -13,6 +13,7 @@
 #define BACKCHANNELUART_H_
 
 #include "BSP.h"
+#include "LCD_Perf.h"
 
 typedef enum
 {
@@ -75,4 +76,11 @@ extern void BackupChannelBmi160PrintGyro(struct bmi160_gyro_t * gyroData);
  */
 extern void BackupChannelBmi160PrintMag(struct bmi160_mag_t * magData);
 
+/*
+ * Sends the cost totals of one LCD primitive to back channel UART
+ * Param 'name': Name of the primitive
+ * Param 'stats': Totals from LCD_PerfGetStats
+ */
+extern void BackChannelPrintLcdPerf(const char * name, const LCD_PerfStats_t * stats);
+
 #endif /* BACKCHANNELUART_H_ */
@@ -0,0 +1,69 @@
+/*
+ * ButtonDebounce.h
+ *
+ * Debouncing of one push button sampled at a fixed rate
+ *  - Integrator, every sample moves a counter one step towards down or up, the state only
+ *    flips when the counter hits an end. A bounce has to last BUTTON_DEBOUNCE_SAMPLES
+ *    samples in a row to get through, single glitches never do
+ *  - Reports press and release edges, and a long press once when the button has been held
+ *    for a set number of samples (the release after it is still reported)
+ */
+
+#ifndef BOARDSUPPORTPACKAGE_BUTTONDEBOUNCE_H_
+#define BOARDSUPPORTPACKAGE_BUTTONDEBOUNCE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************** Defines ******************************************************************************/
+
+/* Samples the raw level has to agree for the state to flip */
+#define BUTTON_DEBOUNCE_SAMPLES 4
+
+/*********************************************** Defines ******************************************************************************/
+
+/*********************************************** Structures ***************************************************************************/
+
+typedef enum
+{
+    BUTTON_NONE = 0,            //Nothing happened
+    BUTTON_PRESS,               //Went down
+    BUTTON_RELEASE,             //Came back up
+    BUTTON_LONG_PRESS           //Still down after the long press time, comes once per press
+} buttonEventType_t;
+
+/*
+ * State of one button
+ */
+typedef struct ButtonDebounce_t{
+    uint8_t Integrator;         //0 (up) .. BUTTON_DEBOUNCE_SAMPLES (down)
+    bool Pressed;               //Debounced state
+    uint16_t HeldSamples;       //Samples since the press
+    bool LongReported;
+} ButtonDebounce_t;
+
+/*********************************************** Structures ***************************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Starts a button up and settled
+ */
+void ButtonDebounce_Init(ButtonDebounce_t *button);
+
+/*
+ * Adds one raw sample
+ * Param "down": Raw level, true if the contact reads closed
+ * Param "longSamples": Samples held before BUTTON_LONG_PRESS, 0 for none
+ * Returns: Event the sample caused, BUTTON_NONE most of the time
+ */
+buttonEventType_t ButtonDebounce_Sample(ButtonDebounce_t *button, bool down, uint16_t longSamples);
+
+/*
+ * Returns: true if the button is up and no bounce is being counted, sampling can stop
+ */
+bool ButtonDebounce_IsIdle(const ButtonDebounce_t *button);
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* BOARDSUPPORTPACKAGE_BUTTONDEBOUNCE_H_ */
@@ -0,0 +1,85 @@
+/*
+ * Buttons.h
+ *
+ * Debounced, event queued push buttons
+ *  - A button edge interrupt only wakes the sampler, contact bounce never reaches a thread
+ *  - While a button is active a periodic event samples it every BUTTON_SAMPLE_MS and
+ *    debounces it (ButtonDebounce), press, release and long press go to a lock-free
+ *    EventQueue. Once every button is up and settled the sampler goes back to sleep
+ *    on the edge interrupt and costs nothing until the next press
+ *  - Read events with Buttons_GetEvent (never blocks) or Buttons_WaitEvent
+ *  - The joystick button is on P4.3, it shares the PORT4 vector through Port4Interrupt
+ */
+
+#ifndef BOARDSUPPORTPACKAGE_BUTTONS_H_
+#define BOARDSUPPORTPACKAGE_BUTTONS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ButtonDebounce.h"
+
+/*********************************************** Defines ******************************************************************************/
+
+/* Time between samples while a button is active, BUTTON_DEBOUNCE_SAMPLES of them settle a press */
+#define BUTTON_SAMPLE_MS 5
+
+/* Time a button is held before BUTTON_LONG_PRESS */
+#define BUTTON_LONG_PRESS_MS 800
+
+/* Declared worst case execution time of one sample, us */
+#define BUTTON_SAMPLE_WCET 20
+
+/* An event packed into one queue word, button in bits 15:8, type in 7:0 */
+#define BUTTON_EVENT_PACK(button, type) (((uint32_t)(button) << 8) | (uint32_t)(type))
+
+/*********************************************** Defines ******************************************************************************/
+
+/*********************************************** Structures ***************************************************************************/
+
+typedef enum
+{
+    BUTTON_JOYSTICK = 0,        //Joystick push, P4.3, active low
+    BUTTONS
+} buttonId_t;
+
+typedef struct ButtonEvent_t{
+    buttonId_t Button;
+    buttonEventType_t Type;
+} ButtonEvent_t;
+
+/*********************************************** Structures ***************************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Sets up the button pins, their edge interrupts and the sampler
+ *  - Call once the kernel is initialized, the sampler is a periodic event
+ * Returns: false if the edge handler or the sampler could not be added, the edges stay off
+ */
+bool Buttons_Init();
+
+/*
+ * Takes the oldest event, one reader thread only
+ * Param "event": Returns the event
+ * Returns: false if there was none
+ */
+bool Buttons_GetEvent(ButtonEvent_t *event);
+
+/*
+ * Waits for the next event, sleeps BUTTON_SAMPLE_MS between looks
+ */
+ButtonEvent_t Buttons_WaitEvent();
+
+/*
+ * Returns: Debounced state of a button, true while it is held
+ */
+bool Buttons_IsPressed(buttonId_t button);
+
+/*
+ * Returns: Events dropped because the queue was full
+ */
+uint32_t Buttons_GetLostEvents();
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* BOARDSUPPORTPACKAGE_BUTTONS_H_ */
@@ -0,0 +1,20 @@
+/*
+ * DMAControl.h
+ *
+ * Shared uDMA control table, every driver that uses DMA goes through here
+ */
+
+#ifndef BOARDSUPPORTPACKAGE_DMACONTROL_H_
+#define BOARDSUPPORTPACKAGE_DMACONTROL_H_
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Enables the uDMA and points it at the shared control table
+ * Safe to call from every driver, only the first call does anything
+ */
+void DMAControl_Init();
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* BOARDSUPPORTPACKAGE_DMACONTROL_H_ */
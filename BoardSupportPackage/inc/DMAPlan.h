@@ -0,0 +1,64 @@
+/*
+ * DMAPlan.h
+ *
+ * Splits a long byte stream into uDMA sized chunks
+ *  - One uDMA cycle moves at most DMA_MAX_TRANSFER items, LCD_empty.c starts its fills
+ *    and blits one chunk per DMA interrupt from a plan
+ *  - Chunks stay even so an RGB565 pixel never straddles two of them
+ */
+
+#ifndef BOARDSUPPORTPACKAGE_DMAPLAN_H_
+#define BOARDSUPPORTPACKAGE_DMAPLAN_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************** Defines ******************************************************************************/
+
+/* Largest number of items one uDMA cycle can move */
+#define DMA_MAX_TRANSFER 1024
+
+/*********************************************** Defines ******************************************************************************/
+
+/*********************************************** Structures ***************************************************************************/
+
+/*
+ * Chunk plan of one transfer
+ *  - Repeat: every chunk starts over at the beginning of the source (fill pattern),
+ *    otherwise chunks walk through the source one after another (blit)
+ */
+typedef struct DMAPlan_t{
+    uint32_t Remaining;     //Bytes not handed out yet
+    uint32_t Offset;        //Stream position of the next chunk
+    uint16_t MaxChunk;      //Largest chunk, uDMA limit or length of the repeated source
+    bool Repeat;
+} DMAPlan_t;
+
+/*********************************************** Structures ***************************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Sets up the plan for a transfer
+ * Param "bytes": Length of the whole stream
+ * Param "maxChunk": Longest chunk the source allows, 0 for the uDMA limit
+ *                   (clipped to DMA_MAX_TRANSFER and kept even so pixels never split)
+ * Param "repeat": true if the source is a pattern that restarts with every chunk
+ */
+void DMAPlan_Init(DMAPlan_t *plan, uint32_t bytes, uint16_t maxChunk, bool repeat);
+
+/*
+ * Hands out the next chunk
+ * Param "sourceOffset": Returns where in the source the chunk starts
+ * Returns: Length of the chunk, 0 once the stream is done
+ */
+uint16_t DMAPlan_Next(DMAPlan_t *plan, uint32_t *sourceOffset);
+
+/*
+ * Returns: Number of chunks (and so DMA interrupts) a stream takes
+ */
+uint32_t DMAPlan_Count(uint32_t bytes, uint16_t maxChunk);
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* BOARDSUPPORTPACKAGE_DMAPLAN_H_ */
@@ -0,0 +1,84 @@
+/*
+ * DirtyRect.h
+ *
+ * Collects the screen areas that changed during a frame and paints them in one pass
+ *  - Covered areas are dropped and matching neighbors merged, so fewer rectangles
+ *    reach the LCD than were added
+ *  - Painting goes through the draw function given at init, tests/DirtyRectTest.c
+ *    replays random frames into a plain framebuffer with it
+ */
+
+#ifndef BOARDSUPPORTPACKAGE_DIRTYRECT_H_
+#define BOARDSUPPORTPACKAGE_DIRTYRECT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************** Defines ******************************************************************************/
+
+/* Most areas one frame can hold before it gets flushed early */
+#define MAX_DIRTY_RECTS 32
+
+/*********************************************** Defines ******************************************************************************/
+
+/*********************************************** Structures ***************************************************************************/
+
+/* Paints a solid area, same shape as LCD_DrawRectangle (corners inclusive) */
+typedef void (*dirtyRect_Draw_t)(int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd, uint16_t Color);
+
+/*
+ * One solid colored area that has to be repainted, corners inclusive
+ */
+typedef struct DirtyRect_t{
+    int16_t xStart;
+    int16_t xEnd;
+    int16_t yStart;
+    int16_t yEnd;
+    uint16_t Color;
+} DirtyRect_t;
+
+/*
+ * Areas of one frame in the order they were added
+ *  - Later areas paint over earlier ones, merging never changes the final picture
+ */
+typedef struct DirtyRegion_t{
+    DirtyRect_t Rects[MAX_DIRTY_RECTS];
+    uint16_t Count;
+    dirtyRect_Draw_t Draw;
+} DirtyRegion_t;
+
+/*********************************************** Structures ***************************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Starts an empty region
+ * Param "draw": Paints one area when the region is flushed (LCD_DrawRectangle on the board)
+ */
+void DirtyRect_Init(DirtyRegion_t *region, dirtyRect_Draw_t draw);
+
+/*
+ * Adds an area to repaint
+ *  - Earlier areas the new one covers completely are dropped
+ *  - Same colored areas that overlap or touch and form a rectangle are merged
+ *  - A full region is flushed first
+ */
+void DirtyRect_Add(DirtyRegion_t *region, int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd, uint16_t Color);
+
+/*
+ * Adds only what changes when a w x h block moves (top left corners)
+ *  - Trailing edges that got uncovered are painted in backColor
+ *  - Leading edges that got covered are painted in color
+ *  - Blocks that no longer overlap are erased and drawn whole
+ */
+void DirtyRect_AddMove(DirtyRegion_t *region, int16_t oldX, int16_t oldY, int16_t newX, int16_t newY,
+                       uint16_t w, uint16_t h, uint16_t color, uint16_t backColor);
+
+/*
+ * Paints every area in the order it was added and empties the region
+ */
+void DirtyRect_Flush(DirtyRegion_t *region);
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* BOARDSUPPORTPACKAGE_DIRTYRECT_H_ */
@@ -0,0 +1,65 @@
+/*
+ * EventQueue.h
+ *
+ * Lock-free queue of 32-bit events with one writer and one reader
+ *  - The writer only moves Head and the reader only moves Tail, both are single
+ *    word stores so an interrupt can post while a thread reads without a lock
+ *    or a semaphore. Nothing ever blocks, a full queue refuses the event
+ *  - EVENT_QUEUE_SIZE is a power of two, the indexes run freely and are masked
+ */
+
+#ifndef BOARDSUPPORTPACKAGE_EVENTQUEUE_H_
+#define BOARDSUPPORTPACKAGE_EVENTQUEUE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************** Defines ******************************************************************************/
+
+/* Slots per queue, a power of two */
+#define EVENT_QUEUE_SIZE 16
+
+#if (EVENT_QUEUE_SIZE & (EVENT_QUEUE_SIZE - 1)) != 0
+#error "EVENT_QUEUE_SIZE has to be a power of two"
+#endif
+
+/*********************************************** Defines ******************************************************************************/
+
+/*********************************************** Structures ***************************************************************************/
+
+typedef struct EventQueue_t{
+    volatile uint32_t Items[EVENT_QUEUE_SIZE];
+    volatile uint32_t Head;     //Events put, only the writer moves it
+    volatile uint32_t Tail;     //Events taken, only the reader moves it
+} EventQueue_t;
+
+/*********************************************** Structures ***************************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Empties a queue, not safe while the writer or the reader is running
+ */
+void EventQueue_Init(EventQueue_t *queue);
+
+/*
+ * Adds an event, writer side only
+ * Returns: false if the queue is full, the event is not added
+ */
+bool EventQueue_Put(EventQueue_t *queue, uint32_t event);
+
+/*
+ * Takes the oldest event, reader side only
+ * Param "event": Returns the event
+ * Returns: false if the queue is empty
+ */
+bool EventQueue_Get(EventQueue_t *queue, uint32_t *event);
+
+/*
+ * Returns: Events waiting in the queue
+ */
+uint32_t EventQueue_Count(const EventQueue_t *queue);
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* BOARDSUPPORTPACKAGE_EVENTQUEUE_H_ */
@@ -0,0 +1,95 @@
+/*
+ * FramePacing.h
+ *
+ * Paces drawing to the panel refresh with the ILI9325 frame marker (FMARK)
+ *  - FMARK pulses once every N frames at a set scan line, its rising edge on a GPIO
+ *    interrupt signals a semaphore, FramePacing_WaitFrame blocks on it
+ *  - The interrupt also stamps the DWT cycle counter, the smoothed time between marks
+ *    gives the refresh period and with it the line the panel is scanning right now
+ *  - FramePacing_WaitClear holds an area back until the scan is out of its way, the
+ *    panel scans screen columns in x order so an area written behind the scan never tears
+ *  - FMARK is not routed on the BoosterPack, wire the panel's FMARK pad to FRAME_FMARK_PIN.
+ *    Until FramePacing_Init is called nothing waits and drawing is free running
+ */
+
+#ifndef BOARDSUPPORTPACKAGE_FRAMEPACING_H_
+#define BOARDSUPPORTPACKAGE_FRAMEPACING_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************** Defines ******************************************************************************/
+
+/* GPIO the FMARK pad is wired to, the port interrupt belongs to this module */
+#define FRAME_FMARK_PORT        P5
+#define FRAME_FMARK_PIN         BIT0
+#define FRAME_FMARK_IRQn        PORT5_IRQn
+
+/* NVIC priority of the frame marker interrupt */
+#define FRAME_IRQ_PRIORITY      6
+
+/* CPU cycles one RGB565 pixel takes on the bus (16 SPI clocks at 12 MHz plus overhead) */
+#define FRAME_WRITE_CYCLES_PER_PIXEL 80
+
+/* Shift of the running average of the refresh period, 1/8 of each new period */
+#define FRAME_PERIOD_SMOOTHING  3
+
+/* Frame time FramePacing_WaitFrame sleeps while pacing is off */
+#define FRAME_FREE_RUN_MS       20
+
+/*********************************************** Defines ******************************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Starts pacing, turns on FMARK and its interrupt
+ * Param "frames": Panel frames per paced frame, 1, 2, 4 or 6 (others are rounded down)
+ * Param "line": Scan line FMARK pulses on, 0 is the first back porch line
+ * Returns: false if the FMARK handler could not be added, drawing stays free running
+ */
+bool FramePacing_Init(uint8_t frames, uint16_t line);
+
+/*
+ * Stops pacing, FMARK and its interrupt are turned off and drawing is free running again
+ */
+void FramePacing_Stop();
+
+/*
+ * Blocks until the next frame marker
+ *  - Sleeps FRAME_FREE_RUN_MS instead while pacing is off
+ */
+void FramePacing_WaitFrame();
+
+/*
+ * Holds back the write of an area until the scan will not cross it
+ *  - Returns at once if the write fits before the scan reaches xStart,
+ *    otherwise waits for the scan to pass xEnd
+ * Param "xStart", "xEnd": Screen columns the area covers
+ * Param "pixels": Pixels that will be written
+ */
+void FramePacing_WaitClear(int16_t xStart, int16_t xEnd, uint32_t pixels);
+
+/*
+ * Returns: Screen column the panel is scanning, < 0 or >= MAX_SCREEN_X in the porches
+ *          and -1 while the refresh period is not known yet
+ */
+int16_t FramePacing_ScanColumn();
+
+/*
+ * Returns: Measured panel refresh rate in tenths of a Hz, 0 while it is not known yet
+ */
+uint32_t FramePacing_GetRefreshRate();
+
+/*
+ * Returns: Number of frames FramePacing_WaitFrame has paced
+ */
+uint32_t FramePacing_GetFrames();
+
+/*
+ * Returns: Frame markers that went by while a frame was still being drawn
+ */
+uint32_t FramePacing_GetMissedFrames();
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* BOARDSUPPORTPACKAGE_FRAMEPACING_H_ */
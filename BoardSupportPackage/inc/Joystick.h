@@ -8,29 +8,47 @@
 #ifndef BOARDSUPPORTPACKAGE_JOYSTICK_H_
 #define BOARDSUPPORTPACKAGE_JOYSTICK_H_
 
+#include <stdint.h>
+
+/*********************************************** Defines *********************************************************************/
+
+/* Background sampling rate, every sample is the average of JOYSTICK_OVERSAMPLE X/Y pairs (4 fixed by the uDMA burst) */
+#define JOYSTICK_SAMPLE_HZ      500
+#define JOYSTICK_OVERSAMPLE     4
+
+/*********************************************** Defines *********************************************************************/
+
 /*********************************************** Public Functions *********************************************************************/
 /*
  * Initializes internal ADC
  * ADC input from P6.0 and P6.1 ( A15 and A14 )
  * Configured for 14-bit res
+ * The push button (P4.3) is handled by Buttons, debounced and queued
  */
 void Joystick_Init_Without_Interrupt();
 
 /*
- * Init's GPIO interrupt for joystick push button
- * Param: Function pointer to button handler
+ * Starts sampling the joystick in the background
+ *  - Every TIMER_A1 edge converts the next channel of a repeated sequence of
+ *    JOYSTICK_OVERSAMPLE X/Y pairs, so a sequence takes 1 / JOYSTICK_SAMPLE_HZ.
+ *    The uDMA moves each finished sequence into a ping-pong block
+ *  - DMA_INT2 averages the finished block into the latest sample and re-arms it
+ *  - GetJoystickCoordinates only reads the latest sample from then on
+ * Needs Joystick_Init_Without_Interrupt first (pins and ADC on)
  */
-void Joystick_Push_Button_Init_With_Interrupt(void (*buttonISR)(void));
+void Joystick_StartSampling();
 
 /*
- * Functions returns X and Y coordinates
+ * Returns: Number of averaged samples taken since Joystick_StartSampling
  */
-void GetJoystickCoordinates(int16_t *x_coord, int16_t *y_coord);
+uint32_t Joystick_GetSampleCount();
 
 /*
- * Function to disable joystick interrupt
+ * Functions returns X and Y coordinates
+ *  - Latest averaged sample once Joystick_StartSampling ran, never blocks
+ *  - Before that one conversion is started and waited for
  */
-void Disable_Joystick_Interrupt();
+void GetJoystickCoordinates(int16_t *x_coord, int16_t *y_coord);
 
 /*********************************************** Public Functions *********************************************************************/
 
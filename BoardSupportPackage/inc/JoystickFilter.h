@@ -0,0 +1,95 @@
+/*
+ * JoystickFilter.h
+ *
+ * Conditioning of centered joystick readings (GetJoystickCoordinates) into stick positions
+ *  - Moving average over the last 2^AverageShift readings takes out the ADC noise
+ *  - Radial deadzone around the center, the rest of the throw is stretched back to full scale
+ *  - Exponential response curve, a blend of linear and cubic, for fine control near the center
+ *  - Change threshold, small wobbles are not reported so nothing gets redrawn or sent for them.
+ *    Coming back to rest and reaching full deflection are always reported
+ *  - tests/JoystickFilterTest.c checks the response and the reporting rules on the host
+ */
+
+#ifndef BOARDSUPPORTPACKAGE_JOYSTICKFILTER_H_
+#define BOARDSUPPORTPACKAGE_JOYSTICKFILTER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************** Defines ******************************************************************************/
+
+/* Largest moving average, 2^JOYSTICK_FILTER_MAX_SHIFT readings */
+#define JOYSTICK_FILTER_MAX_SHIFT   4
+#define JOYSTICK_FILTER_MAX_AVERAGE (1 << JOYSTICK_FILTER_MAX_SHIFT)
+
+/* Full deflection of a centered 14-bit reading */
+#define JOYSTICK_FILTER_FULL_SCALE  8192
+
+/* Expo is a blend weight out of this, 0 is linear and JOYSTICK_FILTER_EXPO_ONE is cubic */
+#define JOYSTICK_FILTER_EXPO_ONE    256
+
+/*********************************************** Defines ******************************************************************************/
+
+/*********************************************** Structures ***************************************************************************/
+
+/*
+ * Tuning of the stages, all integer
+ */
+typedef struct JoystickFilterConfig_t{
+    uint8_t AverageShift;       //Average over 2^AverageShift readings, 0 to JOYSTICK_FILTER_MAX_SHIFT
+    uint16_t Deadzone;          //Radius around the center that reads as rest, raw counts
+    uint16_t Expo;              //0 (linear) to JOYSTICK_FILTER_EXPO_ONE (cubic)
+    int16_t OutputMax;          //Output at full deflection
+    int16_t Threshold;          //Smallest change of either axis that is reported, output units
+} JoystickFilterConfig_t;
+
+/*
+ * State of one stick
+ */
+typedef struct JoystickFilter_t{
+    JoystickFilterConfig_t Config;
+    int16_t HistoryX[JOYSTICK_FILTER_MAX_AVERAGE];
+    int16_t HistoryY[JOYSTICK_FILTER_MAX_AVERAGE];
+    int32_t SumX;
+    int32_t SumY;
+    uint8_t Next;               //Oldest reading, overwritten next
+    uint8_t Count;              //Readings in the history, the average starts before it is full
+    int16_t ReportedX;          //Last reported position
+    int16_t ReportedY;
+} JoystickFilter_t;
+
+/*********************************************** Structures ***************************************************************************/
+
+/*********************************************** Public Data **************************************************************************/
+
+/* 4 reading average, 7% deadzone, half expo, +-512 out, changes of 8 and up */
+extern const JoystickFilterConfig_t JoystickFilter_DefaultConfig;
+
+/*********************************************** Public Data **************************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Starts a filter at rest
+ * Param "config": Tuning, copied into the filter
+ */
+void JoystickFilter_Init(JoystickFilter_t *filter, const JoystickFilterConfig_t *config);
+
+/*
+ * Adds one centered reading
+ * Param "rawX", "rawY": Reading from GetJoystickCoordinates, about +-8192
+ * Param "x", "y": Return the reported position, -OutputMax .. OutputMax
+ * Returns: true if the reported position changed
+ */
+bool JoystickFilter_Update(JoystickFilter_t *filter, int16_t rawX, int16_t rawY, int16_t *x, int16_t *y);
+
+/*
+ * Deadzone and curve stages of JoystickFilter_Update on its own, no state is touched
+ * Param "rawX", "rawY": Averaged centered reading
+ * Param "x", "y": Return the conditioned position, -OutputMax .. OutputMax
+ */
+void JoystickFilter_Shape(const JoystickFilterConfig_t *config, int32_t rawX, int32_t rawY, int16_t *x, int16_t *y);
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* BOARDSUPPORTPACKAGE_JOYSTICKFILTER_H_ */
@@ -0,0 +1,72 @@
+/*
+ * LCDQueue.h
+ *
+ * Asynchronous LCD drawing through one render thread
+ *  - Any number of threads post commands without waiting on the SPI bus, a post only
+ *    holds the queue lock for the copy into the queue
+ *  - LCDQueue_Thread runs every command on EUSCI_B3 in the order they were posted
+ *  - Blits of up to RENDER_BLIT_COPY_MAX pixels are copied into the command, so their
+ *    buffer can be reused right after the post. Larger blits only queue the pointer,
+ *    DrawObjects keeps compositing and blitting its reused tile buffer itself
+ *  - Privileged threads only, the queue is read only to protected threads
+ */
+
+#ifndef BOARDSUPPORTPACKAGE_LCDQUEUE_H_
+#define BOARDSUPPORTPACKAGE_LCDQUEUE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "RenderQueue.h"
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Empties the queue, call before the render thread is added
+ */
+void LCDQueue_Init();
+
+/*
+ * Render thread, add it with G8RTOS_AddThread
+ *  - Sleeps until something is posted, then draws everything pending in order
+ */
+void LCDQueue_Thread();
+
+/*
+ * Posts LCD_DrawRectangle (corners inclusive)
+ * Returns: false if the queue is full and the command was dropped
+ */
+bool LCDQueue_Rectangle(int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd, uint16_t Color);
+
+/*
+ * Posts LCD_BlitRGB565
+ *  - Up to RENDER_BLIT_COPY_MAX pixels are copied, the buffer is free again on return
+ *  - Past that only the pointer is queued, the pixels must stay unchanged until they are drawn
+ * Returns: false if the queue is full and the command was dropped
+ */
+bool LCDQueue_Blit(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint16_t *pixels);
+
+/*
+ * Posts LCD_Text, the string is copied (up to RENDER_TEXT_MAX characters)
+ * Returns: false if the queue is full and the command was dropped
+ */
+bool LCDQueue_Text(uint16_t Xpos, uint16_t Ypos, const char *str, uint16_t Color, uint16_t bkColor);
+
+/*
+ * Posts LCD_Clear, everything still pending is dropped
+ * Returns: false if the queue is full and the command was dropped
+ */
+bool LCDQueue_Clear(uint16_t Color);
+
+/*
+ * Returns: Commands dropped because a later one painted over them
+ */
+uint32_t LCDQueue_GetCoalesced();
+
+/*
+ * Returns: Commands dropped because the queue was full
+ */
+uint32_t LCDQueue_GetRejected();
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* BOARDSUPPORTPACKAGE_LCDQUEUE_H_ */
@@ -0,0 +1,52 @@
+/*
+ * LCD_Benchmark.h
+ *
+ * ILI9325 throughput benchmark of the LCD drawing primitives
+ *  - On the board every case is timed with the DWT cycle counter,
+ *    run it before G8RTOS_Launch so no other thread is counted
+ *  - Under LCD_EMULATOR the bus bytes of every case are counted instead and
+ *    the rate is what the bus allows at LCD_SPI_CLOCK
+ */
+
+#ifndef BOARDSUPPORTPACKAGE_LCD_BENCHMARK_H_
+#define BOARDSUPPORTPACKAGE_LCD_BENCHMARK_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************** Defines ******************************************************************************/
+
+/* Clear, 8x8 rect, 64x64 rect, 32x32 blit, 8x8 blit, one line of text */
+#define LCD_BENCH_CASES 6
+
+/* Calls per case, the average is reported */
+#define LCD_BENCH_REPEAT 8
+
+/*********************************************** Defines ******************************************************************************/
+
+/*********************************************** Structures ***************************************************************************/
+
+/*
+ * Result of one case, all per call
+ */
+typedef struct LCD_BenchResult_t{
+    const char *Name;
+    uint32_t Pixels;
+    uint32_t Cycles;            //CPU cycles (board only, 0 under the emulator)
+    uint32_t Bytes;             //Bus bytes (emulator only, 0 on the board)
+    uint32_t KPixelsPerSecond;
+} LCD_BenchResult_t;
+
+/*********************************************** Structures ***************************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Runs every case LCD_BENCH_REPEAT times, the screen is left cleared to black
+ * Param "results": LCD_BENCH_CASES results, in the order of the cases above
+ */
+void LCD_Benchmark(LCD_BenchResult_t *results);
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* BOARDSUPPORTPACKAGE_LCD_BENCHMARK_H_ */
@@ -0,0 +1,98 @@
+/*
+ * LCD_Emulator.h
+ *
+ * Virtual ILI9325 behind the LCD SPI bus, for running the drawing code on a PC
+ *  - Only built with LCD_EMULATOR defined, LCD_empty.c then sends every SPI byte and
+ *    chip select edge here instead of EUSCI_B3 and P10
+ *  - Decodes index writes, register writes and reads, the GRAM window and the
+ *    address counter (ENTRY_MODE AM and I/D bits) into a 320x240 RGB565 framebuffer
+ *  - Counts the bus traffic so drawing primitives can be compared byte for byte
+ *
+ * Host build, for example:
+ *  gcc -DLCD_EMULATOR -fgnu89-inline -IBoardSupportPackage/inc test.c
+ *      BoardSupportPackage/src/LCD_empty.c BoardSupportPackage/src/LCD_Emulator.c
+ *      BoardSupportPackage/src/AsciiLib.c BoardSupportPackage/src/DMAPlan.c
+ *      BoardSupportPackage/src/LCD_Font.c BoardSupportPackage/src/LCD_FontTables.c
+ *      BoardSupportPackage/src/TouchFilter.c
+ *  - tests/LCDGoldenTest.c compares the primitives with reference framebuffers,
+ *    run it with make in BoardSupportPackage/tests
+ */
+
+#ifndef BOARDSUPPORTPACKAGE_LCD_EMULATOR_H_
+#define BOARDSUPPORTPACKAGE_LCD_EMULATOR_H_
+
+#ifdef LCD_EMULATOR
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************** Structures ***************************************************************************/
+
+/*
+ * Bus traffic since the last LCDEmu_ResetStats
+ */
+typedef struct LCDEmu_Stats_t{
+    uint32_t Bytes;             //Bytes clocked while the LCD was selected
+    uint32_t Transactions;      //Chip select low periods
+    uint32_t RegisterWrites;    //Index + data pairs outside GRAM
+    uint32_t Pixels;            //Pixels written to GRAM
+} LCDEmu_Stats_t;
+
+/*********************************************** Structures ***************************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Puts the controller in its reset state (registers at their defaults, black GRAM)
+ * and clears the counters
+ */
+void LCDEmu_Reset();
+
+/*
+ * LCD chip select, true while CS is low
+ */
+void LCDEmu_ChipSelect(bool selected);
+
+/*
+ * Clocks one byte over the bus
+ * Returns: Byte the controller shifts back (register and GRAM reads)
+ */
+uint8_t LCDEmu_Transfer(uint8_t byte);
+
+/*
+ * Returns: Screen pixel (landscape, x across 320 and y down 240) as RGB565, after the scroll offset
+ */
+uint16_t LCDEmu_GetPixel(uint16_t x, uint16_t y);
+
+/*
+ * Returns: Last value written to a register
+ */
+uint16_t LCDEmu_GetRegister(uint8_t index);
+
+/*
+ * Returns: Bus traffic counted so far
+ */
+LCDEmu_Stats_t LCDEmu_GetStats();
+
+/*
+ * Clears the bus traffic counters
+ */
+void LCDEmu_ResetStats();
+
+/*
+ * Writes the screen as a binary PPM (P6)
+ * Returns: false if the file could not be written
+ */
+bool LCDEmu_WritePPM(const char *path);
+
+/*
+ * Writes the screen as an RGB PNG (stored, uncompressed deflate blocks)
+ * Returns: false if the file could not be written
+ */
+bool LCDEmu_WritePNG(const char *path);
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* LCD_EMULATOR */
+
+#endif /* BOARDSUPPORTPACKAGE_LCD_EMULATOR_H_ */
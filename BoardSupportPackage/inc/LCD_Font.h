@@ -0,0 +1,109 @@
+/*
+ * LCD_Font.h
+ *
+ * Fonts for the LCD text functions and a cache of glyphs already expanded to pixels
+ *  - Fixed and proportional fonts, drawn at 1x up to FONT_MAX_SCALE (2x for scores)
+ *  - Glyph tables are generated from AsciiLib.c by tools/fontgen.py (LCD_FontTables.c)
+ *  - The last FONT_CACHE_GLYPHS unscaled glyphs drawn are kept as RGB565 in bus byte order
+ *    for their colors, repeated HUD text goes straight from the cache to the SPI bus
+ */
+
+#ifndef BOARDSUPPORTPACKAGE_LCD_FONT_H_
+#define BOARDSUPPORTPACKAGE_LCD_FONT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************** Defines ******************************************************************************/
+
+/* Largest scale, every font pixel becomes a scale x scale block */
+#define FONT_MAX_SCALE 4
+
+/* Widest and tallest glyph in the tables, one row byte plus a blank column */
+#define FONT_MAX_WIDTH 9
+#define FONT_MAX_HEIGHT 16
+
+/* Glyphs kept expanded, the digits of a score or a clock come back all the time (about 1.8 KB of SRAM) */
+#define FONT_CACHE_GLYPHS 6
+
+/* Room for one unscaled glyph, 2 bytes per pixel. Scaled glyphs are expanded row by row instead */
+#define FONT_CACHE_BYTES (FONT_MAX_WIDTH * FONT_MAX_HEIGHT * 2)
+
+/*********************************************** Defines ******************************************************************************/
+
+/*********************************************** Structures ***************************************************************************/
+
+/*
+ * Font descriptor, const so it and its tables stay in flash
+ *  - Characters outside FirstChar..LastChar are drawn as FirstChar (space)
+ */
+typedef struct Font_t{
+    uint8_t FirstChar;
+    uint8_t LastChar;
+    uint8_t Width;              //Advance of every glyph if Widths is 0
+    uint8_t Height;
+    const uint8_t *Widths;      //Advance per glyph for proportional fonts, 0 for fixed
+    const uint8_t *Rows;        //Height bytes per glyph, bit 7 is the leftmost pixel
+} Font_t;
+
+/*
+ * Glyph ready to go out, Bytes is Width * Height big endian RGB565 pixels row after row
+ */
+typedef struct FontGlyph_t{
+    uint16_t Width;
+    uint16_t Height;
+    const uint8_t *Bytes;
+} FontGlyph_t;
+
+/*********************************************** Structures ***************************************************************************/
+
+/*********************************************** Fonts ********************************************************************************/
+
+/* AsciiLib 8x16 System font, 8 pixels per character */
+extern const Font_t Font_System8x16;
+
+/* Same glyphs with their own width, narrow characters take less room */
+extern const Font_t Font_Proportional;
+
+/*********************************************** Fonts ********************************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Returns: Advance of one character at 1x in pixels
+ */
+uint16_t Font_Advance(const Font_t *font, uint8_t ch);
+
+/*
+ * Returns: Width of a string in pixels at the given scale (no wrapping)
+ */
+uint16_t Font_TextWidth(const Font_t *font, const char *str, uint8_t scale);
+
+/*
+ * Looks a glyph up in the cache, expanding it into the least recently used entry on a miss
+ * Param "glyph": Returns the size and pixels of the glyph
+ * Returns: false for scaled glyphs, they are not cached, draw them with Font_ExpandRow
+ */
+bool Font_GetGlyph(const Font_t *font, uint8_t ch, uint8_t scale, uint16_t color, uint16_t bkColor, FontGlyph_t *glyph);
+
+/*
+ * Expands one font row of a glyph, scaled across but not down (send it "scale" times)
+ * Param "row": Font row, 0 to Height - 1
+ * Param "out": Advance * scale big endian RGB565 pixels
+ */
+void Font_ExpandRow(const Font_t *font, uint8_t ch, uint16_t row, uint8_t scale, uint16_t color, uint16_t bkColor, uint8_t *out);
+
+/*
+ * Empties the cache
+ */
+void Font_ClearCache();
+
+/*
+ * Returns: Cache lookups that found the glyph already expanded / that had to expand it
+ */
+uint32_t Font_GetCacheHits();
+uint32_t Font_GetCacheMisses();
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* BOARDSUPPORTPACKAGE_LCD_FONT_H_ */
@@ -0,0 +1,129 @@
+/*
+ * LCD_Perf.h
+ *
+ * Cost counters of the LCD drawing primitives
+ *  - Every call of an instrumented primitive records its pixels, register (index)
+ *    writes, bus bytes and cycles, a primitive called by another one is counted
+ *    in the outer one (LCD_Clear is not also a rectangle)
+ *  - Cycles come from the DWT counter and are wall time, other threads that run
+ *    while a call blocks on the uDMA are in there too. Under LCD_EMULATOR they are
+ *    what the bytes take on the bus at 12 MHz
+ *  - A histogram of the cycles per call shows the outliers an average hides
+ *  - Read at runtime with LCD_PerfGetStats or stream with LCD_PerfPrint
+ *  - Build with LCD_PERF=0 to compile the counting out of LCD_empty.c
+ */
+
+#ifndef BOARDSUPPORTPACKAGE_LCD_PERF_H_
+#define BOARDSUPPORTPACKAGE_LCD_PERF_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************** Defines ******************************************************************************/
+
+#ifndef LCD_PERF
+#define LCD_PERF 1
+#endif
+
+/* Histogram buckets, 0 is under 1024 cycles (21 us), each next one is twice as wide, the last is open */
+#define LCD_PERF_BUCKETS        12
+#define LCD_PERF_BUCKET_SHIFT   10
+
+/* CPU cycles per bus byte, used for the emulator's cycle counts (48 MHz core, 12 MHz SPI) */
+#define LCD_PERF_EMU_CYCLES_PER_BYTE 32
+
+/*********************************************** Defines ******************************************************************************/
+
+/*********************************************** Structures ***************************************************************************/
+
+typedef enum
+{
+    LCD_PERF_RECTANGLE = 0,     //LCD_DrawRectangle
+    LCD_PERF_CLEAR,             //LCD_Clear
+    LCD_PERF_POINT,             //LCD_SetPoint
+    LCD_PERF_TEXT,              //LCD_Text
+    LCD_PERF_FONT_TEXT,         //LCD_FontText
+    LCD_PERF_BLIT,              //LCD_BlitRGB565
+    LCD_PERF_LINE,              //LCD_DrawLine
+    LCD_PERF_CIRCLE,            //LCD_DrawCircle and LCD_FillCircle
+    LCD_PERF_PRIMITIVES
+} lcdPerfPrimitive_t;
+
+/*
+ * What the call in progress has sent so far, bumped by the LCD driver
+ */
+typedef struct LCD_PerfCounters_t{
+    uint32_t Pixels;
+    uint32_t RegWrites;
+    uint32_t Bytes;
+} LCD_PerfCounters_t;
+
+/*
+ * Totals of one primitive since the last reset
+ */
+typedef struct LCD_PerfStats_t{
+    uint32_t Calls;
+    uint32_t Pixels;
+    uint32_t RegWrites;
+    uint32_t Bytes;
+    uint64_t Cycles;
+    uint32_t MaxCycles;
+    uint32_t Histogram[LCD_PERF_BUCKETS];
+} LCD_PerfStats_t;
+
+/*********************************************** Structures ***************************************************************************/
+
+/*********************************************** Externs ******************************************************************************/
+
+/* Counters of the call in progress */
+extern LCD_PerfCounters_t LCD_PerfCurrent;
+
+/*********************************************** Externs ******************************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Starts timing a call, nested calls only count towards the outer one
+ * Param "primitive": Primitive being called
+ */
+void LCD_PerfBegin(lcdPerfPrimitive_t primitive);
+
+/*
+ * Ends the call started by the matching LCD_PerfBegin and records it
+ */
+void LCD_PerfEnd();
+
+/*
+ * Clears every total and starts a new measuring window
+ */
+void LCD_PerfReset();
+
+/*
+ * Returns: Totals of a primitive since the last reset
+ */
+const LCD_PerfStats_t *LCD_PerfGetStats(lcdPerfPrimitive_t primitive);
+
+/*
+ * Returns: Short name of a primitive ("rectangle", "text", ...)
+ */
+const char *LCD_PerfName(lcdPerfPrimitive_t primitive);
+
+/*
+ * Returns: Histogram bucket a call of this many cycles falls in
+ */
+uint16_t LCD_PerfBucket(uint32_t cycles);
+
+/*
+ * Returns: Share of the time since the last reset spent in the primitives, in tenths
+ *          of a percent. 0 under LCD_EMULATOR, there is no wall clock to compare with
+ */
+uint32_t LCD_PerfGetLoad();
+
+/*
+ * Streams the totals of every primitive that was called and the load over the back channel UART
+ */
+void LCD_PerfPrint();
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* BOARDSUPPORTPACKAGE_LCD_PERF_H_ */
@@ -10,6 +10,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include "LCD_Font.h"
 /************************************ Defines *******************************************/
 
 /* Screen size */
@@ -19,6 +20,10 @@
 #define MIN_SCREEN_Y     0
 #define SCREEN_SIZE      76800
 
+/* Font cell of PutChar and LCD_Text */
+#define LCD_CHAR_WIDTH   8
+#define LCD_CHAR_HEIGHT  16
+
 /* Register details */
 #define SPI_START   (0x70)     /* Start byte for SPI transfer        */
 #define SPI_RD      (0x01)     /* WR bit 1 within start              */
@@ -26,6 +31,8 @@
 #define SPI_DATA    (0x02)     /* RS bit 1 within start byte         */
 #define SPI_INDEX   (0x00)     /* RS bit 0 within start byte         */
 
+#ifndef LCD_EMULATOR
+
 /* CS LCD*/
 #define SPI_CS_LOW P10OUT &= ~BIT4
 #define SPI_CS_HIGH P10OUT |= BIT4
@@ -34,6 +41,17 @@
 #define SPI_CS_TP_LOW P10OUT &= ~BIT5
 #define SPI_CS_TP_HIGH P10OUT |= BIT5
 
+#else
+
+/* Chip selects of the emulated bus, see LCD_Emulator.h */
+#include "LCD_Emulator.h"
+#define SPI_CS_LOW LCDEmu_ChipSelect(true)
+#define SPI_CS_HIGH LCDEmu_ChipSelect(false)
+#define SPI_CS_TP_LOW
+#define SPI_CS_TP_HIGH
+
+#endif
+
 /* XPT2046 registers definition for X and Y coordinate retrieval */
 #define CHX         0x90
 #define CHY         0xD0
@@ -94,6 +112,22 @@
 #define GATE_SCAN_CONTROL_0X60              0x60
 #define GATE_SCAN_CONTROL_0X61              0x61
 #define GATE_SCAN_CONTROL_0X6A              0x6A
+
+/* GATE_SCAN_CONTROL_0X61 bits */
+#define GATE_SCAN_REV                       0x0001  /* Grayscale inversion */
+#define GATE_SCAN_VLE                       0x0002  /* Vertical scroll enable */
+
+/* DISPLAY_CONTROL_4 bits */
+#define FMARK_OUTPUT_ENABLE                 0x0008  /* FMARKOE, pulse on the FMARK pin */
+#define FMARK_EVERY_FRAME                   0x0000  /* FMI[2:0], frames between pulses */
+#define FMARK_EVERY_2_FRAMES                0x0001
+#define FMARK_EVERY_4_FRAMES                0x0003
+#define FMARK_EVERY_6_FRAMES                0x0005
+
+/* Porches set in DISPLAY_CONTROL_2, one frame scans this many lines */
+#define LCD_FRONT_PORCH_LINES               2
+#define LCD_BACK_PORCH_LINES                7
+#define LCD_FRAME_LINES                     (MAX_SCREEN_X + LCD_FRONT_PORCH_LINES + LCD_BACK_PORCH_LINES)
 #define PART_IMAGE_1_DISPLAY_POS            0x80
 #define PART_IMG_1_START_END_ADDR_0x81      0x81
 #define PART_IMG_1_START_END_ADDR_0x82      0x81
@@ -129,6 +163,106 @@ typedef struct Point {
  *******************************************************************************/
 void LCD_DrawRectangle(int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd, uint16_t Color);
 
+/*******************************************************************************
+ * Function Name  : LCD_DrawLine
+ * Description    : Draws a one pixel wide line between two points (Bresenham)
+ * Input          : - x0, y0: first end point
+ *                  - x1, y1: second end point
+ *                  - Color: line color
+ * Output         : None
+ * Return         : None
+ * Attention      : Drawn as runs along the major axis, one window burst per run
+ *                  instead of 18 bytes per pixel. Clipped to the screen
+ *******************************************************************************/
+void LCD_DrawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t Color);
+
+/*******************************************************************************
+ * Function Name  : LCD_DrawCircle
+ * Description    : Draws the outline of a circle
+ * Input          : - xCenter, yCenter: center of the circle
+ *                  - radius: radius in pixels
+ *                  - Color: outline color
+ * Output         : None
+ * Return         : None
+ * Attention      : Outline of LCD_FillCircle with the same radius, at most two
+ *                  horizontal spans per row. Clipped to the screen
+ *******************************************************************************/
+void LCD_DrawCircle(int16_t xCenter, int16_t yCenter, uint16_t radius, uint16_t Color);
+
+/*******************************************************************************
+ * Function Name  : LCD_FillCircle
+ * Description    : Draws a filled circle
+ * Input          : - xCenter, yCenter: center of the circle
+ *                  - radius: radius in pixels
+ *                  - Color: fill color
+ * Output         : None
+ * Return         : None
+ * Attention      : One horizontal span per row, rows above and below the center
+ *                  share their column registers. Clipped to the screen
+ *******************************************************************************/
+void LCD_FillCircle(int16_t xCenter, int16_t yCenter, uint16_t radius, uint16_t Color);
+
+/*******************************************************************************
+ * Function Name  : LCD_BlitRGB565
+ * Description    : Draws a block of pixels
+ * Input          : - x, y: top left corner on the screen (may be off screen)
+ *                  - w, h: size of the block
+ *                  - pixels: RGB565 pixels, row after row (pixels[row * w + column])
+ * Output         : None
+ * Return         : None
+ * Attention      : The window is set once and every pixel goes out in one CS low
+ *                  burst, 2 bytes per pixel instead of 18 for LCD_SetPoint.
+ *                  Clipped to the screen
+ *******************************************************************************/
+void LCD_BlitRGB565(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint16_t *pixels);
+
+/*******************************************************************************
+ * Function Name  : LCD_SetScroll
+ * Description    : Sets the hardware scroll offset
+ * Input          : - line: GRAM column shown at the left edge of the screen
+ * Output         : None
+ * Return         : None
+ * Attention      : The panel scrolls along its 320 gate lines, which is x in
+ *                  landscape. Screen column x shows GRAM column (x + line) % 320
+ *******************************************************************************/
+void LCD_SetScroll(uint16_t line);
+
+/*******************************************************************************
+ * Function Name  : LCD_Scroll
+ * Description    : Scrolls the whole screen sideways and clears what comes in
+ * Input          : - columns: > 0 moves the picture left, < 0 moves it right
+ *                  - bkColor: color of the newly exposed columns
+ * Output         : None
+ * Return         : GRAM x of the first newly exposed column
+ * Attention      : One register write plus a fill of the exposed strip. Draw the
+ *                  new content at the returned x, it may wrap past 319 to 0
+ *******************************************************************************/
+uint16_t LCD_Scroll(int16_t columns, uint16_t bkColor);
+
+/*******************************************************************************
+ * Function Name  : LCD_ScreenToGramX
+ * Description    : Translates a screen column into the GRAM column shown there
+ * Input          : - x: screen column
+ * Output         : None
+ * Return         : GRAM column, what the drawing functions take as x
+ * Attention      : Identity while the scroll offset is 0
+ *******************************************************************************/
+uint16_t LCD_ScreenToGramX(uint16_t x);
+
+/*******************************************************************************
+ * Function Name  : LCD_SetFrameMarker
+ * Description    : Turns the FMARK frame marker output on or off
+ * Input          : - interval: FMARK_EVERY_* frames, ignored when off
+ *                  - line: scan line the pulse comes out on, 0 is the first
+ *                    back porch line
+ *                  - enable: true to pulse FMARK
+ * Output         : None
+ * Return         : None
+ * Attention      : The panel scans its gate lines in screen x order, screen
+ *                  column x is drawn LCD_BACK_PORCH_LINES + x lines after line 0
+ *******************************************************************************/
+void LCD_SetFrameMarker(uint16_t interval, uint16_t line, bool enable);
+
 /******************************************************************************
 * Function Name  : PutChar
 * Description    : Lcd screen displays a character
@@ -136,11 +270,12 @@ void LCD_DrawRectangle(int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEn
 *                  - Ypos: Vertical coordinate
 *                  - ASCI: Displayed character
 *                  - charColor: Character color
+*                  - bkColor: Background color
 * Output         : None
 * Return         : None
-* Attention      : None
+* Attention      : The whole 8x16 cell is written, no need to clear old text first
 *******************************************************************************/
-inline void PutChar( uint16_t Xpos, uint16_t Ypos, uint8_t ASCI, uint16_t charColor);
+void PutChar( uint16_t Xpos, uint16_t Ypos, uint8_t ASCI, uint16_t charColor, uint16_t bkColor);
 
 /******************************************************************************
 * Function Name  : LCD_Text
@@ -148,12 +283,32 @@ inline void PutChar( uint16_t Xpos, uint16_t Ypos, uint8_t ASCI, uint16_t charCo
 * Input          : - Xpos: Horizontal coordinate
 *                  - Ypos: Vertical coordinate
 *                  - str: Displayed string
-*                  - charColor: Character color
+*                  - Color: Character color
+*                  - bkColor: Background color
 * Output         : None
 * Return         : None
-* Attention      : None
+* Attention      : Characters that share a line are drawn as one window and one
+*                  pixel burst. Wraps to the next line, then back to the top
+*******************************************************************************/
+void LCD_Text(uint16_t Xpos, uint16_t Ypos, uint8_t *str, uint16_t Color, uint16_t bkColor);
+
+/******************************************************************************
+* Function Name  : LCD_FontText
+* Description    : Displays the string in a font and size from LCD_Font.h
+* Input          : - Xpos: Horizontal coordinate
+*                  - Ypos: Vertical coordinate
+*                  - str: Displayed string
+*                  - font: Font_System8x16, Font_Proportional, ...
+*                  - scale: 1 to FONT_MAX_SCALE
+*                  - Color: Character color
+*                  - bkColor: Background color
+* Output         : None
+* Return         : None
+* Attention      : One window per glyph, glyphs in the font cache go straight from
+*                  there to the bus. Wraps to the next line, then back to the top
 *******************************************************************************/
-void LCD_Text(uint16_t Xpos, uint16_t Ypos, uint8_t *str,uint16_t Color);
+void LCD_FontText(uint16_t Xpos, uint16_t Ypos, const char *str, const Font_t *font, uint8_t scale, uint16_t Color, uint16_t bkColor);
+
 
 /*******************************************************************************
 * Function Name  : LCD_Write_Data_Only
@@ -232,10 +387,30 @@ inline uint8_t SPISendRecvTPByte (uint8_t byte);
 * Input          : uint8_t: byte
 * Output         : None
 * Return         : Recieved value 
-* Attention      : None
+* Attention      : Full round trip, only for reads. Writes go through LCD_SPIWrite
 *******************************************************************************/
 inline uint8_t SPISendRecvByte(uint8_t byte);
 
+/*******************************************************************************
+* Function Name  : LCD_SPIWrite
+* Description    : Queues one byte for the LCD without waiting for an answer
+* Input          : byte
+* Output         : None
+* Return         : None
+* Attention      : Write-only fast path, RX is drained by LCD_SPIFinish
+*******************************************************************************/
+inline void LCD_SPIWrite(uint8_t byte);
+
+/*******************************************************************************
+* Function Name  : LCD_SPIFinish
+* Description    : Waits until every queued byte is on the wire
+* Input          : None
+* Output         : None
+* Return         : None
+* Attention      : Has to run before CS goes high
+*******************************************************************************/
+inline void LCD_SPIFinish();
+
 /*******************************************************************************
 * Function Name  : LCD_Write_Data_Start
 * Description    : Start of data writing to the LCD controller
@@ -288,13 +463,25 @@ inline void LCD_SetCursor(uint16_t Xpos, uint16_t Ypos );
 *******************************************************************************/
 void LCD_Init(bool usingTP);
 
+/*******************************************************************************
+ * Function Name  : TP_ReadChannel
+ * Description    : One 12 bit conversion of the touch controller
+ * Input          : - command: CHX or CHY
+ * Output         : None
+ * Return         : Raw reading, 0 to 4095
+ * Attention      : Data comes back as 16 bits in 2 bytes, bits 11:5 then 4:0
+ *                  followed by 3 zero bits
+ *******************************************************************************/
+uint16_t TP_ReadChannel(uint8_t command);
+
 /*******************************************************************************
  * Function Name  : TP_ReadXY
  * Description    : Obtain X and Y touch coordinates
  * Input          : None
  * Output         : None
  * Return         : Point structure
- * Attention      : None
+ * Attention      : One unfiltered reading mapped with TouchCal_Default,
+ *                  Touch.h has the filtered, interrupt driven version
  *******************************************************************************/
 Point TP_ReadXY();
 
@@ -0,0 +1,39 @@
+/*
+ * Port4Interrupt.h
+ *
+ * Shared PORT4 interrupt vector
+ *  - The touch controller (P4.0 PENIRQ) and the joystick button (P4.3) both interrupt on PORT4,
+ *    the vector can only hold one handler so every pin handler is registered here instead
+ *  - The dispatcher calls the handler of every pin that is flagged and enabled,
+ *    a handler clears the IFG bits of its own pins
+ */
+
+#ifndef BOARDSUPPORTPACKAGE_PORT4INTERRUPT_H_
+#define BOARDSUPPORTPACKAGE_PORT4INTERRUPT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************** Defines ******************************************************************************/
+
+/* NVIC priority of PORT4, handlers may signal semaphores so it stays below SYSCALL_PRIORITY */
+#define PORT4_IRQ_PRIORITY 6
+
+/* Most pin handlers the dispatcher holds */
+#define PORT4_MAX_HANDLERS 4
+
+/*********************************************** Defines ******************************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Adds the handler of one or more PORT4 pins, the first call takes the PORT4 vector
+ * Param "pins": BIT0 .. BIT7 mask the handler serves
+ * Param "handler": Runs in the PORT4 interrupt when one of the pins is flagged and enabled
+ * Returns: false if PORT4_MAX_HANDLERS are already registered or the vector could not be taken
+ */
+bool Port4_AddHandler(uint8_t pins, void (*handler)(void));
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* BOARDSUPPORTPACKAGE_PORT4INTERRUPT_H_ */
@@ -0,0 +1,64 @@
+/*
+ * RLEImage.h
+ *
+ * Palette indexed, run length encoded images kept in flash (splash screens, menus, UI)
+ *  - A raw 320x240 RGB565 screen is 150 KB, most UI art has few colors and long runs
+ *  - Images are made on the PC with tools/img2rle.py, which writes a C file holding
+ *    a const RLEImage_t
+ *  - Decoded a few rows at a time into a small buffer that goes straight out through
+ *    the blit function, there is never a full frame in SRAM
+ *
+ * Data format, pixels row after row, left to right, packets may cross rows:
+ *  - Header byte h < 0x80:  run,     h + 1 pixels of the palette index in the next byte
+ *  - Header byte h >= 0x80: literal, (h & 0x7F) + 1 palette indexes follow, one byte each
+ */
+
+#ifndef BOARDSUPPORTPACKAGE_RLEIMAGE_H_
+#define BOARDSUPPORTPACKAGE_RLEIMAGE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************** Defines ******************************************************************************/
+
+/* Decode buffer in pixels, whole rows of it are blitted at once (3 rows of a full width image) */
+#define RLE_BUFFER_PIXELS 1024
+
+/* Header byte bits */
+#define RLE_LITERAL     0x80
+#define RLE_COUNT_MASK  0x7F
+
+/*********************************************** Defines ******************************************************************************/
+
+/*********************************************** Structures ***************************************************************************/
+
+/* Sends a block of RGB565 pixels to the screen, same shape as LCD_BlitRGB565 */
+typedef void (*rle_Blit_t)(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint16_t *pixels);
+
+/*
+ * Compressed image, all of it const so it stays in flash
+ */
+typedef struct RLEImage_t{
+    uint16_t Width;             //At most RLE_BUFFER_PIXELS
+    uint16_t Height;
+    uint16_t PaletteSize;       //1 to 256
+    const uint16_t *Palette;    //RGB565
+    uint32_t DataSize;          //Bytes in Data
+    const uint8_t *Data;
+} RLEImage_t;
+
+/*********************************************** Structures ***************************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Draws an image, one caller at a time (the decode buffer is shared)
+ * Param "x", "y": Top left corner on the screen, the blit function clips
+ * Param "blit": Sends decoded rows (LCD_BlitRGB565 on the board)
+ * Returns: false if the data is corrupt or the image is too wide, drawing stops there
+ */
+bool RLEImage_Draw(const RLEImage_t *image, int16_t x, int16_t y, rle_Blit_t blit);
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* BOARDSUPPORTPACKAGE_RLEIMAGE_H_ */
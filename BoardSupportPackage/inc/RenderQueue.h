@@ -0,0 +1,92 @@
+/*
+ * RenderQueue.h
+ *
+ * Ordered queue of LCD drawing commands
+ *  - Only holds the commands, the caller locks it and runs what it pops
+ *  - A new command that paints over the newest pending ones replaces them,
+ *    a clear drops everything still pending
+ */
+
+#ifndef BOARDSUPPORTPACKAGE_RENDERQUEUE_H_
+#define BOARDSUPPORTPACKAGE_RENDERQUEUE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************** Defines ******************************************************************************/
+
+/* Commands that can be pending at once */
+#define RENDER_QUEUE_SIZE 16
+
+/* Longest string a text command carries, one full line of 8 pixel wide characters */
+#define RENDER_TEXT_MAX 40
+
+/* Largest blit whose pixels travel inside the command, a 64 pixel paddle strip or an 8x8 sprite */
+#define RENDER_BLIT_COPY_MAX 64
+
+/*********************************************** Defines ******************************************************************************/
+
+/*********************************************** Structures ***************************************************************************/
+
+typedef enum
+{
+    RENDER_RECT = 0,        //LCD_DrawRectangle
+    RENDER_BLIT = 1,        //LCD_BlitRGB565 of Pixels, or of Copy when Pixels is NULL
+    RENDER_TEXT = 2,        //LCD_Text with a background color
+    RENDER_CLEAR = 3        //LCD_Clear
+} renderCmdType_t;
+
+/*
+ * One drawing command
+ *  - x, y, w, h: area of a rect or blit, top left corner of text
+ *  - Pixels must stay valid until a blit is drawn, small blits carry theirs in Copy instead
+ */
+typedef struct RenderCmd_t{
+    renderCmdType_t Type;
+    int16_t x;
+    int16_t y;
+    uint16_t w;
+    uint16_t h;
+    uint16_t Color;
+    uint16_t bkColor;
+    const uint16_t *Pixels;
+    char Text[RENDER_TEXT_MAX + 1];
+    uint16_t Copy[RENDER_BLIT_COPY_MAX];
+} RenderCmd_t;
+
+/*
+ * Ring buffer of pending commands, oldest at Head
+ */
+typedef struct RenderQueue_t{
+    RenderCmd_t Cmds[RENDER_QUEUE_SIZE];
+    uint16_t Head;
+    uint16_t Count;
+    uint32_t Coalesced;     //Commands dropped because a later one painted over them
+    uint32_t Rejected;      //Commands that found the queue full
+} RenderQueue_t;
+
+/*********************************************** Structures ***************************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Empties the queue and clears its counters
+ */
+void RenderQueue_Init(RenderQueue_t *queue);
+
+/*
+ * Queues a command behind the pending ones
+ *  - Pending commands at the back that the new one paints over completely are dropped first
+ * Returns: false if the queue is full
+ */
+bool RenderQueue_Push(RenderQueue_t *queue, const RenderCmd_t *cmd);
+
+/*
+ * Takes the oldest pending command
+ * Returns: false if nothing is pending
+ */
+bool RenderQueue_Pop(RenderQueue_t *queue, RenderCmd_t *cmd);
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* BOARDSUPPORTPACKAGE_RENDERQUEUE_H_ */
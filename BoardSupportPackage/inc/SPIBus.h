@@ -0,0 +1,79 @@
+/*
+ * SPIBus.h
+ *
+ * Arbiter for EUSCI_B3, shared by the LCD (CS P10.4) and the touch controller (CS P10.5)
+ *  - Every device has its own eUSCI configuration (clock, phase, polarity), it is loaded
+ *    whenever the bus changes hands
+ *  - A thread holds the bus from Acquire to Release, chip selects are only toggled in between.
+ *    Acquire nests for the thread that already holds it
+ *  - Release and Yield pass the bus straight to the waiting device of highest priority,
+ *    waiters of one device take turns
+ *  - Long holders (LCD fills) call SPIBus_Yield at safe points so a waiting device of
+ *    higher priority (touch reads) slots in between their DMA chunks, the bus then comes
+ *    back to the yielding thread before any other waiter of its device
+ *  - Before G8RTOS_Launch there is only one caller, Acquire then just loads the configuration
+ *  - Privileged threads only, the arbiter state is read only to protected threads
+ */
+
+#ifndef BOARDSUPPORTPACKAGE_SPIBUS_H_
+#define BOARDSUPPORTPACKAGE_SPIBUS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "driverlib.h"
+
+/*********************************************** Defines ******************************************************************************/
+
+/* Lower number is served first, like thread priorities */
+#define SPIBUS_PRIORITY_TOUCH   0
+#define SPIBUS_PRIORITY_LCD     1
+
+/*********************************************** Defines ******************************************************************************/
+
+/*********************************************** Structures ***************************************************************************/
+
+typedef enum
+{
+    SPIBUS_LCD = 0,
+    SPIBUS_TOUCH = 1,
+    SPIBUS_DEVICES = 2
+} spiBusDevice_t;
+
+/*********************************************** Structures ***************************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Registers a device, call before G8RTOS_Launch (LCD_Init does it for both devices)
+ * Param "config": eUSCI settings of the device, copied
+ * Param "priority": SPIBUS_PRIORITY_*
+ */
+void SPIBus_InitDevice(spiBusDevice_t device, const eUSCI_SPI_MasterConfig *config, uint8_t priority);
+
+/*
+ * Waits for the bus and loads the configuration of the device, threads only once the kernel runs
+ */
+void SPIBus_Acquire(spiBusDevice_t device);
+
+/*
+ * Gives the bus up (after the matching number of Acquires), CS of the device must be high
+ */
+void SPIBus_Release(spiBusDevice_t device);
+
+/*
+ * Returns: true if a device of higher priority than "device" is waiting for the bus
+ */
+bool SPIBus_Contended(spiBusDevice_t device);
+
+/*
+ * Lets waiting devices of higher priority use the bus, then takes it back
+ *  - The bus returns to this thread before other threads of the same device,
+ *    a call in progress (and its LCD_Perf count) is never interleaved with another one
+ *  - Call with CS high, the device has to restart its transfer afterwards
+ * Returns: true if the bus changed hands (and the device configuration was reloaded)
+ */
+bool SPIBus_Yield(spiBusDevice_t device);
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* BOARDSUPPORTPACKAGE_SPIBUS_H_ */
@@ -0,0 +1,91 @@
+/*
+ * TileRender.h
+ *
+ * Composites overlapping sprites in a small off-screen tile before they go to the LCD
+ *  - The whole 320x240 screen does not fit in SRAM, a TILE_SIZE x TILE_SIZE tile does
+ *  - Every pixel of an area is sent once with its final color, so overlaps never tear
+ *  - Finished tiles go out through the blit function given at init, LCD_BlitRGB565
+ *    on the board and a reference framebuffer in tests/TileRenderTest.c
+ */
+
+#ifndef BOARDSUPPORTPACKAGE_TILERENDER_H_
+#define BOARDSUPPORTPACKAGE_TILERENDER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************** Defines ******************************************************************************/
+
+/* Side of the off-screen tile in pixels (TILE_SIZE^2 RGB565 pixels of SRAM) */
+#define TILE_SIZE 32
+
+/* Most sprites a scene can hold */
+#define MAX_SPRITES 16
+
+/*********************************************** Defines ******************************************************************************/
+
+/*********************************************** Structures ***************************************************************************/
+
+/* Sends a block of RGB565 pixels to the screen, same shape as LCD_BlitRGB565 */
+typedef void (*tile_Blit_t)(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint16_t *pixels);
+
+/*
+ * Something drawn on top of the background
+ *  - Solid block of Color if Pixels is 0
+ *  - Otherwise a w x h RGB565 image, pixels equal to Transparent are skipped
+ *  - Owned by the caller, move it by changing x and y and repainting the damage
+ */
+typedef struct Sprite_t{
+    int16_t x;              //Top left corner
+    int16_t y;
+    uint16_t w;
+    uint16_t h;
+    uint16_t Color;
+    const uint16_t *Pixels;
+    uint16_t Transparent;
+    bool Visible;
+} Sprite_t;
+
+/*
+ * Sprites in drawing order (later ones on top) over a solid background
+ */
+typedef struct Scene_t{
+    Sprite_t *Sprites[MAX_SPRITES];
+    uint16_t Count;
+    uint16_t Background;
+    tile_Blit_t Blit;
+    uint16_t Tile[TILE_SIZE * TILE_SIZE];
+} Scene_t;
+
+/*********************************************** Structures ***************************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Starts an empty scene
+ * Param "background": Color under every sprite
+ * Param "blit": Sends a finished tile (LCD_BlitRGB565 on the board)
+ */
+void TileRender_Init(Scene_t *scene, uint16_t background, tile_Blit_t blit);
+
+/*
+ * Puts a sprite on top of the ones already in the scene
+ * Returns: false if the scene is full
+ */
+bool TileRender_AddSprite(Scene_t *scene, Sprite_t *sprite);
+
+/*
+ * Composites one area of the scene into "out" (w x h, row after row)
+ *  - w * h must not be more than TILE_SIZE * TILE_SIZE
+ */
+void TileRender_Compose(Scene_t *scene, int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t *out);
+
+/*
+ * Repaints an area of the screen from the scene (corners inclusive)
+ *  - Walks the area one tile at a time, each tile is composited then blitted in one burst
+ */
+void TileRender_Draw(Scene_t *scene, int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd);
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* BOARDSUPPORTPACKAGE_TILERENDER_H_ */
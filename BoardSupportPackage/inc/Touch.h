@@ -0,0 +1,82 @@
+/*
+ * Touch.h
+ *
+ * Interrupt driven touch panel input
+ *  - The P4.0 pen down interrupt wakes Touch_Thread, nothing is read while nobody touches
+ *  - Every TOUCH_SAMPLE_MS while the pen is down a burst of TOUCH_OVERSAMPLE X/Y readings
+ *    is taken, median and IIR filtered (TouchFilter) and calibrated in fixed point
+ *  - Down, move and up events go to a G8RTOS FIFO, read them with Touch_ReadEvent
+ *  - Needs LCD_Init(true) first, PENIRQ shares the PORT4 vector through Port4Interrupt
+ *  - Reads go through SPIBus, a burst slots in between the DMA slices of a long LCD fill
+ */
+
+#ifndef BOARDSUPPORTPACKAGE_TOUCH_H_
+#define BOARDSUPPORTPACKAGE_TOUCH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "TouchFilter.h"
+
+/*********************************************** Defines ******************************************************************************/
+
+/* Readings per axis in one burst (odd, at most TOUCH_MAX_SAMPLES) */
+#define TOUCH_OVERSAMPLE 5
+
+/* Time between bursts while the pen is down */
+#define TOUCH_SAMPLE_MS 10
+
+/* An event packed into one FIFO word, type in bits 31:24, x in 23:12, y in 11:0 */
+#define TOUCH_EVENT_PACK(type, x, y) (((int32_t)(type) << 24) | ((int32_t)(x) << 12) | (int32_t)(y))
+
+/*********************************************** Defines ******************************************************************************/
+
+/*********************************************** Structures ***************************************************************************/
+
+typedef enum
+{
+    TOUCH_DOWN = 1,             //Pen touched at x, y
+    TOUCH_MOVE = 2,             //Pen moved to x, y
+    TOUCH_UP = 3                //Pen lifted, x, y is the last position
+} touchEventType_t;
+
+typedef struct TouchEvent_t{
+    touchEventType_t Type;
+    uint16_t x;
+    uint16_t y;
+} TouchEvent_t;
+
+/*********************************************** Structures ***************************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Sets up the event FIFO and the pen down interrupt, call before the touch thread is added
+ * Param "fifo": G8RTOS FIFO the events go to
+ * Returns: false if the pen down handler could not be added
+ */
+bool Touch_Init(uint32_t fifo);
+
+/*
+ * Touch thread, add it with G8RTOS_AddThread
+ *  - Sleeps on the pen down interrupt, samples while the pen is down
+ */
+void Touch_Thread();
+
+/*
+ * Replaces the calibration (TouchCal_Default until then)
+ */
+void Touch_SetCalibration(const TouchCal_t *cal);
+
+/*
+ * Waits for the next event
+ */
+TouchEvent_t Touch_ReadEvent();
+
+/*
+ * Returns: Events dropped because the FIFO was full
+ */
+uint32_t Touch_GetLostEvents();
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* BOARDSUPPORTPACKAGE_TOUCH_H_ */
@@ -0,0 +1,106 @@
+/*
+ * TouchFilter.h
+ *
+ * Jitter filtering and calibration of raw touch panel readings
+ *  - Median of an oversampled burst throws away the odd reading taken while the pen settles
+ *  - First order IIR on the medians smooths what is left between bursts
+ *  - 3 point affine calibration in fixed point maps raw 12 bit readings to screen pixels
+ *  - Touch.c runs it on every burst, nothing in here talks to the XPT2046
+ */
+
+#ifndef BOARDSUPPORTPACKAGE_TOUCHFILTER_H_
+#define BOARDSUPPORTPACKAGE_TOUCHFILTER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************** Defines ******************************************************************************/
+
+/* Largest burst TouchFilter_Median takes */
+#define TOUCH_MAX_SAMPLES 9
+
+/* IIR weight of a new burst is 1 / 2^TOUCH_IIR_SHIFT */
+#define TOUCH_IIR_SHIFT 2
+
+/* Fraction bits of the IIR state */
+#define TOUCH_IIR_FRACTION 4
+
+/* Fraction bits of the calibration coefficients */
+#define TOUCH_CAL_SHIFT 16
+
+/*********************************************** Defines ******************************************************************************/
+
+/*********************************************** Structures ***************************************************************************/
+
+/*
+ * Affine calibration, Q16 coefficients
+ *  x = (A * rawX + B * rawY + C) >> 16
+ *  y = (D * rawX + E * rawY + F) >> 16
+ */
+typedef struct TouchCal_t{
+    int32_t A, B, C;
+    int32_t D, E, F;
+} TouchCal_t;
+
+/*
+ * One point, raw reading or screen position
+ */
+typedef struct TouchPoint_t{
+    int32_t x;
+    int32_t y;
+} TouchPoint_t;
+
+/*
+ * IIR state of one touch, reset it on pen down
+ */
+typedef struct TouchIIR_t{
+    int32_t X;                  //Raw reading with TOUCH_IIR_FRACTION fraction bits
+    int32_t Y;
+    bool Primed;                //False until the first burst of the touch
+} TouchIIR_t;
+
+/*********************************************** Structures ***************************************************************************/
+
+/*********************************************** Public Data **************************************************************************/
+
+/* Fixed point form of the scale and offset TP_ReadXY always used */
+extern const TouchCal_t TouchCal_Default;
+
+/*********************************************** Public Data **************************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Median of a burst, the samples are sorted in place
+ * Param "count": 1 to TOUCH_MAX_SAMPLES
+ */
+uint16_t TouchFilter_Median(uint16_t *samples, uint16_t count);
+
+/*
+ * Starts a new touch, the next burst is taken as it is
+ */
+void TouchFilter_Reset(TouchIIR_t *filter);
+
+/*
+ * Adds the medians of one burst
+ * Param "filtered": Returns the smoothed raw reading
+ */
+void TouchFilter_Update(TouchIIR_t *filter, uint16_t rawX, uint16_t rawY, TouchPoint_t *filtered);
+
+/*
+ * Solves the calibration from three touches of known screen points
+ *  - The points should be far apart and not on one line (corners and the center edge work well)
+ * Param "screen": Where the three targets were drawn
+ * Param "raw": Filtered readings taken while each target was touched
+ * Returns: false if the points are on one line, "cal" is left untouched
+ */
+bool TouchCal_Compute(const TouchPoint_t screen[3], const TouchPoint_t raw[3], TouchCal_t *cal);
+
+/*
+ * Maps a raw reading to the screen, clamped to the screen edges
+ */
+void TouchCal_Apply(const TouchCal_t *cal, const TouchPoint_t *raw, TouchPoint_t *screen);
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* BOARDSUPPORTPACKAGE_TOUCHFILTER_H_ */
@@ -36,6 +36,9 @@ void BSP_InitBoard()
     /* Init joystick without interrupts */
 	Joystick_Init_Without_Interrupt();
 
+	/* Joystick is sampled in the background from here on */
+	Joystick_StartSampling();
+
 	/* Init Bme280 */
 	bme280_initialize_sensor();
 
@@ -20,7 +20,7 @@
 
 /******************************************* Defines *************************************/
 
-#define SBUFF_SIZE 255
+#define SBUFF_SIZE 384
 
 /******************************************* Defines *************************************/
 
@@ -181,6 +181,31 @@ void BackupChannelBmi160PrintMag(struct bmi160_mag_t * magData)
 	BackChannelTransmitString(backChannelStringBuff);
 }
 
+/*
+ * Sends the cost totals of one LCD primitive to back channel UART
+ * Param 'name': Name of the primitive
+ * Param 'stats': Totals from LCD_PerfGetStats
+ */
+void BackChannelPrintLcdPerf(const char * name, const LCD_PerfStats_t * stats)
+{
+	uint32_t average = (stats->Calls == 0) ? 0 : (uint32_t)(stats->Cycles / stats->Calls);
+	int used = snprintf(backChannelStringBuff, SBUFF_SIZE,
+			"{ \"lcd_perf\" : { \"name\" : \"%s\", \"calls\" : %lu, \"pixels\" : %lu, \"regs\" : %lu, \"bytes\" : %lu, \"avg_cycles\" : %lu, \"max_cycles\" : %lu, \"histogram\" : [",
+			name, (unsigned long)stats->Calls, (unsigned long)stats->Pixels, (unsigned long)stats->RegWrites,
+			(unsigned long)stats->Bytes, (unsigned long)average, (unsigned long)stats->MaxCycles);
+
+	int i;
+	for(i = 0; i < LCD_PERF_BUCKETS && used < SBUFF_SIZE; i++)
+	{
+		used += snprintf(backChannelStringBuff + used, SBUFF_SIZE - used, (i == 0) ? " %lu" : ", %lu", (unsigned long)stats->Histogram[i]);
+	}
+	if(used < SBUFF_SIZE)
+	{
+		snprintf(backChannelStringBuff + used, SBUFF_SIZE - used, " ] } }\r\n");
+	}
+	BackChannelTransmitString(backChannelStringBuff);
+}
+
 /******************************************* Public Functions ****************************/
 
 
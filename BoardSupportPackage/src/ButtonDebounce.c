@@ -0,0 +1,75 @@
+/*
+ * ButtonDebounce.c
+ *
+ * Integrator and edge reporting of one sampled button
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ButtonDebounce.h"
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Starts a button up and settled
+ */
+void ButtonDebounce_Init(ButtonDebounce_t *button)
+{
+    button->Integrator = 0;
+    button->Pressed = false;
+    button->HeldSamples = 0;
+    button->LongReported = false;
+}
+
+/*
+ * Adds one raw sample
+ * Param "down": Raw level, true if the contact reads closed
+ * Param "longSamples": Samples held before BUTTON_LONG_PRESS, 0 for none
+ * Returns: Event the sample caused, BUTTON_NONE most of the time
+ */
+buttonEventType_t ButtonDebounce_Sample(ButtonDebounce_t *button, bool down, uint16_t longSamples)
+{
+    if(down){
+        if(button->Integrator < BUTTON_DEBOUNCE_SAMPLES){
+            button->Integrator++;
+        }
+    }
+    else if(button->Integrator > 0){
+        button->Integrator--;
+    }
+
+    if(!button->Pressed){
+        if(button->Integrator == BUTTON_DEBOUNCE_SAMPLES){
+            button->Pressed = true;
+            button->HeldSamples = 0;
+            button->LongReported = false;
+            return BUTTON_PRESS;
+        }
+        return BUTTON_NONE;
+    }
+
+    if(button->Integrator == 0){
+        button->Pressed = false;
+        return BUTTON_RELEASE;
+    }
+
+    //Counts on through a bounce while held, the contact is still closed most of the time
+    if(button->HeldSamples < 0xFFFF){
+        button->HeldSamples++;
+    }
+    if(longSamples != 0 && !button->LongReported && button->HeldSamples >= longSamples){
+        button->LongReported = true;
+        return BUTTON_LONG_PRESS;
+    }
+    return BUTTON_NONE;
+}
+
+/*
+ * Returns: true if the button is up and no bounce is being counted, sampling can stop
+ */
+bool ButtonDebounce_IsIdle(const ButtonDebounce_t *button)
+{
+    return !button->Pressed && button->Integrator == 0;
+}
+
+/*********************************************** Public Functions *********************************************************************/
@@ -0,0 +1,198 @@
+/*
+ * Buttons.c
+ *
+ * Debounced, event queued push buttons
+ *  - A button edge interrupt only wakes the sampler, contact bounce never reaches a thread
+ *  - While a button is active a periodic event samples it every BUTTON_SAMPLE_MS and
+ *    debounces it (ButtonDebounce), press, release and long press go to a lock-free
+ *    EventQueue. Once every button is up and settled the sampler goes back to sleep
+ *    on the edge interrupt and costs nothing until the next press
+ *  - Read events with Buttons_GetEvent (never blocks) or Buttons_WaitEvent
+ *  - The joystick button is on P4.3, it shares the PORT4 vector through Port4Interrupt
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "msp.h"
+#include "Buttons.h"
+#include "ButtonDebounce.h"
+#include "EventQueue.h"
+#include "Port4Interrupt.h"
+#include "G8RTOS.h"
+
+/*********************************************** Defines ******************************************************************************/
+
+#define JOYSTICK_BUTTON_PIN BIT3
+#define JOYSTICK_BUTTON_BIT 3
+
+#define BUTTON_LONG_PRESS_SAMPLES (BUTTON_LONG_PRESS_MS / BUTTON_SAMPLE_MS)
+
+/*********************************************** Defines ******************************************************************************/
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+static ButtonDebounce_t States[BUTTONS];
+static EventQueue_t Events;
+
+/* Set by an edge, the sampler only runs while it is */
+static volatile bool Awake = false;
+
+static uint32_t LostEvents = 0;
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*
+ * Returns: Raw level of a button, true if the contact is closed
+ */
+static bool ReadRaw(buttonId_t button)
+{
+    switch(button){
+    case BUTTON_JOYSTICK:
+        return (P4->IN & JOYSTICK_BUTTON_PIN) == 0;
+    default:
+        return false;
+    }
+}
+
+/*
+ * Edge interrupts of the button pins off or back on, flags cleared first so a
+ * bounce from while they were off does not fire right away
+ *  - Bit-band stores, P4 IE/IFG also hold the touch pin and a read-modify-write
+ *    cut by the PORT4 interrupt would lose its bit
+ */
+static void EnableEdges(bool enable)
+{
+    if(enable){
+        BITBAND_PERI(P4->IFG, JOYSTICK_BUTTON_BIT) = 0;
+        BITBAND_PERI(P4->IE, JOYSTICK_BUTTON_BIT) = 1;
+    }
+    else{
+        BITBAND_PERI(P4->IE, JOYSTICK_BUTTON_BIT) = 0;
+        BITBAND_PERI(P4->IFG, JOYSTICK_BUTTON_BIT) = 0;
+    }
+}
+
+/*
+ * Joystick button edge, wakes the sampler and stays off until it is done
+ */
+static void Buttons_EdgeHandler()
+{
+    if(P4->IFG & JOYSTICK_BUTTON_PIN){
+        EnableEdges(false);
+        Awake = true;
+    }
+}
+
+/*
+ * Periodic event, debounces every button while one is active
+ */
+static void Buttons_Sample()
+{
+    if(!Awake){
+        return;
+    }
+
+    bool idle = true;
+    buttonId_t i;
+    for(i = BUTTON_JOYSTICK; i < BUTTONS; i++){
+        buttonEventType_t type = ButtonDebounce_Sample(&States[i], ReadRaw(i), BUTTON_LONG_PRESS_SAMPLES);
+        if(type != BUTTON_NONE && !EventQueue_Put(&Events, BUTTON_EVENT_PACK(i, type))){
+            LostEvents++;
+        }
+        idle &= ButtonDebounce_IsIdle(&States[i]);
+    }
+
+    //All up and settled, back to the edge interrupt. A press that came in between the
+    //last sample and the edge being armed would never interrupt, so look once more
+    if(idle){
+        Awake = false;
+        EnableEdges(true);
+        if(ReadRaw(BUTTON_JOYSTICK)){
+            EnableEdges(false);
+            Awake = true;
+        }
+    }
+}
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Sets up the button pins, their edge interrupts and the sampler
+ *  - Call once the kernel is initialized, the sampler is a periodic event
+ * Returns: false if the edge handler or the sampler could not be added, the edges stay off
+ */
+bool Buttons_Init()
+{
+    buttonId_t i;
+    for(i = BUTTON_JOYSTICK; i < BUTTONS; i++){
+        ButtonDebounce_Init(&States[i]);
+    }
+    EventQueue_Init(&Events);
+    LostEvents = 0;
+    Awake = false;
+
+    //Joystick button, input with pull-up, falling edge is a press
+    P4->DIR &= ~JOYSTICK_BUTTON_PIN;
+    P4->REN |= JOYSTICK_BUTTON_PIN;
+    P4->OUT |= JOYSTICK_BUTTON_PIN;
+    P4->IES |= JOYSTICK_BUTTON_PIN;
+
+    if(!Port4_AddHandler(JOYSTICK_BUTTON_PIN, Buttons_EdgeHandler)){
+        return false;
+    }
+    if(G8RTOS_AddPeriodicEvent(Buttons_Sample, BUTTON_SAMPLE_MS, BUTTON_SAMPLE_WCET) != NO_ERROR){
+        return false;
+    }
+    EnableEdges(true);
+    return true;
+}
+
+/*
+ * Takes the oldest event, one reader thread only
+ * Param "event": Returns the event
+ * Returns: false if there was none
+ */
+bool Buttons_GetEvent(ButtonEvent_t *event)
+{
+    uint32_t packed;
+    if(!EventQueue_Get(&Events, &packed)){
+        return false;
+    }
+    event->Button = (buttonId_t)(packed >> 8);
+    event->Type = (buttonEventType_t)(packed & 0xFF);
+    return true;
+}
+
+/*
+ * Waits for the next event, sleeps BUTTON_SAMPLE_MS between looks
+ */
+ButtonEvent_t Buttons_WaitEvent()
+{
+    ButtonEvent_t event;
+    while(!Buttons_GetEvent(&event)){
+        sleep(BUTTON_SAMPLE_MS);
+    }
+    return event;
+}
+
+/*
+ * Returns: Debounced state of a button, true while it is held
+ */
+bool Buttons_IsPressed(buttonId_t button)
+{
+    return States[button].Pressed;
+}
+
+/*
+ * Returns: Events dropped because the queue was full
+ */
+uint32_t Buttons_GetLostEvents()
+{
+    return LostEvents;
+}
+
+/*********************************************** Public Functions *********************************************************************/
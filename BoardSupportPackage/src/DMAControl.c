@@ -0,0 +1,40 @@
+/*
+ * DMAControl.c
+ *
+ * Shared uDMA control table, every driver that uses DMA goes through here
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "msp.h"
+#include "driverlib.h"
+#include "DMAControl.h"
+
+/*********************************************** Private Variables ********************************************************************/
+
+/* Primary and alternate structures for all 8 channels, the uDMA needs it aligned to 1024 */
+#pragma DATA_ALIGN(DMAControlTable, 1024)
+static uint8_t DMAControlTable[1024];
+
+static bool DMAInitialized = false;
+
+/*********************************************** Private Variables ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Enables the uDMA and points it at the shared control table
+ * Safe to call from every driver, only the first call does anything
+ */
+void DMAControl_Init()
+{
+    if(DMAInitialized){
+        return;
+    }
+
+    DMA_enableModule();
+    DMA_setControlBase(DMAControlTable);
+    DMAInitialized = true;
+}
+
+/*********************************************** Public Functions *********************************************************************/
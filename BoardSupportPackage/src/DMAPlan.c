@@ -0,0 +1,73 @@
+/*
+ * DMAPlan.c
+ *
+ * Chunk bookkeeping of the LCD uDMA transfers
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "DMAPlan.h"
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*
+ * Clips a requested chunk length to what the uDMA can do
+ *  - Even lengths keep the two bytes of a pixel in the same chunk,
+ *    so a repeated pattern never gets out of phase
+ */
+static uint16_t ClipChunk(uint16_t maxChunk)
+{
+    if(maxChunk == 0 || maxChunk > DMA_MAX_TRANSFER){
+        maxChunk = DMA_MAX_TRANSFER;
+    }
+    if(maxChunk > 1){
+        maxChunk &= ~1;
+    }
+    return maxChunk;
+}
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Sets up the plan for a transfer
+ * Param "bytes": Length of the whole stream
+ * Param "maxChunk": Longest chunk the source allows, 0 for the uDMA limit
+ *                   (clipped to DMA_MAX_TRANSFER and kept even so pixels never split)
+ * Param "repeat": true if the source is a pattern that restarts with every chunk
+ */
+void DMAPlan_Init(DMAPlan_t *plan, uint32_t bytes, uint16_t maxChunk, bool repeat)
+{
+    plan->Remaining = bytes;
+    plan->Offset = 0;
+    plan->MaxChunk = ClipChunk(maxChunk);
+    plan->Repeat = repeat;
+}
+
+/*
+ * Hands out the next chunk
+ * Param "sourceOffset": Returns where in the source the chunk starts
+ * Returns: Length of the chunk, 0 once the stream is done
+ */
+uint16_t DMAPlan_Next(DMAPlan_t *plan, uint32_t *sourceOffset)
+{
+    uint16_t chunk = (plan->Remaining < plan->MaxChunk) ? plan->Remaining : plan->MaxChunk;
+
+    *sourceOffset = plan->Repeat ? 0 : plan->Offset;
+    plan->Offset += chunk;
+    plan->Remaining -= chunk;
+
+    return chunk;
+}
+
+/*
+ * Returns: Number of chunks (and so DMA interrupts) a stream takes
+ */
+uint32_t DMAPlan_Count(uint32_t bytes, uint16_t maxChunk)
+{
+    maxChunk = ClipChunk(maxChunk);
+    return (bytes + maxChunk - 1) / maxChunk;
+}
+
+/*********************************************** Public Functions *********************************************************************/
@@ -0,0 +1,215 @@
+/*
+ * DirtyRect.c
+ *
+ * Cover and merge rules of the per-frame repaint list
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "DirtyRect.h"
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*
+ * Returns true if the two areas share at least one pixel
+ */
+static bool Overlaps(const DirtyRect_t *a, const DirtyRect_t *b)
+{
+    return (a->xStart <= b->xEnd) && (b->xStart <= a->xEnd) &&
+           (a->yStart <= b->yEnd) && (b->yStart <= a->yEnd);
+}
+
+/*
+ * Returns true if "outer" covers every pixel of "inner"
+ */
+static bool Covers(const DirtyRect_t *outer, const DirtyRect_t *inner)
+{
+    return (outer->xStart <= inner->xStart) && (inner->xEnd <= outer->xEnd) &&
+           (outer->yStart <= inner->yStart) && (inner->yEnd <= outer->yEnd);
+}
+
+/*
+ * Returns true if the union of the two areas is itself a rectangle
+ *  - Same columns and rows that overlap or touch, or the other way around
+ */
+static bool FormsRectangle(const DirtyRect_t *a, const DirtyRect_t *b)
+{
+    if(a->xStart == b->xStart && a->xEnd == b->xEnd){
+        return (a->yStart <= b->yEnd + 1) && (b->yStart <= a->yEnd + 1);
+    }
+    if(a->yStart == b->yStart && a->yEnd == b->yEnd){
+        return (a->xStart <= b->xEnd + 1) && (b->xStart <= a->xEnd + 1);
+    }
+    return Covers(a, b) || Covers(b, a);
+}
+
+/*
+ * Removes the area at "index", keeping the order of the others
+ */
+static void Remove(DirtyRegion_t *region, uint16_t index)
+{
+    uint16_t i;
+    region->Count--;
+    for(i = index; i < region->Count; i++){
+        region->Rects[i] = region->Rects[i + 1];
+    }
+}
+
+/*
+ * Tries to grow an earlier area of the same color into the union with "rect"
+ *  - Only allowed if nothing added after that area touches the union,
+ *    otherwise painting it early would be painted over in the wrong order
+ * Returns: true if "rect" was merged
+ */
+static bool Merge(DirtyRegion_t *region, const DirtyRect_t *rect)
+{
+    int16_t i;
+    uint16_t j;
+    for(i = region->Count - 1; i >= 0; i--){
+        DirtyRect_t *earlier = &region->Rects[i];
+        if(earlier->Color != rect->Color || !FormsRectangle(earlier, rect)){
+            continue;
+        }
+
+        DirtyRect_t merged = {
+            (earlier->xStart < rect->xStart) ? earlier->xStart : rect->xStart,
+            (earlier->xEnd > rect->xEnd) ? earlier->xEnd : rect->xEnd,
+            (earlier->yStart < rect->yStart) ? earlier->yStart : rect->yStart,
+            (earlier->yEnd > rect->yEnd) ? earlier->yEnd : rect->yEnd,
+            rect->Color
+        };
+
+        bool blocked = false;
+        for(j = i + 1; j < region->Count; j++){
+            if(Overlaps(&region->Rects[j], &merged)){
+                blocked = true;
+                break;
+            }
+        }
+
+        if(!blocked){
+            *earlier = merged;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Starts an empty region
+ * Param "draw": Paints one area when the region is flushed (LCD_DrawRectangle on the board)
+ */
+void DirtyRect_Init(DirtyRegion_t *region, dirtyRect_Draw_t draw)
+{
+    region->Count = 0;
+    region->Draw = draw;
+}
+
+/*
+ * Adds an area to repaint
+ *  - Earlier areas the new one covers completely are dropped
+ *  - Same colored areas that overlap or touch and form a rectangle are merged
+ *  - A full region is flushed first
+ */
+void DirtyRect_Add(DirtyRegion_t *region, int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd, uint16_t Color)
+{
+    if(xEnd < xStart || yEnd < yStart){
+        return;
+    }
+
+    DirtyRect_t rect = {xStart, xEnd, yStart, yEnd, Color};
+
+    //Anything completely under the new area would only be painted over
+    uint16_t i = 0;
+    while(i < region->Count){
+        if(Covers(&rect, &region->Rects[i])){
+            Remove(region, i);
+        }
+        else{
+            i++;
+        }
+    }
+
+    if(Merge(region, &rect)){
+        return;
+    }
+
+    if(region->Count == MAX_DIRTY_RECTS){
+        DirtyRect_Flush(region);
+    }
+    region->Rects[region->Count++] = rect;
+}
+
+/*
+ * Adds only what changes when a w x h block moves (top left corners)
+ *  - Trailing edges that got uncovered are painted in backColor
+ *  - Leading edges that got covered are painted in color
+ *  - Blocks that no longer overlap are erased and drawn whole
+ */
+void DirtyRect_AddMove(DirtyRegion_t *region, int16_t oldX, int16_t oldY, int16_t newX, int16_t newY,
+                       uint16_t w, uint16_t h, uint16_t color, uint16_t backColor)
+{
+    int16_t dx = newX - oldX;
+    int16_t dy = newY - oldY;
+
+    if(dx == 0 && dy == 0){
+        return;
+    }
+
+    if(dx >= (int16_t)w || -dx >= (int16_t)w || dy >= (int16_t)h || -dy >= (int16_t)h){
+        DirtyRect_Add(region, oldX, oldX + w - 1, oldY, oldY + h - 1, backColor);
+        DirtyRect_Add(region, newX, newX + w - 1, newY, newY + h - 1, color);
+        return;
+    }
+
+    //Columns both blocks share, the row strips only span these
+    int16_t sharedXStart = (dx > 0) ? newX : oldX;
+    int16_t sharedXEnd = ((dx > 0) ? oldX : newX) + w - 1;
+
+    //Trailing column strip over the old rows, trailing row strip over the shared columns
+    if(dx > 0){
+        DirtyRect_Add(region, oldX, newX - 1, oldY, oldY + h - 1, backColor);
+    }
+    else if(dx < 0){
+        DirtyRect_Add(region, newX + w, oldX + w - 1, oldY, oldY + h - 1, backColor);
+    }
+    if(dy > 0){
+        DirtyRect_Add(region, sharedXStart, sharedXEnd, oldY, newY - 1, backColor);
+    }
+    else if(dy < 0){
+        DirtyRect_Add(region, sharedXStart, sharedXEnd, newY + h, oldY + h - 1, backColor);
+    }
+
+    //Leading column strip over the new rows, leading row strip over the shared columns
+    if(dx > 0){
+        DirtyRect_Add(region, oldX + w, newX + w - 1, newY, newY + h - 1, color);
+    }
+    else if(dx < 0){
+        DirtyRect_Add(region, newX, oldX - 1, newY, newY + h - 1, color);
+    }
+    if(dy > 0){
+        DirtyRect_Add(region, sharedXStart, sharedXEnd, oldY + h, newY + h - 1, color);
+    }
+    else if(dy < 0){
+        DirtyRect_Add(region, sharedXStart, sharedXEnd, newY, oldY - 1, color);
+    }
+}
+
+/*
+ * Paints every area in the order it was added and empties the region
+ */
+void DirtyRect_Flush(DirtyRegion_t *region)
+{
+    uint16_t i;
+    for(i = 0; i < region->Count; i++){
+        DirtyRect_t *rect = &region->Rects[i];
+        region->Draw(rect->xStart, rect->xEnd, rect->yStart, rect->yEnd, rect->Color);
+    }
+    region->Count = 0;
+}
+
+/*********************************************** Public Functions *********************************************************************/
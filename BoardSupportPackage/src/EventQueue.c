@@ -0,0 +1,64 @@
+/*
+ * EventQueue.c
+ *
+ * Single writer, single reader ring of 32-bit events
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "EventQueue.h"
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Empties a queue, not safe while the writer or the reader is running
+ */
+void EventQueue_Init(EventQueue_t *queue)
+{
+    queue->Head = 0;
+    queue->Tail = 0;
+}
+
+/*
+ * Adds an event, writer side only
+ * Returns: false if the queue is full, the event is not added
+ */
+bool EventQueue_Put(EventQueue_t *queue, uint32_t event)
+{
+    uint32_t head = queue->Head;
+    if(head - queue->Tail == EVENT_QUEUE_SIZE){
+        return false;
+    }
+
+    //Item first, the reader may take it as soon as Head moves (the M4 does not reorder stores)
+    queue->Items[head & (EVENT_QUEUE_SIZE - 1)] = event;
+    queue->Head = head + 1;
+    return true;
+}
+
+/*
+ * Takes the oldest event, reader side only
+ * Param "event": Returns the event
+ * Returns: false if the queue is empty
+ */
+bool EventQueue_Get(EventQueue_t *queue, uint32_t *event)
+{
+    uint32_t tail = queue->Tail;
+    if(tail == queue->Head){
+        return false;
+    }
+
+    *event = queue->Items[tail & (EVENT_QUEUE_SIZE - 1)];
+    queue->Tail = tail + 1;
+    return true;
+}
+
+/*
+ * Returns: Events waiting in the queue
+ */
+uint32_t EventQueue_Count(const EventQueue_t *queue)
+{
+    return queue->Head - queue->Tail;
+}
+
+/*********************************************** Public Functions *********************************************************************/
@@ -0,0 +1,273 @@
+/*
+ * FramePacing.c
+ *
+ * Paces drawing to the panel refresh with the ILI9325 frame marker (FMARK)
+ *  - FMARK pulses once every N frames at a set scan line, its rising edge on a GPIO
+ *    interrupt signals a semaphore, FramePacing_WaitFrame blocks on it
+ *  - The interrupt also stamps the DWT cycle counter, the smoothed time between marks
+ *    gives the refresh period and with it the line the panel is scanning right now
+ *  - FramePacing_WaitClear holds an area back until the scan is out of its way, the
+ *    panel scans screen columns in x order so an area written behind the scan never tears
+ *  - FMARK is not routed on the BoosterPack, wire the panel's FMARK pad to FRAME_FMARK_PIN.
+ *    Until FramePacing_Init is called nothing waits and drawing is free running
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "msp.h"
+#include "FramePacing.h"
+#include "LCD_empty.h"
+#include "G8RTOS.h"
+
+/* System Core Clock From system_msp432p401r.c */
+extern uint32_t SystemCoreClock;
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+/* Signaled by the frame marker interrupt while a thread waits for it */
+static semaphore_t FrameMark;
+static volatile bool Waiting = false;
+
+static bool Running = false;
+static uint8_t Interval = 1;            //Panel frames between two marks
+static uint16_t MarkLine = 0;           //Scan line the mark comes out on
+
+/* Written by the interrupt */
+static volatile uint32_t Marks = 0;
+static volatile uint32_t LastMark = 0;  //DWT stamp of the last mark
+static volatile uint32_t FramePeriod = 0;   //Smoothed cycles per panel frame, 0 until measured
+
+static uint32_t PacedFrames = 0;
+static uint32_t MissedFrames = 0;
+static uint32_t LastPacedMark = 0;
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*
+ * Frame marker interrupt, measures the refresh period and wakes the waiting thread
+ */
+static void FramePacing_MarkHandler()
+{
+    if(FRAME_FMARK_PORT->IFG & FRAME_FMARK_PIN){
+        FRAME_FMARK_PORT->IFG &= ~FRAME_FMARK_PIN;
+
+        uint32_t now = DWT->CYCCNT;
+        uint32_t period = (now - LastMark) / Interval;
+
+        //The first mark has nothing to measure against, the second seeds the average
+        if(Marks == 1){
+            FramePeriod = period;
+        }
+        else if(Marks > 1){
+            FramePeriod = FramePeriod + (int32_t)(period - FramePeriod) / (1 << FRAME_PERIOD_SMOOTHING);
+        }
+        LastMark = now;
+        Marks++;
+
+        //Only a waiting thread gets a signal, marks nobody waited for do not pile up
+        if(Waiting){
+            Waiting = false;
+            G8RTOS_SignalSemaphore(&FrameMark);
+        }
+    }
+}
+
+/*
+ * Busy waits (and sleeps the long part) for a number of scan lines
+ */
+static void WaitLines(uint32_t lines, uint32_t cyclesPerLine)
+{
+    uint32_t start = DWT->CYCCNT;
+    uint32_t cycles = lines * cyclesPerLine;
+    uint32_t cyclesPerMs = SystemCoreClock / 1000;
+
+    //Sleep ticks are 1 ms, the last bit is spun so the write starts on the right line
+    if(cycles > 2 * cyclesPerMs){
+        sleep(cycles / cyclesPerMs - 1);
+    }
+    while((DWT->CYCCNT - start) < cycles);
+}
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Starts pacing, turns on FMARK and its interrupt
+ * Param "frames": Panel frames per paced frame, 1, 2, 4 or 6 (others are rounded down)
+ * Param "line": Scan line FMARK pulses on, 0 is the first back porch line
+ * Returns: false if the FMARK handler could not be added, drawing stays free running
+ */
+bool FramePacing_Init(uint8_t frames, uint16_t line)
+{
+    uint16_t fmi;
+    if(frames >= 6){
+        Interval = 6;
+        fmi = FMARK_EVERY_6_FRAMES;
+    }
+    else if(frames >= 4){
+        Interval = 4;
+        fmi = FMARK_EVERY_4_FRAMES;
+    }
+    else if(frames >= 2){
+        Interval = 2;
+        fmi = FMARK_EVERY_2_FRAMES;
+    }
+    else{
+        Interval = 1;
+        fmi = FMARK_EVERY_FRAME;
+    }
+    MarkLine = line % LCD_FRAME_LINES;
+
+    G8RTOS_InitSemaphore(&FrameMark, 0);
+    Waiting = false;
+    Marks = 0;
+    FramePeriod = 0;
+    PacedFrames = 0;
+    MissedFrames = 0;
+    LastPacedMark = 0;
+
+    //Cycle counter stamps the marks
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    FRAME_FMARK_PORT->DIR &= ~FRAME_FMARK_PIN;
+    FRAME_FMARK_PORT->IES &= ~FRAME_FMARK_PIN;      //Rising edge, FMARK is a high pulse
+    FRAME_FMARK_PORT->IFG &= ~FRAME_FMARK_PIN;
+    FRAME_FMARK_PORT->IE |= FRAME_FMARK_PIN;
+    if(G8RTOS_AddAPeriodicEvent(FramePacing_MarkHandler, FRAME_IRQ_PRIORITY, FRAME_FMARK_IRQn) != NO_ERROR){
+        FRAME_FMARK_PORT->IE &= ~FRAME_FMARK_PIN;
+        return false;
+    }
+
+    LCD_SetFrameMarker(fmi, MarkLine, true);
+    Running = true;
+    return true;
+}
+
+/*
+ * Stops pacing, FMARK and its interrupt are turned off and drawing is free running again
+ */
+void FramePacing_Stop()
+{
+    Running = false;
+    LCD_SetFrameMarker(FMARK_EVERY_FRAME, 0, false);
+    FRAME_FMARK_PORT->IE &= ~FRAME_FMARK_PIN;
+    FramePeriod = 0;
+
+    //A thread still blocked on a mark would never see one
+    if(Waiting){
+        Waiting = false;
+        G8RTOS_SignalSemaphore(&FrameMark);
+    }
+}
+
+/*
+ * Blocks until the next frame marker
+ *  - Sleeps FRAME_FREE_RUN_MS instead while pacing is off
+ */
+void FramePacing_WaitFrame()
+{
+    if(!Running){
+        sleep(FRAME_FREE_RUN_MS);
+        return;
+    }
+
+    Waiting = true;
+    G8RTOS_WaitSemaphore(&FrameMark);
+
+    //More than one mark since the last paced frame means drawing took too long
+    uint32_t marks = Marks;
+    if(PacedFrames > 0 && (marks - LastPacedMark) > 1){
+        MissedFrames += marks - LastPacedMark - 1;
+    }
+    LastPacedMark = marks;
+    PacedFrames++;
+}
+
+/*
+ * Holds back the write of an area until the scan will not cross it
+ *  - Returns at once if the write fits before the scan reaches xStart,
+ *    otherwise waits for the scan to pass xEnd
+ * Param "xStart", "xEnd": Screen columns the area covers
+ * Param "pixels": Pixels that will be written
+ */
+void FramePacing_WaitClear(int16_t xStart, int16_t xEnd, uint32_t pixels)
+{
+    uint32_t period = FramePeriod;
+    if(!Running || period == 0){
+        return;
+    }
+
+    uint32_t cyclesPerLine = period / LCD_FRAME_LINES;
+    uint32_t writeLines = (pixels * FRAME_WRITE_CYCLES_PER_PIXEL) / cyclesPerLine + 1;
+    int16_t scan = FramePacing_ScanColumn();
+
+    //Scan inside the area, wait for it to leave
+    if(scan >= xStart && scan <= xEnd){
+        WaitLines(xEnd - scan + 1, cyclesPerLine);
+        return;
+    }
+
+    //Lines until the scan gets to the area, wrapping through the porches
+    int32_t ahead = xStart - scan;
+    if(ahead < 0){
+        ahead += LCD_FRAME_LINES;
+    }
+    if((uint32_t)ahead > writeLines){
+        return;
+    }
+
+    //Write would be caught up with, start right behind the scan instead
+    WaitLines(ahead + (xEnd - xStart) + 1, cyclesPerLine);
+}
+
+/*
+ * Returns: Screen column the panel is scanning, < 0 or >= MAX_SCREEN_X in the porches
+ *          and -1 while the refresh period is not known yet
+ */
+int16_t FramePacing_ScanColumn()
+{
+    uint32_t period = FramePeriod;
+    uint32_t mark = LastMark;
+    if(period == 0){
+        return -1;
+    }
+
+    //Marks only come every Interval frames, the frames in between scan the same way
+    uint32_t elapsed = (DWT->CYCCNT - mark) % period;
+    uint32_t line = (MarkLine + (uint32_t)(((uint64_t)elapsed * LCD_FRAME_LINES) / period)) % LCD_FRAME_LINES;
+    return (int16_t)line - LCD_BACK_PORCH_LINES;
+}
+
+/*
+ * Returns: Measured panel refresh rate in tenths of a Hz, 0 while it is not known yet
+ */
+uint32_t FramePacing_GetRefreshRate()
+{
+    uint32_t period = FramePeriod;
+    if(period == 0){
+        return 0;
+    }
+    return (uint32_t)(((uint64_t)SystemCoreClock * 10) / period);
+}
+
+/*
+ * Returns: Number of frames FramePacing_WaitFrame has paced
+ */
+uint32_t FramePacing_GetFrames()
+{
+    return PacedFrames;
+}
+
+/*
+ * Returns: Frame markers that went by while a frame was still being drawn
+ */
+uint32_t FramePacing_GetMissedFrames()
+{
+    return MissedFrames;
+}
+
+/*********************************************** Public Functions *********************************************************************/
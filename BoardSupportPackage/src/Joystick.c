@@ -6,25 +6,89 @@
  */
 /*********************************************** Dependencies and Externs *************************************************************/
 #include <stdint.h>
+#include <stdbool.h>
 #include "msp.h"
 #include "Joystick.h"
 #include "driverlib.h"
+#include "DMAControl.h"
 /*********************************************** Dependencies and Externs *************************************************************/
 
 
 /*********************************************** Defines *********************************************************************/
 #define X_COORD_ADC_PIN 0
 #define Y_COORD_ADC_PIN 1
+
+/* Middle of the 14-bit range, subtracted so the stick at rest reads about 0 */
+#define JOYSTICK_ADC_CENTER 0x1FFF
+
+/* uDMA channel 7 carries the ADC14 end of sequence request, its completion interrupt is DMA_INT2 */
+#define JOYSTICK_DMA_CHANNEL 7
+
+/* One block is a whole sequence, MEM[0] .. MEM[2 * JOYSTICK_OVERSAMPLE - 1], X and Y alternating */
+#define JOYSTICK_BLOCK_WORDS (2 * JOYSTICK_OVERSAMPLE)
+#if JOYSTICK_BLOCK_WORDS != 8
+#error "The uDMA arbitration size (UDMA_ARB_8) has to match JOYSTICK_BLOCK_WORDS"
+#endif
+
+/* Sampling timer, CCR1 of TIMER_A1 is ADC14 trigger source 3 (SHS = 3), one edge per conversion */
+#define JOYSTICK_TRIGGER_HZ (JOYSTICK_SAMPLE_HZ * JOYSTICK_BLOCK_WORDS)
 /*********************************************** Defines *********************************************************************/
 
 
 
-/*********************************************** Public Variables ********************************************************************/
+/*********************************************** Private Variables ********************************************************************/
+
+/* Ping-pong blocks, the uDMA fills one while the other is averaged */
+static uint16_t SampleBlocks[2][JOYSTICK_BLOCK_WORDS];
+
+/* Latest averaged sample, X in the upper half and Y in the lower, one word so reads never tear */
+static volatile uint32_t LatestSample = 0;
+static volatile uint32_t SampleCount = 0;
+static bool Sampling = false;
+
+/*********************************************** Private Variables ********************************************************************/
+
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*
+ * Points one control structure (UDMA_PRI_SELECT or UDMA_ALT_SELECT) at its block
+ */
+static void ArmBlock(uint32_t select, uint16_t *block)
+{
+    DMA_setChannelTransfer(select | DMA_CH7_ADC14, UDMA_MODE_PINGPONG,
+                           (void *)&ADC14->MEM[0], block, JOYSTICK_BLOCK_WORDS);
+}
 
-/* Function Pointer for calling user defined function for joystick button press */
-void (*ButtonFunction)(void);
+/*
+ * Runs TIMER_A1 in up mode at JOYSTICK_TRIGGER_HZ from the SMCLK it finds, CCR1 set/reset
+ * gives one rising edge on the ADC trigger every period
+ *  - SMCLK is read at runtime instead of taken as 12 MHz
+ *  - The input divider goes up to /8 for slow rates on a fast SMCLK, past that the rate is clamped
+ */
+static void StartTriggerTimer()
+{
+    uint32_t period = CS_getSMCLK() / JOYSTICK_TRIGGER_HZ;
+    uint16_t divider = 0;
+    while(period > 0x10000 && divider < 3){
+        period >>= 1;
+        divider++;
+    }
+    if(period > 0x10000){
+        period = 0x10000;
+    }
+    if(period < 2){
+        period = 2;
+    }
+
+    TIMER_A1->CTL = TIMER_A_CTL_SSEL__SMCLK | (divider << TIMER_A_CTL_ID_OFS) | TIMER_A_CTL_CLR;
+    TIMER_A1->CCR[0] = period - 1;
+    TIMER_A1->CCR[1] = period / 2;
+    TIMER_A1->CCTL[1] = TIMER_A_CCTLN_OUTMOD_3;
+    TIMER_A1->CTL |= TIMER_A_CTL_MC__UP;
+}
 
-/*********************************************** Public Variables ********************************************************************/
+/*********************************************** Private Functions ********************************************************************/
 
 
 /*********************************************** Public Functions *********************************************************************/
@@ -32,6 +96,7 @@ void (*ButtonFunction)(void);
  * Initializes internal ADC
  * ADC input from P6.0 and P6.1 ( A15 and A14 )
  * Configured for 14-bit res
+ * The push button (P4.3) is handled by Buttons, debounced and queued
  */
 void Joystick_Init_Without_Interrupt()
 {
@@ -60,39 +125,78 @@ void Joystick_Init_Without_Interrupt()
 }
 
 /*
- * Init's GPIO interrupt for joystick push button
- * Param: Function pointer to button handler
+ * Starts sampling the joystick in the background
+ *  - Every TIMER_A1 edge converts the next channel of a repeated sequence of
+ *    JOYSTICK_OVERSAMPLE X/Y pairs, so a sequence takes 1 / JOYSTICK_SAMPLE_HZ.
+ *    The uDMA moves each finished sequence into a ping-pong block
+ *  - DMA_INT2 averages the finished block into the latest sample and re-arms it
+ *  - GetJoystickCoordinates only reads the latest sample from then on
+ * Needs Joystick_Init_Without_Interrupt first (pins and ADC on)
  */
-void Joystick_Push_Button_Init_With_Interrupt(void (*UserButtonFunction)(void))
+void Joystick_StartSampling()
 {
-    /* Initialize Button Press Interrupt */
-    // Configure Port4.3 to be used as GPIO interrupt for joystick button press -- falling edge triggered
-    P4->DIR &= ~BIT3;        // Set P4.3 as input
-    P4->IFG &= ~BIT3;       // P4.3 IFG cleared
-    P4->IE |= BIT3;         // Enable interrupt on P4.3
-    P4->IES |= BIT3;        // high-to-low transition
-    P4->REN |= BIT3;        // Pull-up resister
-    P4->OUT |= BIT3;
-
-    NVIC_EnableIRQ(PORT4_IRQn);
-    MAP_Interrupt_setPriority(INT_PORT4, 6);
-    ButtonFunction = UserButtonFunction;
+    uint16_t i;
+
+    //ADC setup can only change with ENC off
+    ADC14->CTL0 &= ~ADC14_CTL0_ENC;
+
+    //Repeat sequence without MSC, each timer edge converts one channel and ENC stays armed.
+    //MSC would run the rest of the sequence, and every one after it, without waiting for the timer
+    ADC14->CTL0 = ADC14_CTL0_ON | ADC14_CTL0_SHP | ADC14_CTL0_SSEL__SMCLK |
+                  ADC14_CTL0_CONSEQ_3 | ADC14_CTL0_SHS_3;
+    ADC14->CTL1 = ADC14_CTL1_CH0MAP | ADC14_CTL1_RES__14BIT;
+    for(i = 0; i < JOYSTICK_BLOCK_WORDS; i++){
+        ADC14->MCTL[i] = (i & 1) ? ADC14_MCTLN_INCH_14 : ADC14_MCTLN_INCH_15;
+    }
+    ADC14->MCTL[JOYSTICK_BLOCK_WORDS - 1] |= ADC14_MCTLN_EOS;
+    ADC14->IER0 = 0;    //Results are picked up by the uDMA only
+
+    //Both control structures armed, the uDMA flips between them on its own
+    DMAControl_Init();
+    DMA_assignChannel(DMA_CH7_ADC14);
+    DMA_disableChannelAttribute(DMA_CH7_ADC14, UDMA_ATTR_ALTSELECT | UDMA_ATTR_USEBURST |
+                                UDMA_ATTR_HIGH_PRIORITY | UDMA_ATTR_REQMASK);
+    DMA_setChannelControl(UDMA_PRI_SELECT | DMA_CH7_ADC14,
+                          UDMA_SIZE_16 | UDMA_SRC_INC_16 | UDMA_DST_INC_16 | UDMA_ARB_8);
+    DMA_setChannelControl(UDMA_ALT_SELECT | DMA_CH7_ADC14,
+                          UDMA_SIZE_16 | UDMA_SRC_INC_16 | UDMA_DST_INC_16 | UDMA_ARB_8);
+    ArmBlock(UDMA_PRI_SELECT, SampleBlocks[0]);
+    ArmBlock(UDMA_ALT_SELECT, SampleBlocks[1]);
+
+    DMA_assignInterrupt(DMA_INT2, JOYSTICK_DMA_CHANNEL);
+    DMA_clearInterruptFlag(JOYSTICK_DMA_CHANNEL);
+    Interrupt_setPriority(DMA_INT2, 6 << 5);
+    DMA_enableInterrupt(DMA_INT2);
+    DMA_enableChannel(JOYSTICK_DMA_CHANNEL);
+
+    ADC14->CTL0 |= ADC14_CTL0_ENC;
+
+    Sampling = true;
+    StartTriggerTimer();
 }
 
 /*
- * Function to disable joystick interrupt
+ * Returns: Number of averaged samples taken since Joystick_StartSampling
  */
-void Disable_Joystick_Interrupt()
+uint32_t Joystick_GetSampleCount()
 {
-    P4->IFG &= ~BIT3;       // P4.3 IFG cleared
-    P4->IE &= ~BIT3;         // Disable interrupt on P4.3
+    return SampleCount;
 }
 
 /*
  * Functions returns X and Y coordinates
+ *  - Latest averaged sample once Joystick_StartSampling ran, never blocks
+ *  - Before that one conversion is started and waited for
  */
 void GetJoystickCoordinates(int16_t *x_coord, int16_t *y_coord)
 {
+    if(Sampling){
+        uint32_t sample = LatestSample;
+        *x_coord = (int16_t)(sample >> 16);
+        *y_coord = (int16_t)(sample & 0xFFFF);
+        return;
+    }
+
     // Start conversion
     ADC14->CTL0 |= ADC14_CTL0_ENC | ADC14_CTL0_SC;
 
@@ -100,16 +204,36 @@ void GetJoystickCoordinates(int16_t *x_coord, int16_t *y_coord)
     while(ADC14->CTL0 & ADC14_CTL0_BUSY); // consider implementing ISR for conversion complete
 
     // Read from x and y coordinates
-    *x_coord = ADC14->MEM[X_COORD_ADC_PIN] - 0x1FFF;
-    *y_coord = ADC14->MEM[Y_COORD_ADC_PIN] - 0x1FFF;
+    *x_coord = ADC14->MEM[X_COORD_ADC_PIN] - JOYSTICK_ADC_CENTER;
+    *y_coord = ADC14->MEM[Y_COORD_ADC_PIN] - JOYSTICK_ADC_CENTER;
 }
 
-//__interrupt void PORT4_IRQHandler (void)
-//{
-//    ButtonFunction();
-//
-//    P4->IFG &= ~BIT3;       // P4.3 IFG cleared
-//}
+/*
+ * End of one ping-pong block, averages it into the latest sample and re-arms it
+ *  - The structure that finished is the one the uDMA is no longer on
+ *  - Never calls the kernel, so it can sit below SYSCALL_PRIORITY
+ */
+void DMA_INT2_IRQHandler(void)
+{
+    DMA_clearInterruptFlag(JOYSTICK_DMA_CHANNEL);
+
+    bool alternateActive = (DMA_getChannelAttribute(DMA_CH7_ADC14) & UDMA_ATTR_ALTSELECT) != 0;
+    uint32_t select = alternateActive ? UDMA_PRI_SELECT : UDMA_ALT_SELECT;
+    uint16_t *block = alternateActive ? SampleBlocks[0] : SampleBlocks[1];
+
+    uint32_t sumX = 0, sumY = 0;
+    uint16_t i;
+    for(i = 0; i < JOYSTICK_BLOCK_WORDS; i += 2){
+        sumX += block[i];
+        sumY += block[i + 1];
+    }
+    int16_t x = (int16_t)(sumX / JOYSTICK_OVERSAMPLE) - JOYSTICK_ADC_CENTER;
+    int16_t y = (int16_t)(sumY / JOYSTICK_OVERSAMPLE) - JOYSTICK_ADC_CENTER;
+    LatestSample = ((uint32_t)(uint16_t)x << 16) | (uint16_t)y;
+    SampleCount++;
+
+    ArmBlock(select, block);
+}
 
 /*********************************************** Public Functions *********************************************************************/
 
@@ -0,0 +1,163 @@
+/*
+ * JoystickFilter.c
+ *
+ * Fixed point averaging, deadzone and response curve of the joystick readings
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "JoystickFilter.h"
+
+/*********************************************** Public Data **************************************************************************/
+
+const JoystickFilterConfig_t JoystickFilter_DefaultConfig = {
+    2,          //4 readings
+    600,        //About 7% of the throw
+    128,        //Half linear, half cubic
+    512,
+    8
+};
+
+/*********************************************** Public Data **************************************************************************/
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*
+ * Integer square root, rounded down
+ */
+static uint32_t ISqrt(uint32_t value)
+{
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+
+    while(bit > value){
+        bit >>= 2;
+    }
+    while(bit != 0){
+        if(value >= root + bit){
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else{
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+/*
+ * Absolute value, readings and outputs stay well inside int16_t
+ */
+static int16_t Abs16(int16_t value)
+{
+    return (value < 0) ? -value : value;
+}
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Starts a filter at rest
+ * Param "config": Tuning, copied into the filter
+ */
+void JoystickFilter_Init(JoystickFilter_t *filter, const JoystickFilterConfig_t *config)
+{
+    filter->Config = *config;
+    if(filter->Config.AverageShift > JOYSTICK_FILTER_MAX_SHIFT){
+        filter->Config.AverageShift = JOYSTICK_FILTER_MAX_SHIFT;
+    }
+    if(filter->Config.Deadzone >= JOYSTICK_FILTER_FULL_SCALE){
+        filter->Config.Deadzone = JOYSTICK_FILTER_FULL_SCALE - 1;
+    }
+    if(filter->Config.Expo > JOYSTICK_FILTER_EXPO_ONE){
+        filter->Config.Expo = JOYSTICK_FILTER_EXPO_ONE;
+    }
+
+    filter->SumX = 0;
+    filter->SumY = 0;
+    filter->Next = 0;
+    filter->Count = 0;
+    filter->ReportedX = 0;
+    filter->ReportedY = 0;
+}
+
+/*
+ * Deadzone and curve stages of JoystickFilter_Update on its own, no state is touched
+ * Param "rawX", "rawY": Averaged centered reading
+ * Param "x", "y": Return the conditioned position, -OutputMax .. OutputMax
+ */
+void JoystickFilter_Shape(const JoystickFilterConfig_t *config, int32_t rawX, int32_t rawY, int16_t *x, int16_t *y)
+{
+    const int32_t full = JOYSTICK_FILTER_FULL_SCALE;
+    int32_t deadzone = config->Deadzone;
+
+    //Deadzone is round, a diagonal does not leave it any earlier than an axis
+    int32_t radius = (int32_t)ISqrt((uint32_t)(rawX * rawX + rawY * rawY));
+    if(radius <= deadzone){
+        *x = 0;
+        *y = 0;
+        return;
+    }
+
+    //What is left of the throw goes from 0 right at the edge of the deadzone to full scale
+    int32_t magnitude = ((radius - deadzone) * full) / (full - deadzone);
+    if(magnitude > full){
+        magnitude = full;
+    }
+
+    //Blend of m and m^3 (both out of full scale), shallow near the center and steep at the end
+    int32_t cubic = (((magnitude * magnitude) / full) * magnitude) / full;
+    int32_t curved = ((JOYSTICK_FILTER_EXPO_ONE - config->Expo) * magnitude + config->Expo * cubic) / JOYSTICK_FILTER_EXPO_ONE;
+
+    //Back onto the axes in the direction of the reading, then to output units
+    *x = (int16_t)((((rawX * curved) / radius) * config->OutputMax) / full);
+    *y = (int16_t)((((rawY * curved) / radius) * config->OutputMax) / full);
+}
+
+/*
+ * Adds one centered reading
+ * Param "rawX", "rawY": Reading from GetJoystickCoordinates, about +-8192
+ * Param "x", "y": Return the reported position, -OutputMax .. OutputMax
+ * Returns: true if the reported position changed
+ */
+bool JoystickFilter_Update(JoystickFilter_t *filter, int16_t rawX, int16_t rawY, int16_t *x, int16_t *y)
+{
+    uint8_t size = 1 << filter->Config.AverageShift;
+
+    //Running sums, the oldest reading drops out once the history is full
+    if(filter->Count == size){
+        filter->SumX -= filter->HistoryX[filter->Next];
+        filter->SumY -= filter->HistoryY[filter->Next];
+    }
+    else{
+        filter->Count++;
+    }
+    filter->HistoryX[filter->Next] = rawX;
+    filter->HistoryY[filter->Next] = rawY;
+    filter->SumX += rawX;
+    filter->SumY += rawY;
+    filter->Next = (filter->Next + 1) & (size - 1);
+
+    int16_t shapedX, shapedY;
+    JoystickFilter_Shape(&filter->Config, filter->SumX / filter->Count, filter->SumY / filter->Count,
+                         &shapedX, &shapedY);
+
+    int16_t limit = filter->Config.OutputMax;
+    bool moved = (Abs16(shapedX - filter->ReportedX) >= filter->Config.Threshold) ||
+                 (Abs16(shapedY - filter->ReportedY) >= filter->Config.Threshold);
+    bool rest = (shapedX == 0 && shapedY == 0);
+    bool end = (Abs16(shapedX) == limit || Abs16(shapedY) == limit);
+    bool changed = (shapedX != filter->ReportedX || shapedY != filter->ReportedY) && (moved || rest || end);
+
+    if(changed){
+        filter->ReportedX = shapedX;
+        filter->ReportedY = shapedY;
+    }
+    *x = filter->ReportedX;
+    *y = filter->ReportedY;
+    return changed;
+}
+
+/*********************************************** Public Functions *********************************************************************/
@@ -0,0 +1,200 @@
+/*
+ * LCDQueue.c
+ *
+ * Render thread and locked posting of queued LCD commands
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "msp.h"
+#include "LCDQueue.h"
+#include "LCD_empty.h"
+#include "G8RTOS.h"
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+static RenderQueue_t Queue;
+
+/* Guards Queue, held only for a push or a pop */
+static semaphore_t QueueLock;
+
+/* Counts posts, the render thread sleeps on it while the queue is empty */
+static semaphore_t Posted;
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*
+ * Queues a command and wakes the render thread
+ */
+static bool Post(const RenderCmd_t *cmd)
+{
+    G8RTOS_WaitSemaphore(&QueueLock);
+    bool queued = RenderQueue_Push(&Queue, cmd);
+    G8RTOS_SignalSemaphore(&QueueLock);
+
+    if(queued){
+        G8RTOS_SignalSemaphore(&Posted);
+    }
+    return queued;
+}
+
+/*
+ * Draws one command, render thread only
+ */
+static void Execute(RenderCmd_t *cmd)
+{
+    switch(cmd->Type){
+    case RENDER_RECT:
+        LCD_DrawRectangle(cmd->x, cmd->x + cmd->w - 1, cmd->y, cmd->y + cmd->h - 1, cmd->Color);
+        break;
+    case RENDER_BLIT:
+        LCD_BlitRGB565(cmd->x, cmd->y, cmd->w, cmd->h, cmd->Pixels ? cmd->Pixels : cmd->Copy);
+        break;
+    case RENDER_TEXT:
+        LCD_Text(cmd->x, cmd->y, (uint8_t *)cmd->Text, cmd->Color, cmd->bkColor);
+        break;
+    case RENDER_CLEAR:
+        LCD_Clear(cmd->Color);
+        break;
+    }
+}
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Empties the queue, call before the render thread is added
+ */
+void LCDQueue_Init()
+{
+    RenderQueue_Init(&Queue);
+    G8RTOS_InitSemaphore(&QueueLock, 1);
+    G8RTOS_InitSemaphore(&Posted, 0);
+}
+
+/*
+ * Render thread, add it with G8RTOS_AddThread
+ *  - Sleeps until something is posted, then draws everything pending in order
+ */
+void LCDQueue_Thread()
+{
+    RenderCmd_t cmd;
+    while(1){
+        G8RTOS_WaitSemaphore(&Posted);
+
+        //Posts that were coalesced away leave extra counts behind, an empty queue just waits again
+        while(1){
+            G8RTOS_WaitSemaphore(&QueueLock);
+            bool pending = RenderQueue_Pop(&Queue, &cmd);
+            G8RTOS_SignalSemaphore(&QueueLock);
+
+            if(!pending){
+                break;
+            }
+            Execute(&cmd);
+        }
+    }
+}
+
+/*
+ * Posts LCD_DrawRectangle (corners inclusive)
+ * Returns: false if the queue is full and the command was dropped
+ */
+bool LCDQueue_Rectangle(int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd, uint16_t Color)
+{
+    if(xEnd < xStart || yEnd < yStart){
+        return true;    //Nothing to draw
+    }
+
+    RenderCmd_t cmd;
+    cmd.Type = RENDER_RECT;
+    cmd.x = xStart;
+    cmd.y = yStart;
+    cmd.w = xEnd - xStart + 1;
+    cmd.h = yEnd - yStart + 1;
+    cmd.Color = Color;
+    return Post(&cmd);
+}
+
+/*
+ * Posts LCD_BlitRGB565
+ *  - Up to RENDER_BLIT_COPY_MAX pixels are copied, the buffer is free again on return
+ *  - Past that only the pointer is queued, the pixels must stay unchanged until they are drawn
+ * Returns: false if the queue is full and the command was dropped
+ */
+bool LCDQueue_Blit(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint16_t *pixels)
+{
+    RenderCmd_t cmd;
+    cmd.Type = RENDER_BLIT;
+    cmd.x = x;
+    cmd.y = y;
+    cmd.w = w;
+    cmd.h = h;
+
+    uint32_t count = (uint32_t)w * h;
+    if(count <= RENDER_BLIT_COPY_MAX){
+        memcpy(cmd.Copy, pixels, count * sizeof(uint16_t));
+        cmd.Pixels = 0;
+    }
+    else{
+        cmd.Pixels = pixels;
+    }
+    return Post(&cmd);
+}
+
+/*
+ * Posts LCD_Text, the string is copied (up to RENDER_TEXT_MAX characters)
+ * Returns: false if the queue is full and the command was dropped
+ */
+bool LCDQueue_Text(uint16_t Xpos, uint16_t Ypos, const char *str, uint16_t Color, uint16_t bkColor)
+{
+    RenderCmd_t cmd;
+    cmd.Type = RENDER_TEXT;
+    cmd.x = Xpos;
+    cmd.y = Ypos;
+    cmd.w = 0;
+    cmd.h = 0;
+    cmd.Color = Color;
+    cmd.bkColor = bkColor;
+    strncpy(cmd.Text, str, RENDER_TEXT_MAX);
+    cmd.Text[RENDER_TEXT_MAX] = 0;
+    return Post(&cmd);
+}
+
+/*
+ * Posts LCD_Clear, everything still pending is dropped
+ * Returns: false if the queue is full and the command was dropped
+ */
+bool LCDQueue_Clear(uint16_t Color)
+{
+    RenderCmd_t cmd;
+    cmd.Type = RENDER_CLEAR;
+    cmd.x = 0;
+    cmd.y = 0;
+    cmd.w = MAX_SCREEN_X;
+    cmd.h = MAX_SCREEN_Y;
+    cmd.Color = Color;
+    return Post(&cmd);
+}
+
+/*
+ * Returns: Commands dropped because a later one painted over them
+ */
+uint32_t LCDQueue_GetCoalesced()
+{
+    return Queue.Coalesced;
+}
+
+/*
+ * Returns: Commands dropped because the queue was full
+ */
+uint32_t LCDQueue_GetRejected()
+{
+    return Queue.Rejected;
+}
+
+/*********************************************** Public Functions *********************************************************************/
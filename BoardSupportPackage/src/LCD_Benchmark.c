@@ -0,0 +1,147 @@
+/*
+ * LCD_Benchmark.c
+ *
+ * ILI9325 throughput benchmark of the LCD drawing primitives
+ *  - On the board every case is timed with the DWT cycle counter,
+ *    run it before G8RTOS_Launch so no other thread is counted
+ *  - Under LCD_EMULATOR the bus bytes of every case are counted instead and
+ *    the rate is what the bus allows at LCD_SPI_CLOCK
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "LCD_Benchmark.h"
+#include "LCD_empty.h"
+#ifndef LCD_EMULATOR
+#include "msp.h"
+#endif
+
+/*********************************************** Defines ******************************************************************************/
+
+/* Same default as LCD_empty.c, only used to turn emulated bytes into time */
+#ifndef LCD_SPI_CLOCK
+#define LCD_SPI_CLOCK 12000000
+#endif
+
+/* Side of the blit source */
+#define BENCH_BLIT_SIZE 32
+
+/*********************************************** Defines ******************************************************************************/
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+/* System Core Clock From system_msp432p401r.c */
+extern uint32_t SystemCoreClock;
+
+static uint16_t BlitSource[BENCH_BLIT_SIZE * BENCH_BLIT_SIZE];
+
+#ifndef LCD_EMULATOR
+/* DWT stamp of StartCount, the counter is shared (WCET, kernel sections, LCD_Perf) and never written */
+static uint32_t CountStart;
+#endif
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*
+ * One call of a case, "call" moves the drawing around so nothing is cached on the way
+ */
+static void RunCase(uint16_t benchCase, uint16_t call)
+{
+    int16_t offset = call * 4;
+    switch(benchCase){
+    case 0:
+        LCD_Clear((call & 1) ? LCD_BLUE : LCD_BLACK);
+        break;
+    case 1:
+        LCD_DrawRectangle(offset, offset + 7, offset, offset + 7, LCD_RED);
+        break;
+    case 2:
+        LCD_DrawRectangle(offset, offset + 63, offset, offset + 63, LCD_GREEN);
+        break;
+    case 3:
+        LCD_BlitRGB565(offset, offset, BENCH_BLIT_SIZE, BENCH_BLIT_SIZE, BlitSource);
+        break;
+    case 4:
+        LCD_BlitRGB565(offset, offset, 8, 8, BlitSource);
+        break;
+    default:
+        LCD_Text(0, offset, (uint8_t *)"Score 0123456789", LCD_WHITE, LCD_BLACK);
+        break;
+    }
+}
+
+/*
+ * Starts counting what one case costs
+ */
+static void StartCount()
+{
+#ifdef LCD_EMULATOR
+    LCDEmu_ResetStats();
+#else
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    CountStart = DWT->CYCCNT;
+#endif
+}
+
+/*
+ * Fills in the cost of LCD_BENCH_REPEAT calls of a case
+ */
+static void StopCount(LCD_BenchResult_t *result)
+{
+    uint64_t rate = 0;
+#ifdef LCD_EMULATOR
+    result->Cycles = 0;
+    result->Bytes = LCDEmu_GetStats().Bytes / LCD_BENCH_REPEAT;
+    if(result->Bytes){
+        rate = (uint64_t)result->Pixels * (LCD_SPI_CLOCK / 8) / result->Bytes;
+    }
+#else
+    result->Cycles = (DWT->CYCCNT - CountStart) / LCD_BENCH_REPEAT;
+    result->Bytes = 0;
+    if(result->Cycles){
+        rate = (uint64_t)result->Pixels * SystemCoreClock / result->Cycles;
+    }
+#endif
+    result->KPixelsPerSecond = rate / 1000;
+}
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Runs every case LCD_BENCH_REPEAT times, the screen is left cleared to black
+ * Param "results": LCD_BENCH_CASES results, in the order of the cases above
+ */
+void LCD_Benchmark(LCD_BenchResult_t *results)
+{
+    static const char *names[LCD_BENCH_CASES] = {
+        "clear 320x240", "rect 8x8", "rect 64x64", "blit 32x32", "blit 8x8", "text 16 chars"
+    };
+    static const uint32_t pixels[LCD_BENCH_CASES] = {
+        MAX_SCREEN_X * MAX_SCREEN_Y, 8 * 8, 64 * 64, BENCH_BLIT_SIZE * BENCH_BLIT_SIZE, 8 * 8, 16 * 8 * 16
+    };
+
+    uint16_t i, call;
+    for(i = 0; i < BENCH_BLIT_SIZE * BENCH_BLIT_SIZE; i++){
+        BlitSource[i] = i * 0x0821;     //Gradient so the bytes of a pixel differ
+    }
+
+    for(i = 0; i < LCD_BENCH_CASES; i++){
+        results[i].Name = names[i];
+        results[i].Pixels = pixels[i];
+
+        StartCount();
+        for(call = 0; call < LCD_BENCH_REPEAT; call++){
+            RunCase(i, call);
+        }
+        StopCount(&results[i]);
+    }
+
+    LCD_Clear(LCD_BLACK);
+}
+
+/*********************************************** Public Functions *********************************************************************/
@@ -0,0 +1,418 @@
+/*
+ * LCD_Emulator.c
+ *
+ * Virtual ILI9325 behind the LCD SPI bus, for running the drawing code on a PC
+ *  - Only built with LCD_EMULATOR defined, LCD_empty.c then sends every SPI byte and
+ *    chip select edge here instead of EUSCI_B3 and P10
+ *  - Decodes index writes, register writes and reads, the GRAM window and the
+ *    address counter (ENTRY_MODE AM and I/D bits) into a 320x240 RGB565 framebuffer
+ *  - Counts the bus traffic so drawing primitives can be compared byte for byte
+ */
+
+#ifdef LCD_EMULATOR
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "LCD_Emulator.h"
+#include "LCD_empty.h"
+
+/*********************************************** Defines ******************************************************************************/
+
+/* GRAM is 240 horizontal addresses (screen y) by 320 vertical addresses (screen x) */
+#define GRAM_H      MAX_SCREEN_Y
+#define GRAM_V      MAX_SCREEN_X
+
+/* ENTRY_MODE bits that steer the address counter */
+#define ENTRY_AM    0x0008      //1: vertical address moves first
+#define ENTRY_ID0   0x0010      //1: horizontal address counts up
+#define ENTRY_ID1   0x0020      //1: vertical address counts up
+
+/* Start byte without the RS and RW bits */
+#define START_MASK  0xFC
+
+/*********************************************** Defines ******************************************************************************/
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+/* Where in a transaction the next byte lands */
+typedef enum
+{
+    BUS_IDLE = 0,           //CS high, bytes are for another device (touch panel)
+    BUS_START = 1,          //Next byte is the start byte
+    BUS_INDEX = 2,          //Index write
+    BUS_WRITE = 3,          //Register or GRAM data write
+    BUS_READ = 4            //Register or GRAM read, first byte is a dummy
+} busState_t;
+
+static uint16_t Gram[GRAM_H][GRAM_V];
+static uint16_t Registers[256];
+static uint8_t Index;
+
+/* Address counter */
+static int16_t AddressH;
+static int16_t AddressV;
+
+static busState_t Bus;
+static uint8_t HighByte;
+static uint16_t BytesInPhase;
+static uint16_t ReadValue;
+
+static LCDEmu_Stats_t Stats;
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*
+ * Steps the address counter after a GRAM access, wrapping inside the window
+ */
+static void AdvanceAddress()
+{
+    uint16_t entry = Registers[ENTRY_MODE];
+    int16_t hStart = Registers[HOR_ADDR_START_POS], hEnd = Registers[HOR_ADDR_END_POS];
+    int16_t vStart = Registers[VERT_ADDR_START_POS], vEnd = Registers[VERT_ADDR_END_POS];
+    int16_t hStep = (entry & ENTRY_ID0) ? 1 : -1;
+    int16_t vStep = (entry & ENTRY_ID1) ? 1 : -1;
+
+    if(entry & ENTRY_AM){
+        AddressV += vStep;
+        if(AddressV > vEnd || AddressV < vStart){
+            AddressV = (vStep > 0) ? vStart : vEnd;
+            AddressH += hStep;
+            if(AddressH > hEnd || AddressH < hStart){
+                AddressH = (hStep > 0) ? hStart : hEnd;
+            }
+        }
+    }
+    else{
+        AddressH += hStep;
+        if(AddressH > hEnd || AddressH < hStart){
+            AddressH = (hStep > 0) ? hStart : hEnd;
+            AddressV += vStep;
+            if(AddressV > vEnd || AddressV < vStart){
+                AddressV = (vStep > 0) ? vStart : vEnd;
+            }
+        }
+    }
+}
+
+/*
+ * A full 16 bit word of a data write arrived
+ */
+static void WriteData(uint16_t value)
+{
+    if(Index == DATA_IN_GRAM){
+        if(AddressH >= 0 && AddressH < GRAM_H && AddressV >= 0 && AddressV < GRAM_V){
+            Gram[AddressH][AddressV] = value;
+        }
+        AdvanceAddress();
+        Stats.Pixels++;
+        return;
+    }
+
+    Registers[Index] = value;
+    Stats.RegisterWrites++;
+    if(Index == GRAM_HORIZONTAL_ADDRESS_SET){
+        AddressH = value;
+    }
+    else if(Index == GRAM_VERTICAL_ADDRESS_SET){
+        AddressV = value;
+    }
+}
+
+/*
+ * Value a read of the selected register returns
+ */
+static uint16_t ReadData()
+{
+    if(Index == READ_ID_CODE){
+        return 0x9325;
+    }
+    if(Index == DATA_IN_GRAM){
+        uint16_t value = 0;
+        if(AddressH >= 0 && AddressH < GRAM_H && AddressV >= 0 && AddressV < GRAM_V){
+            value = Gram[AddressH][AddressV];
+        }
+        AdvanceAddress();
+        return value;
+    }
+    return Registers[Index];
+}
+
+/*
+ * Big endian helpers for the PNG chunks
+ */
+static void Put32(uint8_t *out, uint32_t value)
+{
+    out[0] = value >> 24;
+    out[1] = value >> 16;
+    out[2] = value >> 8;
+    out[3] = value;
+}
+
+static uint32_t Crc32(uint32_t crc, const uint8_t *data, uint32_t length)
+{
+    uint32_t i;
+    int bit;
+    crc = ~crc;
+    for(i = 0; i < length; i++){
+        crc ^= data[i];
+        for(bit = 0; bit < 8; bit++){
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+/*
+ * Writes one PNG chunk (length, type, data, CRC of type and data)
+ */
+static void WriteChunk(FILE *file, const char *type, const uint8_t *data, uint32_t length)
+{
+    uint8_t word[4];
+    Put32(word, length);
+    fwrite(word, 1, 4, file);
+    fwrite(type, 1, 4, file);
+    if(length){
+        fwrite(data, 1, length, file);
+    }
+    Put32(word, Crc32(Crc32(0, (const uint8_t *)type, 4), data, length));
+    fwrite(word, 1, 4, file);
+}
+
+/*
+ * RGB565 to 8 bit per channel
+ */
+static void ToRGB888(uint16_t pixel, uint8_t *rgb)
+{
+    rgb[0] = ((pixel >> 11) & 0x1F) * 255 / 31;
+    rgb[1] = ((pixel >> 5) & 0x3F) * 255 / 63;
+    rgb[2] = (pixel & 0x1F) * 255 / 31;
+}
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Puts the controller in its reset state (registers at their defaults, black GRAM)
+ * and clears the counters
+ */
+void LCDEmu_Reset()
+{
+    memset(Gram, 0, sizeof(Gram));
+    memset(Registers, 0, sizeof(Registers));
+    Registers[ENTRY_MODE] = ENTRY_ID1 | ENTRY_ID0;
+    Registers[HOR_ADDR_END_POS] = GRAM_H - 1;
+    Registers[VERT_ADDR_END_POS] = GRAM_V - 1;
+    Index = 0;
+    AddressH = 0;
+    AddressV = 0;
+    Bus = BUS_IDLE;
+    LCDEmu_ResetStats();
+}
+
+/*
+ * LCD chip select, true while CS is low
+ */
+void LCDEmu_ChipSelect(bool selected)
+{
+    if(selected && Bus == BUS_IDLE){
+        Bus = BUS_START;
+        Stats.Transactions++;
+    }
+    else if(!selected){
+        Bus = BUS_IDLE;
+    }
+}
+
+/*
+ * Clocks one byte over the bus
+ * Returns: Byte the controller shifts back (register and GRAM reads)
+ */
+uint8_t LCDEmu_Transfer(uint8_t byte)
+{
+    uint8_t out = 0;
+
+    if(Bus == BUS_IDLE){
+        return 0;
+    }
+    Stats.Bytes++;
+
+    switch(Bus){
+    case BUS_START:
+        BytesInPhase = 0;
+        if((byte & START_MASK) != SPI_START){
+            Bus = BUS_IDLE;     //Not a start byte, the controller ignores the rest
+        }
+        else if(byte & SPI_RD){
+            Bus = BUS_READ;
+        }
+        else{
+            Bus = (byte & SPI_DATA) ? BUS_WRITE : BUS_INDEX;
+        }
+        break;
+    case BUS_INDEX:
+    case BUS_WRITE:
+        if((BytesInPhase++ & 1) == 0){
+            HighByte = byte;
+        }
+        else if(Bus == BUS_INDEX){
+            Index = byte;
+        }
+        else{
+            WriteData((HighByte << 8) | byte);
+        }
+        break;
+    case BUS_READ:
+        //Dummy byte, then the value high byte first
+        if(BytesInPhase % 3 == 0){
+            ReadValue = ReadData();
+        }
+        else if(BytesInPhase % 3 == 1){
+            out = ReadValue >> 8;
+        }
+        else{
+            out = ReadValue & 0xFF;
+        }
+        BytesInPhase++;
+        break;
+    default:
+        break;
+    }
+    return out;
+}
+
+/*
+ * Returns: Screen pixel (landscape, x across 320 and y down 240) as RGB565
+ */
+uint16_t LCDEmu_GetPixel(uint16_t x, uint16_t y)
+{
+    if(x >= MAX_SCREEN_X || y >= MAX_SCREEN_Y){
+        return 0;
+    }
+    //Vertical scroll moves the gate lines, which are screen columns
+    if(Registers[GATE_SCAN_CONTROL_0X61] & GATE_SCAN_VLE){
+        x = (x + Registers[GATE_SCAN_CONTROL_0X6A]) % MAX_SCREEN_X;
+    }
+    return Gram[y][x];
+}
+
+/*
+ * Returns: Last value written to a register
+ */
+uint16_t LCDEmu_GetRegister(uint8_t index)
+{
+    return Registers[index];
+}
+
+/*
+ * Returns: Bus traffic counted so far
+ */
+LCDEmu_Stats_t LCDEmu_GetStats()
+{
+    return Stats;
+}
+
+/*
+ * Clears the bus traffic counters
+ */
+void LCDEmu_ResetStats()
+{
+    memset(&Stats, 0, sizeof(Stats));
+}
+
+/*
+ * Writes the screen as a binary PPM (P6)
+ * Returns: false if the file could not be written
+ */
+bool LCDEmu_WritePPM(const char *path)
+{
+    FILE *file = fopen(path, "wb");
+    if(file == 0){
+        return false;
+    }
+
+    fprintf(file, "P6\n%d %d\n255\n", MAX_SCREEN_X, MAX_SCREEN_Y);
+    uint16_t x, y;
+    for(y = 0; y < MAX_SCREEN_Y; y++){
+        for(x = 0; x < MAX_SCREEN_X; x++){
+            uint8_t rgb[3];
+            ToRGB888(LCDEmu_GetPixel(x, y), rgb);
+            fwrite(rgb, 1, 3, file);
+        }
+    }
+    return fclose(file) == 0;
+}
+
+/*
+ * Writes the screen as an RGB PNG (stored, uncompressed deflate blocks)
+ * Returns: false if the file could not be written
+ */
+bool LCDEmu_WritePNG(const char *path)
+{
+    //Filter byte (none) in front of every row of RGB
+    enum { ROW_BYTES = 1 + MAX_SCREEN_X * 3, RAW_BYTES = ROW_BYTES * MAX_SCREEN_Y, BLOCK_MAX = 65535 };
+    static uint8_t raw[RAW_BYTES];
+    static uint8_t zlib[2 + RAW_BYTES + 5 * (RAW_BYTES / BLOCK_MAX + 1) + 4];
+
+    uint16_t x, y;
+    for(y = 0; y < MAX_SCREEN_Y; y++){
+        uint8_t *row = &raw[y * ROW_BYTES];
+        row[0] = 0;
+        for(x = 0; x < MAX_SCREEN_X; x++){
+            ToRGB888(LCDEmu_GetPixel(x, y), &row[1 + x * 3]);
+        }
+    }
+
+    //zlib stream of stored blocks, Adler-32 of the raw data at the end
+    uint32_t length = 0;
+    uint32_t done = 0;
+    uint32_t a = 1, b = 0;
+    zlib[length++] = 0x78;
+    zlib[length++] = 0x01;
+    while(done < RAW_BYTES){
+        uint32_t block = (RAW_BYTES - done > BLOCK_MAX) ? BLOCK_MAX : (RAW_BYTES - done);
+        zlib[length++] = (done + block == RAW_BYTES) ? 1 : 0;     //BFINAL on the last block
+        zlib[length++] = block & 0xFF;
+        zlib[length++] = block >> 8;
+        zlib[length++] = ~block & 0xFF;
+        zlib[length++] = (~block >> 8) & 0xFF;
+        memcpy(&zlib[length], &raw[done], block);
+        length += block;
+        done += block;
+    }
+    for(done = 0; done < RAW_BYTES; done++){
+        a = (a + raw[done]) % 65521;
+        b = (b + a) % 65521;
+    }
+    Put32(&zlib[length], (b << 16) | a);
+    length += 4;
+
+    FILE *file = fopen(path, "wb");
+    if(file == 0){
+        return false;
+    }
+
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    uint8_t header[13];
+    Put32(&header[0], MAX_SCREEN_X);
+    Put32(&header[4], MAX_SCREEN_Y);
+    header[8] = 8;      //Bit depth
+    header[9] = 2;      //RGB
+    header[10] = 0;     //Deflate
+    header[11] = 0;     //Adaptive filtering
+    header[12] = 0;     //No interlace
+
+    fwrite(signature, 1, sizeof(signature), file);
+    WriteChunk(file, "IHDR", header, sizeof(header));
+    WriteChunk(file, "IDAT", zlib, length);
+    WriteChunk(file, "IEND", 0, 0);
+    return fclose(file) == 0;
+}
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* LCD_EMULATOR */
@@ -0,0 +1,172 @@
+/*
+ * LCD_Font.c
+ *
+ * Glyph lookup, text measuring and the cache of unscaled glyphs
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "LCD_Font.h"
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+/*
+ * One expanded glyph and what it was expanded for
+ */
+typedef struct FontCacheEntry_t{
+    const Font_t *Font;         //0 while the entry is empty
+    uint8_t Char;
+    uint16_t Color;
+    uint16_t bkColor;
+    uint16_t Width;
+    uint16_t Height;
+    uint32_t LastUse;
+    uint8_t Bytes[FONT_CACHE_BYTES];
+} FontCacheEntry_t;
+
+static FontCacheEntry_t FontCache[FONT_CACHE_GLYPHS];
+
+/* Lookup count, orders the entries by use */
+static uint32_t FontUses = 0;
+
+static uint32_t FontHits = 0;
+static uint32_t FontMisses = 0;
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*
+ * Characters without a glyph are drawn as the first one
+ */
+static uint8_t GlyphIndex(const Font_t *font, uint8_t ch)
+{
+    if(ch < font->FirstChar || ch > font->LastChar){
+        return 0;
+    }
+    return ch - font->FirstChar;
+}
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Returns: Advance of one character at 1x in pixels
+ */
+uint16_t Font_Advance(const Font_t *font, uint8_t ch)
+{
+    if(font->Widths == 0){
+        return font->Width;
+    }
+    return font->Widths[GlyphIndex(font, ch)];
+}
+
+/*
+ * Returns: Width of a string in pixels at the given scale (no wrapping)
+ */
+uint16_t Font_TextWidth(const Font_t *font, const char *str, uint8_t scale)
+{
+    uint16_t width = 0;
+    while(*str != 0){
+        width += Font_Advance(font, *str++) * scale;
+    }
+    return width;
+}
+
+/*
+ * Expands one font row of a glyph, scaled across but not down (send it "scale" times)
+ * Param "row": Font row, 0 to Height - 1
+ * Param "out": Advance * scale big endian RGB565 pixels
+ */
+void Font_ExpandRow(const Font_t *font, uint8_t ch, uint16_t row, uint8_t scale, uint16_t color, uint16_t bkColor, uint8_t *out)
+{
+    uint16_t advance = Font_Advance(font, ch);
+    uint8_t bits = font->Rows[GlyphIndex(font, ch) * font->Height + row];
+    uint16_t i, s;
+
+    //Columns past the row byte are the blank gap of a proportional glyph
+    for(i = 0; i < advance; i++, bits <<= 1){
+        uint16_t pixel = (i < 8 && (bits & 0x80)) ? color : bkColor;
+        for(s = 0; s < scale; s++){
+            *out++ = pixel >> 8;
+            *out++ = pixel & 0xFF;
+        }
+    }
+}
+
+/*
+ * Looks a glyph up in the cache, expanding it into the least recently used entry on a miss
+ * Param "glyph": Returns the size and pixels of the glyph
+ * Returns: false for scaled glyphs, they are not cached, draw them with Font_ExpandRow
+ */
+bool Font_GetGlyph(const Font_t *font, uint8_t ch, uint8_t scale, uint16_t color, uint16_t bkColor, FontGlyph_t *glyph)
+{
+    glyph->Width = Font_Advance(font, ch) * scale;
+    glyph->Height = font->Height * scale;
+    glyph->Bytes = 0;
+    if(scale != 1 || (uint32_t)glyph->Width * glyph->Height * 2 > FONT_CACHE_BYTES){
+        return false;
+    }
+
+    //Hit, or remember the oldest entry in case it is a miss
+    FontCacheEntry_t *oldest = &FontCache[0];
+    uint16_t i;
+    FontUses++;
+    for(i = 0; i < FONT_CACHE_GLYPHS; i++){
+        FontCacheEntry_t *entry = &FontCache[i];
+        if(entry->Font == font && entry->Char == ch &&
+           entry->Color == color && entry->bkColor == bkColor){
+            entry->LastUse = FontUses;
+            glyph->Bytes = entry->Bytes;
+            FontHits++;
+            return true;
+        }
+        if(entry->Font == 0 || (oldest->Font != 0 && entry->LastUse < oldest->LastUse)){
+            oldest = entry;
+        }
+    }
+
+    //Miss, expand it row by row into the entry
+    FontMisses++;
+    uint16_t row;
+    for(row = 0; row < font->Height; row++){
+        Font_ExpandRow(font, ch, row, 1, color, bkColor, &oldest->Bytes[row * glyph->Width * 2]);
+    }
+
+    oldest->Font = font;
+    oldest->Char = ch;
+    oldest->Color = color;
+    oldest->bkColor = bkColor;
+    oldest->Width = glyph->Width;
+    oldest->Height = glyph->Height;
+    oldest->LastUse = FontUses;
+    glyph->Bytes = oldest->Bytes;
+    return true;
+}
+
+/*
+ * Empties the cache
+ */
+void Font_ClearCache()
+{
+    uint16_t i;
+    for(i = 0; i < FONT_CACHE_GLYPHS; i++){
+        FontCache[i].Font = 0;
+    }
+}
+
+/*
+ * Returns: Cache lookups that found the glyph already expanded / that had to expand it
+ */
+uint32_t Font_GetCacheHits()
+{
+    return FontHits;
+}
+
+uint32_t Font_GetCacheMisses()
+{
+    return FontMisses;
+}
+
+/*********************************************** Public Functions *********************************************************************/
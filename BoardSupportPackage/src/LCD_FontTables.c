@@ -0,0 +1,226 @@
+/*
+ * LCD_FontTables.c
+ *
+ * Generated by tools/fontgen.py from AsciiLib.c (ASCII_8X16_System), do not edit
+ *  - Rows are one byte per glyph row, the most significant bit is the leftmost pixel
+ */
+
+#include <stdint.h>
+#include "LCD_Font.h"
+
+/*********************************************** Glyph Tables *************************************************************************/
+
+static const uint8_t System8x16Rows[95 * 16] = {
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,    //space
+    0x00,0x00,0x00,0x18,0x3C,0x3C,0x3C,0x18,0x18,0x00,0x18,0x18,0x00,0x00,0x00,0x00,    //!
+    0x00,0x00,0x00,0x66,0x66,0x66,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,    //"
+    0x00,0x00,0x00,0x36,0x36,0x7F,0x36,0x36,0x36,0x7F,0x36,0x36,0x00,0x00,0x00,0x00,    //#
+    0x00,0x18,0x18,0x3C,0x66,0x60,0x30,0x18,0x0C,0x06,0x66,0x3C,0x18,0x18,0x00,0x00,    //$
+    0x00,0x00,0x70,0xD8,0xDA,0x76,0x0C,0x18,0x30,0x6E,0x5B,0x1B,0x0E,0x00,0x00,0x00,    //%
+    0x00,0x00,0x00,0x38,0x6C,0x6C,0x38,0x60,0x6F,0x66,0x66,0x3B,0x00,0x00,0x00,0x00,    //&
+    0x00,0x00,0x00,0x18,0x18,0x18,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,    //'
+    0x00,0x00,0x00,0x0C,0x18,0x18,0x30,0x30,0x30,0x30,0x30,0x18,0x18,0x0C,0x00,0x00,    //(
+    0x00,0x00,0x00,0x30,0x18,0x18,0x0C,0x0C,0x0C,0x0C,0x0C,0x18,0x18,0x30,0x00,0x00,    //)
+    0x00,0x00,0x00,0x00,0x00,0x36,0x1C,0x7F,0x1C,0x36,0x00,0x00,0x00,0x00,0x00,0x00,    //star
+    0x00,0x00,0x00,0x00,0x00,0x18,0x18,0x7E,0x18,0x18,0x00,0x00,0x00,0x00,0x00,0x00,    //+
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x1C,0x1C,0x0C,0x18,0x00,0x00,    //,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x7E,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,    //-
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x1C,0x1C,0x00,0x00,0x00,0x00,    //.
+    0x00,0x00,0x00,0x06,0x06,0x0C,0x0C,0x18,0x18,0x30,0x30,0x60,0x60,0x00,0x00,0x00,    ///
+    0x00,0x00,0x00,0x1E,0x33,0x37,0x37,0x33,0x3B,0x3B,0x33,0x1E,0x00,0x00,0x00,0x00,    //0
+    0x00,0x00,0x00,0x0C,0x1C,0x7C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x00,0x00,0x00,0x00,    //1
+    0x00,0x00,0x00,0x3C,0x66,0x66,0x06,0x0C,0x18,0x30,0x60,0x7E,0x00,0x00,0x00,0x00,    //2
+    0x00,0x00,0x00,0x3C,0x66,0x66,0x06,0x1C,0x06,0x66,0x66,0x3C,0x00,0x00,0x00,0x00,    //3
+    0x00,0x00,0x00,0x30,0x30,0x36,0x36,0x36,0x66,0x7F,0x06,0x06,0x00,0x00,0x00,0x00,    //4
+    0x00,0x00,0x00,0x7E,0x60,0x60,0x60,0x7C,0x06,0x06,0x0C,0x78,0x00,0x00,0x00,0x00,    //5
+    0x00,0x00,0x00,0x1C,0x18,0x30,0x7C,0x66,0x66,0x66,0x66,0x3C,0x00,0x00,0x00,0x00,    //6
+    0x00,0x00,0x00,0x7E,0x06,0x0C,0x0C,0x18,0x18,0x30,0x30,0x30,0x00,0x00,0x00,0x00,    //7
+    0x00,0x00,0x00,0x3C,0x66,0x66,0x76,0x3C,0x6E,0x66,0x66,0x3C,0x00,0x00,0x00,0x00,    //8
+    0x00,0x00,0x00,0x3C,0x66,0x66,0x66,0x66,0x3E,0x0C,0x18,0x38,0x00,0x00,0x00,0x00,    //9
+    0x00,0x00,0x00,0x00,0x00,0x1C,0x1C,0x00,0x00,0x00,0x1C,0x1C,0x00,0x00,0x00,0x00,    //:
+    0x00,0x00,0x00,0x00,0x00,0x1C,0x1C,0x00,0x00,0x00,0x1C,0x1C,0x0C,0x18,0x00,0x00,    //;
+    0x00,0x00,0x00,0x06,0x0C,0x18,0x30,0x60,0x30,0x18,0x0C,0x06,0x00,0x00,0x00,0x00,    //<
+    0x00,0x00,0x00,0x00,0x00,0x00,0x7E,0x00,0x7E,0x00,0x00,0x00,0x00,0x00,0x00,0x00,    //=
+    0x00,0x00,0x00,0x60,0x30,0x18,0x0C,0x06,0x0C,0x18,0x30,0x60,0x00,0x00,0x00,0x00,    //>
+    0x00,0x00,0x00,0x3C,0x66,0x66,0x0C,0x18,0x18,0x00,0x18,0x18,0x00,0x00,0x00,0x00,    //?
+    0x00,0x00,0x00,0x7E,0xC3,0xC3,0xCF,0xDB,0xDB,0xCF,0xC0,0x7F,0x00,0x00,0x00,0x00,    //@
+    0x00,0x00,0x00,0x18,0x3C,0x66,0x66,0x66,0x7E,0x66,0x66,0x66,0x00,0x00,0x00,0x00,    //A
+    0x00,0x00,0x00,0x7C,0x66,0x66,0x66,0x7C,0x66,0x66,0x66,0x7C,0x00,0x00,0x00,0x00,    //B
+    0x00,0x00,0x00,0x3C,0x66,0x66,0x60,0x60,0x60,0x66,0x66,0x3C,0x00,0x00,0x00,0x00,    //C
+    0x00,0x00,0x00,0x78,0x6C,0x66,0x66,0x66,0x66,0x66,0x6C,0x78,0x00,0x00,0x00,0x00,    //D
+    0x00,0x00,0x00,0x7E,0x60,0x60,0x60,0x7C,0x60,0x60,0x60,0x7E,0x00,0x00,0x00,0x00,    //E
+    0x00,0x00,0x00,0x7E,0x60,0x60,0x60,0x7C,0x60,0x60,0x60,0x60,0x00,0x00,0x00,0x00,    //F
+    0x00,0x00,0x00,0x3C,0x66,0x66,0x60,0x60,0x6E,0x66,0x66,0x3E,0x00,0x00,0x00,0x00,    //G
+    0x00,0x00,0x00,0x66,0x66,0x66,0x66,0x7E,0x66,0x66,0x66,0x66,0x00,0x00,0x00,0x00,    //H
+    0x00,0x00,0x00,0x3C,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x3C,0x00,0x00,0x00,0x00,    //I
+    0x00,0x00,0x00,0x06,0x06,0x06,0x06,0x06,0x06,0x66,0x66,0x3C,0x00,0x00,0x00,0x00,    //J
+    0x00,0x00,0x00,0x66,0x66,0x6C,0x6C,0x78,0x6C,0x6C,0x66,0x66,0x00,0x00,0x00,0x00,    //K
+    0x00,0x00,0x00,0x60,0x60,0x60,0x60,0x60,0x60,0x60,0x60,0x7E,0x00,0x00,0x00,0x00,    //L
+    0x00,0x00,0x00,0x63,0x63,0x77,0x6B,0x6B,0x6B,0x63,0x63,0x63,0x00,0x00,0x00,0x00,    //M
+    0x00,0x00,0x00,0x63,0x63,0x73,0x7B,0x6F,0x67,0x63,0x63,0x63,0x00,0x00,0x00,0x00,    //N
+    0x00,0x00,0x00,0x3C,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x3C,0x00,0x00,0x00,0x00,    //O
+    0x00,0x00,0x00,0x7C,0x66,0x66,0x66,0x7C,0x60,0x60,0x60,0x60,0x00,0x00,0x00,0x00,    //P
+    0x00,0x00,0x00,0x3C,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x3C,0x0C,0x06,0x00,0x00,    //Q
+    0x00,0x00,0x00,0x7C,0x66,0x66,0x66,0x7C,0x6C,0x66,0x66,0x66,0x00,0x00,0x00,0x00,    //R
+    0x00,0x00,0x00,0x3C,0x66,0x60,0x30,0x18,0x0C,0x06,0x66,0x3C,0x00,0x00,0x00,0x00,    //S
+    0x00,0x00,0x00,0x7E,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x00,0x00,0x00,0x00,    //T
+    0x00,0x00,0x00,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x3C,0x00,0x00,0x00,0x00,    //U
+    0x00,0x00,0x00,0x66,0x66,0x66,0x66,0x66,0x66,0x66,0x3C,0x18,0x00,0x00,0x00,0x00,    //V
+    0x00,0x00,0x00,0x63,0x63,0x63,0x6B,0x6B,0x6B,0x36,0x36,0x36,0x00,0x00,0x00,0x00,    //W
+    0x00,0x00,0x00,0x66,0x66,0x34,0x18,0x18,0x2C,0x66,0x66,0x66,0x00,0x00,0x00,0x00,    //X
+    0x00,0x00,0x00,0x66,0x66,0x66,0x66,0x3C,0x18,0x18,0x18,0x18,0x00,0x00,0x00,0x00,    //Y
+    0x00,0x00,0x00,0x7E,0x06,0x06,0x0C,0x18,0x30,0x60,0x60,0x7E,0x00,0x00,0x00,0x00,    //Z
+    0x00,0x00,0x00,0x3C,0x30,0x30,0x30,0x30,0x30,0x30,0x30,0x30,0x30,0x30,0x3C,0x00,    //[
+    0x00,0x00,0x00,0x60,0x60,0x30,0x30,0x18,0x18,0x0C,0x0C,0x06,0x06,0x00,0x00,0x00,    //backslash
+    0x00,0x00,0x00,0x3C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x3C,0x00,    //]
+    0x00,0x18,0x3C,0x66,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,    //^
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFF,0x00,    //_
+    0x00,0x00,0x00,0x18,0x18,0x18,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,    //`
+    0x00,0x00,0x00,0x00,0x00,0x3C,0x06,0x06,0x3E,0x66,0x66,0x3E,0x00,0x00,0x00,0x00,    //a
+    0x00,0x00,0x00,0x60,0x60,0x7C,0x66,0x66,0x66,0x66,0x66,0x7C,0x00,0x00,0x00,0x00,    //b
+    0x00,0x00,0x00,0x00,0x00,0x3C,0x66,0x60,0x60,0x60,0x66,0x3C,0x00,0x00,0x00,0x00,    //c
+    0x00,0x00,0x00,0x06,0x06,0x3E,0x66,0x66,0x66,0x66,0x66,0x3E,0x00,0x00,0x00,0x00,    //d
+    0x00,0x00,0x00,0x00,0x00,0x3C,0x66,0x66,0x7E,0x60,0x60,0x3C,0x00,0x00,0x00,0x00,    //e
+    0x00,0x00,0x00,0x1E,0x30,0x30,0x30,0x7E,0x30,0x30,0x30,0x30,0x00,0x00,0x00,0x00,    //f
+    0x00,0x00,0x00,0x00,0x00,0x3E,0x66,0x66,0x66,0x66,0x66,0x3E,0x06,0x06,0x7C,0x00,    //g
+    0x00,0x00,0x00,0x60,0x60,0x7C,0x66,0x66,0x66,0x66,0x66,0x66,0x00,0x00,0x00,0x00,    //h
+    0x00,0x00,0x18,0x18,0x00,0x78,0x18,0x18,0x18,0x18,0x18,0x7E,0x00,0x00,0x00,0x00,    //i
+    0x00,0x00,0x0C,0x0C,0x00,0x3C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x78,0x00,    //j
+    0x00,0x00,0x00,0x60,0x60,0x66,0x66,0x6C,0x78,0x6C,0x66,0x66,0x00,0x00,0x00,0x00,    //k
+    0x00,0x00,0x00,0x78,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x7E,0x00,0x00,0x00,0x00,    //l
+    0x00,0x00,0x00,0x00,0x00,0x7E,0x6B,0x6B,0x6B,0x6B,0x6B,0x63,0x00,0x00,0x00,0x00,    //m
+    0x00,0x00,0x00,0x00,0x00,0x7C,0x66,0x66,0x66,0x66,0x66,0x66,0x00,0x00,0x00,0x00,    //n
+    0x00,0x00,0x00,0x00,0x00,0x3C,0x66,0x66,0x66,0x66,0x66,0x3C,0x00,0x00,0x00,0x00,    //o
+    0x00,0x00,0x00,0x00,0x00,0x7C,0x66,0x66,0x66,0x66,0x66,0x7C,0x60,0x60,0x60,0x00,    //p
+    0x00,0x00,0x00,0x00,0x00,0x3E,0x66,0x66,0x66,0x66,0x66,0x3E,0x06,0x06,0x06,0x00,    //q
+    0x00,0x00,0x00,0x00,0x00,0x66,0x6E,0x70,0x60,0x60,0x60,0x60,0x00,0x00,0x00,0x00,    //r
+    0x00,0x00,0x00,0x00,0x00,0x3E,0x60,0x60,0x3C,0x06,0x06,0x7C,0x00,0x00,0x00,0x00,    //s
+    0x00,0x00,0x00,0x30,0x30,0x7E,0x30,0x30,0x30,0x30,0x30,0x1E,0x00,0x00,0x00,0x00,    //t
+    0x00,0x00,0x00,0x00,0x00,0x66,0x66,0x66,0x66,0x66,0x66,0x3E,0x00,0x00,0x00,0x00,    //u
+    0x00,0x00,0x00,0x00,0x00,0x66,0x66,0x66,0x66,0x66,0x3C,0x18,0x00,0x00,0x00,0x00,    //v
+    0x00,0x00,0x00,0x00,0x00,0x63,0x6B,0x6B,0x6B,0x6B,0x36,0x36,0x00,0x00,0x00,0x00,    //w
+    0x00,0x00,0x00,0x00,0x00,0x66,0x66,0x3C,0x18,0x3C,0x66,0x66,0x00,0x00,0x00,0x00,    //x
+    0x00,0x00,0x00,0x00,0x00,0x66,0x66,0x66,0x66,0x66,0x66,0x3C,0x0C,0x18,0xF0,0x00,    //y
+    0x00,0x00,0x00,0x00,0x00,0x7E,0x06,0x0C,0x18,0x30,0x60,0x7E,0x00,0x00,0x00,0x00,    //z
+    0x00,0x00,0x00,0x0C,0x18,0x18,0x18,0x30,0x60,0x30,0x18,0x18,0x18,0x0C,0x00,0x00,    //{
+    0x00,0x00,0x00,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x00,    //|
+    0x00,0x00,0x00,0x30,0x18,0x18,0x18,0x0C,0x06,0x0C,0x18,0x18,0x18,0x30,0x00,0x00,    //}
+    0x00,0x00,0x00,0x71,0xDB,0x8E,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,    //~
+};
+
+static const uint8_t ProportionalRows[95 * 16] = {
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,    //space
+    0x00,0x00,0x00,0x60,0xF0,0xF0,0xF0,0x60,0x60,0x00,0x60,0x60,0x00,0x00,0x00,0x00,    //!
+    0x00,0x00,0x00,0xCC,0xCC,0xCC,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,    //"
+    0x00,0x00,0x00,0x6C,0x6C,0xFE,0x6C,0x6C,0x6C,0xFE,0x6C,0x6C,0x00,0x00,0x00,0x00,    //#
+    0x00,0x30,0x30,0x78,0xCC,0xC0,0x60,0x30,0x18,0x0C,0xCC,0x78,0x30,0x30,0x00,0x00,    //$
+    0x00,0x00,0x70,0xD8,0xDA,0x76,0x0C,0x18,0x30,0x6E,0x5B,0x1B,0x0E,0x00,0x00,0x00,    //%
+    0x00,0x00,0x00,0x70,0xD8,0xD8,0x70,0xC0,0xDE,0xCC,0xCC,0x76,0x00,0x00,0x00,0x00,    //&
+    0x00,0x00,0x00,0xC0,0xC0,0xC0,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,    //'
+    0x00,0x00,0x00,0x30,0x60,0x60,0xC0,0xC0,0xC0,0xC0,0xC0,0x60,0x60,0x30,0x00,0x00,    //(
+    0x00,0x00,0x00,0xC0,0x60,0x60,0x30,0x30,0x30,0x30,0x30,0x60,0x60,0xC0,0x00,0x00,    //)
+    0x00,0x00,0x00,0x00,0x00,0x6C,0x38,0xFE,0x38,0x6C,0x00,0x00,0x00,0x00,0x00,0x00,    //star
+    0x00,0x00,0x00,0x00,0x00,0x30,0x30,0xFC,0x30,0x30,0x00,0x00,0x00,0x00,0x00,0x00,    //+
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xE0,0xE0,0x60,0xC0,0x00,0x00,    //,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,    //-
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xE0,0xE0,0x00,0x00,0x00,0x00,    //.
+    0x00,0x00,0x00,0x0C,0x0C,0x18,0x18,0x30,0x30,0x60,0x60,0xC0,0xC0,0x00,0x00,0x00,    ///
+    0x00,0x00,0x00,0x78,0xCC,0xDC,0xDC,0xCC,0xEC,0xEC,0xCC,0x78,0x00,0x00,0x00,0x00,    //0
+    0x00,0x00,0x00,0x18,0x38,0xF8,0x18,0x18,0x18,0x18,0x18,0x18,0x00,0x00,0x00,0x00,    //1
+    0x00,0x00,0x00,0x78,0xCC,0xCC,0x0C,0x18,0x30,0x60,0xC0,0xFC,0x00,0x00,0x00,0x00,    //2
+    0x00,0x00,0x00,0x78,0xCC,0xCC,0x0C,0x38,0x0C,0xCC,0xCC,0x78,0x00,0x00,0x00,0x00,    //3
+    0x00,0x00,0x00,0x60,0x60,0x6C,0x6C,0x6C,0xCC,0xFE,0x0C,0x0C,0x00,0x00,0x00,0x00,    //4
+    0x00,0x00,0x00,0xFC,0xC0,0xC0,0xC0,0xF8,0x0C,0x0C,0x18,0xF0,0x00,0x00,0x00,0x00,    //5
+    0x00,0x00,0x00,0x38,0x30,0x60,0xF8,0xCC,0xCC,0xCC,0xCC,0x78,0x00,0x00,0x00,0x00,    //6
+    0x00,0x00,0x00,0xFC,0x0C,0x18,0x18,0x30,0x30,0x60,0x60,0x60,0x00,0x00,0x00,0x00,    //7
+    0x00,0x00,0x00,0x78,0xCC,0xCC,0xEC,0x78,0xDC,0xCC,0xCC,0x78,0x00,0x00,0x00,0x00,    //8
+    0x00,0x00,0x00,0x78,0xCC,0xCC,0xCC,0xCC,0x7C,0x18,0x30,0x70,0x00,0x00,0x00,0x00,    //9
+    0x00,0x00,0x00,0x00,0x00,0xE0,0xE0,0x00,0x00,0x00,0xE0,0xE0,0x00,0x00,0x00,0x00,    //:
+    0x00,0x00,0x00,0x00,0x00,0xE0,0xE0,0x00,0x00,0x00,0xE0,0xE0,0x60,0xC0,0x00,0x00,    //;
+    0x00,0x00,0x00,0x0C,0x18,0x30,0x60,0xC0,0x60,0x30,0x18,0x0C,0x00,0x00,0x00,0x00,    //<
+    0x00,0x00,0x00,0x00,0x00,0x00,0xFC,0x00,0xFC,0x00,0x00,0x00,0x00,0x00,0x00,0x00,    //=
+    0x00,0x00,0x00,0xC0,0x60,0x30,0x18,0x0C,0x18,0x30,0x60,0xC0,0x00,0x00,0x00,0x00,    //>
+    0x00,0x00,0x00,0x78,0xCC,0xCC,0x18,0x30,0x30,0x00,0x30,0x30,0x00,0x00,0x00,0x00,    //?
+    0x00,0x00,0x00,0x7E,0xC3,0xC3,0xCF,0xDB,0xDB,0xCF,0xC0,0x7F,0x00,0x00,0x00,0x00,    //@
+    0x00,0x00,0x00,0x30,0x78,0xCC,0xCC,0xCC,0xFC,0xCC,0xCC,0xCC,0x00,0x00,0x00,0x00,    //A
+    0x00,0x00,0x00,0xF8,0xCC,0xCC,0xCC,0xF8,0xCC,0xCC,0xCC,0xF8,0x00,0x00,0x00,0x00,    //B
+    0x00,0x00,0x00,0x78,0xCC,0xCC,0xC0,0xC0,0xC0,0xCC,0xCC,0x78,0x00,0x00,0x00,0x00,    //C
+    0x00,0x00,0x00,0xF0,0xD8,0xCC,0xCC,0xCC,0xCC,0xCC,0xD8,0xF0,0x00,0x00,0x00,0x00,    //D
+    0x00,0x00,0x00,0xFC,0xC0,0xC0,0xC0,0xF8,0xC0,0xC0,0xC0,0xFC,0x00,0x00,0x00,0x00,    //E
+    0x00,0x00,0x00,0xFC,0xC0,0xC0,0xC0,0xF8,0xC0,0xC0,0xC0,0xC0,0x00,0x00,0x00,0x00,    //F
+    0x00,0x00,0x00,0x78,0xCC,0xCC,0xC0,0xC0,0xDC,0xCC,0xCC,0x7C,0x00,0x00,0x00,0x00,    //G
+    0x00,0x00,0x00,0xCC,0xCC,0xCC,0xCC,0xFC,0xCC,0xCC,0xCC,0xCC,0x00,0x00,0x00,0x00,    //H
+    0x00,0x00,0x00,0xF0,0x60,0x60,0x60,0x60,0x60,0x60,0x60,0xF0,0x00,0x00,0x00,0x00,    //I
+    0x00,0x00,0x00,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0xCC,0xCC,0x78,0x00,0x00,0x00,0x00,    //J
+    0x00,0x00,0x00,0xCC,0xCC,0xD8,0xD8,0xF0,0xD8,0xD8,0xCC,0xCC,0x00,0x00,0x00,0x00,    //K
+    0x00,0x00,0x00,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xFC,0x00,0x00,0x00,0x00,    //L
+    0x00,0x00,0x00,0xC6,0xC6,0xEE,0xD6,0xD6,0xD6,0xC6,0xC6,0xC6,0x00,0x00,0x00,0x00,    //M
+    0x00,0x00,0x00,0xC6,0xC6,0xE6,0xF6,0xDE,0xCE,0xC6,0xC6,0xC6,0x00,0x00,0x00,0x00,    //N
+    0x00,0x00,0x00,0x78,0xCC,0xCC,0xCC,0xCC,0xCC,0xCC,0xCC,0x78,0x00,0x00,0x00,0x00,    //O
+    0x00,0x00,0x00,0xF8,0xCC,0xCC,0xCC,0xF8,0xC0,0xC0,0xC0,0xC0,0x00,0x00,0x00,0x00,    //P
+    0x00,0x00,0x00,0x78,0xCC,0xCC,0xCC,0xCC,0xCC,0xCC,0xCC,0x78,0x18,0x0C,0x00,0x00,    //Q
+    0x00,0x00,0x00,0xF8,0xCC,0xCC,0xCC,0xF8,0xD8,0xCC,0xCC,0xCC,0x00,0x00,0x00,0x00,    //R
+    0x00,0x00,0x00,0x78,0xCC,0xC0,0x60,0x30,0x18,0x0C,0xCC,0x78,0x00,0x00,0x00,0x00,    //S
+    0x00,0x00,0x00,0xFC,0x30,0x30,0x30,0x30,0x30,0x30,0x30,0x30,0x00,0x00,0x00,0x00,    //T
+    0x00,0x00,0x00,0xCC,0xCC,0xCC,0xCC,0xCC,0xCC,0xCC,0xCC,0x78,0x00,0x00,0x00,0x00,    //U
+    0x00,0x00,0x00,0xCC,0xCC,0xCC,0xCC,0xCC,0xCC,0xCC,0x78,0x30,0x00,0x00,0x00,0x00,    //V
+    0x00,0x00,0x00,0xC6,0xC6,0xC6,0xD6,0xD6,0xD6,0x6C,0x6C,0x6C,0x00,0x00,0x00,0x00,    //W
+    0x00,0x00,0x00,0xCC,0xCC,0x68,0x30,0x30,0x58,0xCC,0xCC,0xCC,0x00,0x00,0x00,0x00,    //X
+    0x00,0x00,0x00,0xCC,0xCC,0xCC,0xCC,0x78,0x30,0x30,0x30,0x30,0x00,0x00,0x00,0x00,    //Y
+    0x00,0x00,0x00,0xFC,0x0C,0x0C,0x18,0x30,0x60,0xC0,0xC0,0xFC,0x00,0x00,0x00,0x00,    //Z
+    0x00,0x00,0x00,0xF0,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xF0,0x00,    //[
+    0x00,0x00,0x00,0xC0,0xC0,0x60,0x60,0x30,0x30,0x18,0x18,0x0C,0x0C,0x00,0x00,0x00,    //backslash
+    0x00,0x00,0x00,0xF0,0x30,0x30,0x30,0x30,0x30,0x30,0x30,0x30,0x30,0x30,0xF0,0x00,    //]
+    0x00,0x30,0x78,0xCC,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,    //^
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFF,0x00,    //_
+    0x00,0x00,0x00,0xC0,0xC0,0xC0,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,    //`
+    0x00,0x00,0x00,0x00,0x00,0x78,0x0C,0x0C,0x7C,0xCC,0xCC,0x7C,0x00,0x00,0x00,0x00,    //a
+    0x00,0x00,0x00,0xC0,0xC0,0xF8,0xCC,0xCC,0xCC,0xCC,0xCC,0xF8,0x00,0x00,0x00,0x00,    //b
+    0x00,0x00,0x00,0x00,0x00,0x78,0xCC,0xC0,0xC0,0xC0,0xCC,0x78,0x00,0x00,0x00,0x00,    //c
+    0x00,0x00,0x00,0x0C,0x0C,0x7C,0xCC,0xCC,0xCC,0xCC,0xCC,0x7C,0x00,0x00,0x00,0x00,    //d
+    0x00,0x00,0x00,0x00,0x00,0x78,0xCC,0xCC,0xFC,0xC0,0xC0,0x78,0x00,0x00,0x00,0x00,    //e
+    0x00,0x00,0x00,0x3C,0x60,0x60,0x60,0xFC,0x60,0x60,0x60,0x60,0x00,0x00,0x00,0x00,    //f
+    0x00,0x00,0x00,0x00,0x00,0x7C,0xCC,0xCC,0xCC,0xCC,0xCC,0x7C,0x0C,0x0C,0xF8,0x00,    //g
+    0x00,0x00,0x00,0xC0,0xC0,0xF8,0xCC,0xCC,0xCC,0xCC,0xCC,0xCC,0x00,0x00,0x00,0x00,    //h
+    0x00,0x00,0x30,0x30,0x00,0xF0,0x30,0x30,0x30,0x30,0x30,0xFC,0x00,0x00,0x00,0x00,    //i
+    0x00,0x00,0x18,0x18,0x00,0x78,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18,0xF0,0x00,    //j
+    0x00,0x00,0x00,0xC0,0xC0,0xCC,0xCC,0xD8,0xF0,0xD8,0xCC,0xCC,0x00,0x00,0x00,0x00,    //k
+    0x00,0x00,0x00,0xF0,0x30,0x30,0x30,0x30,0x30,0x30,0x30,0xFC,0x00,0x00,0x00,0x00,    //l
+    0x00,0x00,0x00,0x00,0x00,0xFC,0xD6,0xD6,0xD6,0xD6,0xD6,0xC6,0x00,0x00,0x00,0x00,    //m
+    0x00,0x00,0x00,0x00,0x00,0xF8,0xCC,0xCC,0xCC,0xCC,0xCC,0xCC,0x00,0x00,0x00,0x00,    //n
+    0x00,0x00,0x00,0x00,0x00,0x78,0xCC,0xCC,0xCC,0xCC,0xCC,0x78,0x00,0x00,0x00,0x00,    //o
+    0x00,0x00,0x00,0x00,0x00,0xF8,0xCC,0xCC,0xCC,0xCC,0xCC,0xF8,0xC0,0xC0,0xC0,0x00,    //p
+    0x00,0x00,0x00,0x00,0x00,0x7C,0xCC,0xCC,0xCC,0xCC,0xCC,0x7C,0x0C,0x0C,0x0C,0x00,    //q
+    0x00,0x00,0x00,0x00,0x00,0xCC,0xDC,0xE0,0xC0,0xC0,0xC0,0xC0,0x00,0x00,0x00,0x00,    //r
+    0x00,0x00,0x00,0x00,0x00,0x7C,0xC0,0xC0,0x78,0x0C,0x0C,0xF8,0x00,0x00,0x00,0x00,    //s
+    0x00,0x00,0x00,0x60,0x60,0xFC,0x60,0x60,0x60,0x60,0x60,0x3C,0x00,0x00,0x00,0x00,    //t
+    0x00,0x00,0x00,0x00,0x00,0xCC,0xCC,0xCC,0xCC,0xCC,0xCC,0x7C,0x00,0x00,0x00,0x00,    //u
+    0x00,0x00,0x00,0x00,0x00,0xCC,0xCC,0xCC,0xCC,0xCC,0x78,0x30,0x00,0x00,0x00,0x00,    //v
+    0x00,0x00,0x00,0x00,0x00,0xC6,0xD6,0xD6,0xD6,0xD6,0x6C,0x6C,0x00,0x00,0x00,0x00,    //w
+    0x00,0x00,0x00,0x00,0x00,0xCC,0xCC,0x78,0x30,0x78,0xCC,0xCC,0x00,0x00,0x00,0x00,    //x
+    0x00,0x00,0x00,0x00,0x00,0x66,0x66,0x66,0x66,0x66,0x66,0x3C,0x0C,0x18,0xF0,0x00,    //y
+    0x00,0x00,0x00,0x00,0x00,0xFC,0x0C,0x18,0x30,0x60,0xC0,0xFC,0x00,0x00,0x00,0x00,    //z
+    0x00,0x00,0x00,0x18,0x30,0x30,0x30,0x60,0xC0,0x60,0x30,0x30,0x30,0x18,0x00,0x00,    //{
+    0x00,0x00,0x00,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0x00,    //|
+    0x00,0x00,0x00,0xC0,0x60,0x60,0x60,0x30,0x18,0x30,0x60,0x60,0x60,0xC0,0x00,0x00,    //}
+    0x00,0x00,0x00,0x71,0xDB,0x8E,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,    //~
+};
+
+static const uint8_t ProportionalWidths[95] = {
+    4, 5, 7, 8, 7, 9, 8, 3, 5, 5, 8, 7, 4, 7, 4, 7,
+    7, 6, 7, 7, 8, 7, 7, 7, 7, 7, 4, 4, 7, 7, 7, 7,
+    9, 7, 7, 7, 7, 7, 7, 7, 7, 5, 7, 7, 7, 8, 8, 7,
+    7, 7, 7, 7, 7, 7, 7, 8, 7, 7, 7, 5, 7, 5, 7, 9,
+    3, 7, 7, 7, 7, 7, 7, 7, 7, 7, 6, 7, 7, 8, 7, 7,
+    7, 7, 7, 7, 7, 7, 7, 8, 7, 8, 7, 6, 3, 6, 9,
+};
+
+/*********************************************** Glyph Tables *************************************************************************/
+
+/*********************************************** Fonts ********************************************************************************/
+
+const Font_t Font_System8x16 = { 32, 126, 8, 16, 0, System8x16Rows };
+
+const Font_t Font_Proportional = { 32, 126, 8, 16, ProportionalWidths, ProportionalRows };
+
+/*********************************************** Fonts ********************************************************************************/
@@ -0,0 +1,190 @@
+/*
+ * LCD_Perf.c
+ *
+ * Cost counters of the LCD drawing primitives
+ *  - Every call of an instrumented primitive records its pixels, register (index)
+ *    writes, bus bytes and cycles, a primitive called by another one is counted
+ *    in the outer one (LCD_Clear is not also a rectangle)
+ *  - Cycles come from the DWT counter and are wall time, other threads that run
+ *    while a call blocks on the uDMA are in there too. Under LCD_EMULATOR they are
+ *    what the bytes take on the bus at 12 MHz
+ *  - A histogram of the cycles per call shows the outliers an average hides
+ *  - Read at runtime with LCD_PerfGetStats or stream with LCD_PerfPrint
+ *  - Build with LCD_PERF=0 to compile the counting out of LCD_empty.c
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "LCD_Perf.h"
+#ifndef LCD_EMULATOR
+#include "msp.h"
+#include "BackChannelUart.h"
+#endif
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+LCD_PerfCounters_t LCD_PerfCurrent;
+
+static LCD_PerfStats_t Stats[LCD_PERF_PRIMITIVES];
+
+static const char *const Names[LCD_PERF_PRIMITIVES] = {
+    "rectangle", "clear", "point", "text", "font_text", "blit", "line", "circle"
+};
+
+/* Outermost call in progress, calls are serialized by the LCD bus lock */
+static uint16_t Depth = 0;
+static lcdPerfPrimitive_t Active;
+static uint32_t CallStart;
+
+/* Measuring window for the load */
+static uint32_t WindowStart;
+
+#ifndef LCD_EMULATOR
+static bool CounterStarted = false;
+#endif
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*
+ * Returns: Cycle counter, started on first use
+ */
+static uint32_t Now()
+{
+#ifndef LCD_EMULATOR
+    if(!CounterStarted){
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+        CounterStarted = true;
+    }
+    return DWT->CYCCNT;
+#else
+    return 0;
+#endif
+}
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Starts timing a call, nested calls only count towards the outer one
+ * Param "primitive": Primitive being called
+ */
+void LCD_PerfBegin(lcdPerfPrimitive_t primitive)
+{
+    if(Depth++ > 0){
+        return;
+    }
+
+    Active = primitive;
+    LCD_PerfCurrent.Pixels = 0;
+    LCD_PerfCurrent.RegWrites = 0;
+    LCD_PerfCurrent.Bytes = 0;
+    CallStart = Now();
+}
+
+/*
+ * Ends the call started by the matching LCD_PerfBegin and records it
+ */
+void LCD_PerfEnd()
+{
+    if(Depth == 0 || --Depth > 0){
+        return;
+    }
+
+#ifndef LCD_EMULATOR
+    uint32_t cycles = Now() - CallStart;
+#else
+    uint32_t cycles = LCD_PerfCurrent.Bytes * LCD_PERF_EMU_CYCLES_PER_BYTE;
+#endif
+
+    LCD_PerfStats_t *stats = &Stats[Active];
+    stats->Calls++;
+    stats->Pixels += LCD_PerfCurrent.Pixels;
+    stats->RegWrites += LCD_PerfCurrent.RegWrites;
+    stats->Bytes += LCD_PerfCurrent.Bytes;
+    stats->Cycles += cycles;
+    if(cycles > stats->MaxCycles){
+        stats->MaxCycles = cycles;
+    }
+    stats->Histogram[LCD_PerfBucket(cycles)]++;
+}
+
+/*
+ * Clears every total and starts a new measuring window
+ */
+void LCD_PerfReset()
+{
+    memset(Stats, 0, sizeof(Stats));
+    WindowStart = Now();
+}
+
+/*
+ * Returns: Totals of a primitive since the last reset
+ */
+const LCD_PerfStats_t *LCD_PerfGetStats(lcdPerfPrimitive_t primitive)
+{
+    return &Stats[primitive];
+}
+
+/*
+ * Returns: Short name of a primitive ("rectangle", "text", ...)
+ */
+const char *LCD_PerfName(lcdPerfPrimitive_t primitive)
+{
+    return Names[primitive];
+}
+
+/*
+ * Returns: Histogram bucket a call of this many cycles falls in
+ */
+uint16_t LCD_PerfBucket(uint32_t cycles)
+{
+    uint16_t bucket = 0;
+    cycles >>= LCD_PERF_BUCKET_SHIFT;
+    while(cycles != 0 && bucket < LCD_PERF_BUCKETS - 1){
+        cycles >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+/*
+ * Returns: Share of the time since the last reset spent in the primitives, in tenths
+ *          of a percent. 0 under LCD_EMULATOR, there is no wall clock to compare with
+ */
+uint32_t LCD_PerfGetLoad()
+{
+#ifndef LCD_EMULATOR
+    uint32_t window = Now() - WindowStart;
+    uint64_t busy = 0;
+    uint16_t i;
+    for(i = 0; i < LCD_PERF_PRIMITIVES; i++){
+        busy += Stats[i].Cycles;
+    }
+    return (window == 0) ? 0 : (uint32_t)((busy * 1000) / window);
+#else
+    return 0;
+#endif
+}
+
+/*
+ * Streams the totals of every primitive that was called and the load over the back channel UART
+ */
+void LCD_PerfPrint()
+{
+#ifndef LCD_EMULATOR
+    uint16_t i;
+    for(i = 0; i < LCD_PERF_PRIMITIVES; i++){
+        if(Stats[i].Calls > 0){
+            BackChannelPrintLcdPerf(Names[i], &Stats[i]);
+        }
+    }
+    BackChannelPrintIntVariable("lcd_load_permille", LCD_PerfGetLoad());
+#endif
+}
+
+/*********************************************** Public Functions *********************************************************************/
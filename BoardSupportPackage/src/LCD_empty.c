@@ -6,16 +6,96 @@
  */
 
 #include "LCD_empty.h"
+#include "AsciiLib.h"
+#include "DMAPlan.h"
+#include "TouchFilter.h"
+#include "LCD_Perf.h"
+#ifndef LCD_EMULATOR
 #include "msp.h"
 #include "driverlib.h"
-#include "AsciiLib.h"
+#include "DMAControl.h"
+#include "G8RTOS.h"
+#include "G8RTOS_SVC.h"
+#include "SPIBus.h"
+#endif
+
+/************************************  Defines  *****************************************************/
+
+/*
+ * SPI clock of the LCD bus
+ *  - eUSCI only runs from SMCLK or ACLK, so the bus tops out at the 12 MHz SMCLK (HFXT/4)
+ *  - Going faster needs SMCLK at HFXT/2, set in ClockSys before BackChannelUart, I2C and
+ *    the joystick trigger are set up, and their 12 MHz settings moved along with it
+ */
+#ifndef LCD_SPI_CLOCK
+#define LCD_SPI_CLOCK           12000000
+#endif
+
+#if LCD_SPI_CLOCK > 12000000
+#error "LCD_SPI_CLOCK above the 12 MHz SMCLK, the other SMCLK drivers do not follow a faster clock yet"
+#endif
+
+/* uDMA channel that feeds EUSCI_B3 TX */
+#define LCD_DMA_CHANNEL         6
+
+/* Streams shorter than this are cheaper to push out with the CPU than to set up DMA for */
+#define LCD_DMA_MIN_BYTES       32
+
+/* Fill pattern for colors whose two bytes differ, and bounce buffer for byte swapped blits */
+#define LCD_DMA_BUFFER_BYTES    512
+
+/* Fills go out in slices of this size, a waiting touch read gets the bus in between */
+#define LCD_BUS_SLICE_BYTES     8192
+
+/* Touch controller SPI clock, the XPT2046 is only good up to 2.5 MHz */
+#define TP_SPI_CLOCK            2000000
+
+/* Bus arbitration, the emulator has the bus to itself */
+#ifndef LCD_EMULATOR
+#define LCD_BUS_ACQUIRE()       SPIBus_Acquire(SPIBUS_LCD)
+#define LCD_BUS_RELEASE()       SPIBus_Release(SPIBUS_LCD)
+#define TP_BUS_ACQUIRE()        SPIBus_Acquire(SPIBUS_TOUCH)
+#define TP_BUS_RELEASE()        SPIBus_Release(SPIBUS_TOUCH)
+#else
+#define LCD_BUS_ACQUIRE()
+#define LCD_BUS_RELEASE()
+#define TP_BUS_ACQUIRE()
+#define TP_BUS_RELEASE()
+#endif
+
+/* Cost counters (LCD_Perf.h), a primitive counts from its bus hold to its release */
+#if LCD_PERF
+#define LCD_PERF_BEGIN(primitive)   LCD_PerfBegin(primitive)
+#define LCD_PERF_END()              LCD_PerfEnd()
+#define LCD_PERF_PIXELS(n)          (LCD_PerfCurrent.Pixels += (n))
+#define LCD_PERF_REG_WRITE()        (LCD_PerfCurrent.RegWrites++)
+#define LCD_PERF_BYTES(n)           (LCD_PerfCurrent.Bytes += (n))
+#else
+#define LCD_PERF_BEGIN(primitive)
+#define LCD_PERF_END()
+#define LCD_PERF_PIXELS(n)
+#define LCD_PERF_REG_WRITE()
+#define LCD_PERF_BYTES(n)
+#endif
+
+/* Most font cells that fit on one text line */
+#define LCD_TEXT_MAX_RUN        (MAX_SCREEN_X / LCD_CHAR_WIDTH)
+
+#ifdef LCD_EMULATOR
+/* Source increments LCD_DMAStream understands (dma.h values) */
+#define UDMA_SRC_INC_8          0x00000000
+#define UDMA_SRC_INC_NONE       0x0c000000
+#endif
+
+/************************************  Defines  *****************************************************/
 
 /************************************  Structures  **************************************************/
 
+#ifndef LCD_EMULATOR
 static const eUSCI_SPI_MasterConfig SPI_LCD_Config = {
                                                       EUSCI_SPI_CLOCKSOURCE_SMCLK,  //UCAxCTLW0-> UCSSELx (clock source select)-> SMCLK
-                                                      12000000, //Clock Source Frequency
-                                                      12000000, //Desired SPI Clock
+                                                      12000000, //Clock Source Frequency (read back from CS at init)
+                                                      LCD_SPI_CLOCK, //Desired SPI Clock
                                                       EUSCI_SPI_MSB_FIRST,  //msbFirst (UCMSB)
                                                       EUSCI_SPI_PHASE_DATA_CHANGED_ONFIRST_CAPTURED_ON_NEXT,    //clockPhase (UCCKP)
                                                       //EUSCI_SPI_PHASE_DATA_CAPTURED_ONFIRST_CHANGED_ON_NEXT,
@@ -23,6 +103,37 @@ static const eUSCI_SPI_MasterConfig SPI_LCD_Config = {
                                                       //EUSCI_SPI_CLOCKPOLARITY_INACTIVITY_LOW,
                                                       EUSCI_SPI_3PIN    //SPImode (UCMODEx)
 };
+#endif
+
+/************************************  Private Variables  *******************************************/
+
+/* Transfer the DMA interrupt is working through */
+static DMAPlan_t LCD_DMAPlanned;
+static const uint8_t *LCD_DMASource;
+static volatile bool LCD_DMABusy;
+
+#ifndef LCD_EMULATOR
+/* Signalled by the DMA interrupt when the calling thread blocked on the transfer */
+static semaphore_t LCD_DMADone;
+#endif
+
+/* Sources for solid fills, the buffer is also the bounce buffer for blits */
+static uint8_t LCD_FillByte;
+static uint8_t LCD_DMABuffer[LCD_DMA_BUFFER_BYTES];
+static uint16_t LCD_DMABufferColor;
+static bool LCD_DMABufferHoldsFill = false;
+
+/* Font rows of the characters in the text run being drawn */
+static uint8_t LCD_TextGlyphs[LCD_TEXT_MAX_RUN][LCD_CHAR_HEIGHT];
+
+/* Last values written to HOR_ADDR_START_POS .. VERT_ADDR_END_POS, a window only
+ * writes the registers that changed. Valid once LCD_Init has set the full screen */
+static uint16_t LCD_WindowRegs[4];
+
+/* Shadow of GATE_SCAN_CONTROL_0X6A, GRAM column at the left edge of the screen */
+static uint16_t LCD_ScrollLine = 0;
+
+/************************************  Private Variables  *******************************************/
 
 /************************************  Private Functions  *******************************************/
 
@@ -31,11 +142,13 @@ static const eUSCI_SPI_MasterConfig SPI_LCD_Config = {
  */
 static void Delay(unsigned long interval)
 {
+#ifndef LCD_EMULATOR
     while(interval > 0)
     {
         __delay_cycles(48000);
         interval--;
     }
+#endif
 }
 
 /*******************************************************************************
@@ -48,6 +161,10 @@ static void Delay(unsigned long interval)
  *******************************************************************************/
 static void LCD_initSPI()
 {
+#ifdef LCD_EMULATOR
+    //The emulated controller starts over with every LCD_Init
+    LCDEmu_Reset();
+#else
     /* P10.1 - CLK
      * P10.2 - MOSI
      * P10.3 - MISO
@@ -71,8 +188,22 @@ static void LCD_initSPI()
     P10SEL1 &= 0xC1;
     P10DIR |= 0x30;
 
-    SPI_initMaster(EUSCI_B3_BASE, &SPI_LCD_Config);
-    SPI_enableModule(EUSCI_B3_BASE);
+    eUSCI_SPI_MasterConfig config = SPI_LCD_Config;
+    config.clockSourceFrequency = CS_getSMCLK();
+    SPIBus_InitDevice(SPIBUS_LCD, &config, SPIBUS_PRIORITY_LCD);
+
+    //Touch controller shares the pins and the mode, only slower
+    config.desiredSpiClock = TP_SPI_CLOCK;
+    SPIBus_InitDevice(SPIBUS_TOUCH, &config, SPIBUS_PRIORITY_TOUCH);
+
+    //Pixel streams go out through the uDMA, channel 6 is triggered by EUSCI_B3 TX
+    DMAControl_Init();
+    DMA_assignChannel(DMA_CH6_EUSCIB3TX0);
+    DMA_disableChannelAttribute(DMA_CH6_EUSCIB3TX0, UDMA_ATTR_ALTSELECT | UDMA_ATTR_USEBURST | UDMA_ATTR_HIGH_PRIORITY | UDMA_ATTR_REQMASK);
+    DMA_assignInterrupt(DMA_INT1, LCD_DMA_CHANNEL);
+    Interrupt_setPriority(DMA_INT1, SYSCALL_PRIORITY << 5);   //Signals a semaphore, has to be allowed to call the kernel
+    DMA_enableInterrupt(DMA_INT1);
+    G8RTOS_InitSemaphore(&LCD_DMADone, 0);
 
 //    //I/O For P10.4
 //    P10SEL1.4 = 0;
@@ -81,7 +212,7 @@ static void LCD_initSPI()
 //    //I/O For P10.5
 //    P10SEL1.5 = 0;
 //    P10SEL0.5 = 0;
-
+#endif
 }
 
 /*******************************************************************************
@@ -94,17 +225,343 @@ static void LCD_initSPI()
  *******************************************************************************/
 static void LCD_reset()
 {
+#ifndef LCD_EMULATOR
     P10DIR |= BIT0;
     P10OUT |= BIT0;  // high
     Delay(100);
     P10OUT &= ~BIT0; // low
     Delay(100);
     P10OUT |= BIT0;  // high
+#endif
+}
+
+#ifndef LCD_EMULATOR
+
+/*******************************************************************************
+ * Function Name  : LCD_DMANextChunk
+ * Description    : Loads the next chunk of the active stream and starts it
+ * Input          : None
+ * Output         : None
+ * Return         : false once the whole stream was handed to the uDMA
+ * Attention      : TXIFG is already set, so the channel starts as soon as it is enabled
+ *******************************************************************************/
+static bool LCD_DMANextChunk()
+{
+    uint32_t offset;
+    uint16_t chunk = DMAPlan_Next(&LCD_DMAPlanned, &offset);
+    if(chunk == 0){
+        return false;
+    }
+
+    DMA_setChannelTransfer(UDMA_PRI_SELECT | DMA_CH6_EUSCIB3TX0, UDMA_MODE_BASIC,
+                           (void *)(LCD_DMASource + offset),
+                           (void *)SPI_getTransmitBufferAddressForDMA(EUSCI_B3_BASE), chunk);
+    DMA_enableChannel(LCD_DMA_CHANNEL);
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_DMAStream
+ * Description    : Sends a byte stream to the LCD through the uDMA
+ * Input          : - source: first byte of the stream (or of the repeated pattern)
+ *                  - bytes: length of the stream
+ *                  - sourceIncrement: UDMA_SRC_INC_8, or UDMA_SRC_INC_NONE to repeat one byte
+ *                  - maxChunk: length of a repeated pattern, 0 if the source is the whole stream
+ * Output         : None
+ * Return         : None
+ * Attention      : CS has to be low and the data start byte sent.
+ *                  A running thread blocks on a semaphore while the DMA interrupt
+ *                  chains the chunks, anything else (before launch, interrupts off,
+ *                  handler mode) polls the channel instead
+ *******************************************************************************/
+static void LCD_DMAStream(const uint8_t *source, uint32_t bytes, uint32_t sourceIncrement, uint16_t maxChunk)
+{
+    bool blocking = G8RTOS_IsRunning() && G8RTOS_InThreadMode();
+    LCD_PERF_BYTES(bytes);
+
+    DMAPlan_Init(&LCD_DMAPlanned, bytes, maxChunk, (maxChunk != 0) || (sourceIncrement == UDMA_SRC_INC_NONE));
+    LCD_DMASource = source;
+    LCD_DMABusy = true;
+
+    DMA_setChannelControl(UDMA_PRI_SELECT | DMA_CH6_EUSCIB3TX0,
+                          UDMA_SIZE_8 | sourceIncrement | UDMA_DST_INC_NONE | UDMA_ARB_1);
+
+    if(blocking){
+        LCD_DMANextChunk();
+        G8RTOS_WaitSemaphore(&LCD_DMADone);     //Other threads run while the pixels go out
+    }
+    else{
+        DMA_disableInterrupt(DMA_INT1);
+        LCD_DMANextChunk();
+        while(LCD_DMABusy){
+            if(!DMA_isChannelEnabled(LCD_DMA_CHANNEL) && !LCD_DMANextChunk()){
+                LCD_DMABusy = false;
+            }
+        }
+        DMA_clearInterruptFlag(LCD_DMA_CHANNEL);
+        Interrupt_unpendInterrupt(DMA_INT1);
+        DMA_enableInterrupt(DMA_INT1);
+    }
+
+    //Last byte is still shifting out when the uDMA is done
+    LCD_SPIFinish();
+}
+
+#else
+
+/*******************************************************************************
+ * Function Name  : LCD_DMAStream
+ * Description    : Sends a byte stream to the emulated LCD
+ * Input          : Same as the uDMA version
+ * Output         : None
+ * Return         : None
+ * Attention      : Walks the same chunk plan, so the emulator sees the exact byte stream.
+ *                  The bytes are counted one by one in SPISendRecvByte
+ *******************************************************************************/
+static void LCD_DMAStream(const uint8_t *source, uint32_t bytes, uint32_t sourceIncrement, uint16_t maxChunk)
+{
+    uint32_t offset;
+    uint16_t chunk, i;
+
+    DMAPlan_Init(&LCD_DMAPlanned, bytes, maxChunk, (maxChunk != 0) || (sourceIncrement == UDMA_SRC_INC_NONE));
+    LCD_DMASource = source;
+
+    while((chunk = DMAPlan_Next(&LCD_DMAPlanned, &offset)) != 0){
+        for(i = 0; i < chunk; i++){
+            SPISendRecvByte(LCD_DMASource[(sourceIncrement == UDMA_SRC_INC_NONE) ? offset : (offset + i)]);
+        }
+    }
+}
+
+#endif
+
+/*******************************************************************************
+ * Function Name  : LCD_BusCheckpoint
+ * Description    : Lets a waiting touch read use the bus in the middle of a GRAM write
+ * Input          : None
+ * Output         : None
+ * Return         : None
+ * Attention      : Called between DMA slices with the last byte already out. The
+ *                  address counter keeps its place, the write carries on from there
+ *******************************************************************************/
+static void LCD_BusCheckpoint()
+{
+#ifndef LCD_EMULATOR
+    if(SPIBus_Contended(SPIBUS_LCD)){
+        SPI_CS_HIGH;
+        SPIBus_Yield(SPIBUS_LCD);
+        LCD_WriteIndex(DATA_IN_GRAM);
+        SPI_CS_LOW;
+        LCD_Write_Data_Start();
+    }
+#endif
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_DMAFill
+ * Description    : Streams one color through the uDMA
+ * Input          : - Color: fill color
+ *                  - pixels: number of pixels
+ * Output         : None
+ * Return         : None
+ * Attention      : Colors with equal bytes (black, white) repeat a single byte,
+ *                  every other color repeats a small pattern buffer
+ *******************************************************************************/
+static void LCD_DMAFill(uint16_t Color, uint32_t pixels)
+{
+    uint8_t high = Color >> 8;
+    uint8_t low = Color & 0xFF;
+    const uint8_t *source = LCD_DMABuffer;
+    uint32_t increment = UDMA_SRC_INC_8;
+    uint16_t maxChunk = LCD_DMA_BUFFER_BYTES;
+
+    if(high == low){
+        LCD_FillByte = high;
+        source = &LCD_FillByte;
+        increment = UDMA_SRC_INC_NONE;
+        maxChunk = 0;
+    }
+    else if(!LCD_DMABufferHoldsFill || LCD_DMABufferColor != Color){
+        int i;
+        for(i = 0; i < LCD_DMA_BUFFER_BYTES; i += 2){
+            LCD_DMABuffer[i] = high;      //D8..D15 first, like LCD_Write_Data_Only
+            LCD_DMABuffer[i + 1] = low;
+        }
+        LCD_DMABufferColor = Color;
+        LCD_DMABufferHoldsFill = true;
+    }
+
+    uint32_t bytes = pixels * 2;
+    while(bytes > 0){
+        uint32_t slice = (bytes > LCD_BUS_SLICE_BYTES) ? LCD_BUS_SLICE_BYTES : bytes;
+        LCD_DMAStream(source, slice, increment, maxChunk);
+        bytes -= slice;
+        if(bytes > 0){
+            LCD_BusCheckpoint();
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_WindowReg
+ * Description    : Writes one of the window registers if its value changed
+ * Input          : - LCD_Reg: HOR_ADDR_START_POS .. VERT_ADDR_END_POS
+ *                  - value: new value
+ * Output         : None
+ * Return         : None
+ * Attention      : Saves 6 bytes per register that is already set, consecutive
+ *                  spans on a row or a column only move two registers
+ *******************************************************************************/
+static void LCD_WindowReg(uint16_t LCD_Reg, uint16_t value)
+{
+    uint16_t *shadow = &LCD_WindowRegs[LCD_Reg - HOR_ADDR_START_POS];
+    if(*shadow != value){
+        *shadow = value;
+        LCD_WriteReg(LCD_Reg, value);
+    }
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_OpenWindow
+ * Description    : Sets the GRAM window and starts a pixel stream into it
+ * Input          : xStart, xEnd, yStart, yEnd (inclusive)
+ * Output         : None
+ * Return         : None
+ * Attention      : Leaves CS low after the data start byte, pixels follow
+ *                  x first then y. End with SPI_CS_HIGH
+ *******************************************************************************/
+static void LCD_OpenWindow(int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd)
+{
+    //Y is horizontal and X is vertical
+    LCD_WindowReg(HOR_ADDR_START_POS, yStart);
+    LCD_WindowReg(HOR_ADDR_END_POS, yEnd);
+    LCD_WindowReg(VERT_ADDR_START_POS, xStart);
+    LCD_WindowReg(VERT_ADDR_END_POS, xEnd);
+    LCD_SetCursor(xStart, yStart);
+
+    LCD_WriteIndex(DATA_IN_GRAM);
+    SPI_CS_LOW;
+    LCD_Write_Data_Start();
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_FillSpan
+ * Description    : Fills a row or column run clipped to the screen
+ * Input          : xStart, xEnd, yStart, yEnd (inclusive, any order), Color
+ * Output         : None
+ * Return         : None
+ * Attention      : Used by the line and circle primitives
+ *******************************************************************************/
+static void LCD_FillSpan(int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd, uint16_t Color)
+{
+    int16_t swap;
+    if(xEnd < xStart){
+        swap = xStart; xStart = xEnd; xEnd = swap;
+    }
+    if(yEnd < yStart){
+        swap = yStart; yStart = yEnd; yEnd = swap;
+    }
+
+    if(xStart < MIN_SCREEN_X) xStart = MIN_SCREEN_X;
+    if(yStart < MIN_SCREEN_Y) yStart = MIN_SCREEN_Y;
+    if(xEnd > MAX_SCREEN_X - 1) xEnd = MAX_SCREEN_X - 1;
+    if(yEnd > MAX_SCREEN_Y - 1) yEnd = MAX_SCREEN_Y - 1;
+
+    LCD_DrawRectangle(xStart, xEnd, yStart, yEnd, Color);
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_CircleWidth
+ * Description    : Half width of a filled circle on a row
+ * Input          : - width: half width of the row before (closer to the center)
+ *                  - dy: distance of the row from the center
+ *                  - limit: radius * (radius + 1), the edge at radius + 1/2
+ * Output         : None
+ * Return         : Largest dx with dx^2 + dy^2 <= limit
+ * Attention      : Rows are walked outwards so the width only shrinks
+ *******************************************************************************/
+static int16_t LCD_CircleWidth(int16_t width, int32_t dy, int32_t limit)
+{
+    while(width > 0 && (int32_t)width * width + dy * dy > limit){
+        width--;
+    }
+    return width;
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_TextRun
+ * Description    : Draws the glyphs in LCD_TextGlyphs side by side
+ * Input          : - Xpos, Ypos: top left corner of the first character
+ *                  - count: number of glyphs, must fit on the line
+ *                  - charColor: Character color
+ *                  - bkColor: Background color
+ * Output         : None
+ * Return         : None
+ * Attention      : One window for the whole run, the rows of every glyph are
+ *                  expanded into the DMA buffer and streamed in one CS low burst
+ *******************************************************************************/
+static void LCD_TextRun(uint16_t Xpos, uint16_t Ypos, uint16_t count, uint16_t charColor, uint16_t bkColor)
+{
+    LCD_BUS_ACQUIRE();
+    LCD_OpenWindow(Xpos, Xpos + count * LCD_CHAR_WIDTH - 1, Ypos, Ypos + LCD_CHAR_HEIGHT - 1);
+    LCD_PERF_PIXELS((uint32_t)count * LCD_CHAR_WIDTH * LCD_CHAR_HEIGHT);
+
+    LCD_DMABufferHoldsFill = false;
+    uint16_t used = 0;
+    uint16_t row, c, j;
+    for(row = 0; row < LCD_CHAR_HEIGHT; row++){
+        for(c = 0; c < count; c++){
+            uint8_t bits = LCD_TextGlyphs[c][row];
+            for(j = 0; j < LCD_CHAR_WIDTH; j++, bits <<= 1){
+                uint16_t color = (bits & 0x80) ? charColor : bkColor;
+                LCD_DMABuffer[used++] = color >> 8;
+                LCD_DMABuffer[used++] = color & 0xFF;
+            }
+            if(used == LCD_DMA_BUFFER_BYTES){
+                LCD_DMAStream(LCD_DMABuffer, used, UDMA_SRC_INC_8, 0);
+                used = 0;
+            }
+        }
+    }
+    if(used){
+        LCD_DMAStream(LCD_DMABuffer, used, UDMA_SRC_INC_8, 0);
+    }
+
+    LCD_SPIFinish();
+    SPI_CS_HIGH;
+    LCD_BUS_RELEASE();
 }
 
 /************************************  Private Functions  *******************************************/
 
 
+/************************************  Interrupt Handlers  *******************************************/
+
+/*******************************************************************************
+ * Function Name  : DMA_INT1_IRQHandler
+ * Description    : End of one LCD chunk, starts the next one or wakes the waiting thread
+ * Input          : None
+ * Output         : None
+ * Return         : None
+ * Attention      : Runs at SYSCALL_PRIORITY
+ *******************************************************************************/
+#ifndef LCD_EMULATOR
+void DMA_INT1_IRQHandler(void)
+{
+    DMA_clearInterruptFlag(LCD_DMA_CHANNEL);
+
+    if(LCD_DMANextChunk()){
+        return;
+    }
+
+    LCD_DMABusy = false;
+    G8RTOS_SignalSemaphore(&LCD_DMADone);
+}
+#endif
+
+/************************************  Interrupt Handlers  *******************************************/
+
+
 /************************************  Public Functions  *******************************************/
 
 /*******************************************************************************
@@ -114,37 +571,345 @@ static void LCD_reset()
  * Output         : None
  * Return         : None
  * Attention      : Must draw from left to right, top to bottom!
+ *                  Larger areas are streamed by the uDMA
  *******************************************************************************/
 void LCD_DrawRectangle(int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd, uint16_t Color)
 {
     //Uses continuous data transmission to remove cs toggling requirement
     //Uses auto incrementing of data transmission
+    if(xEnd < xStart || yEnd < yStart){
+        return;
+    }
 
     //Set the rectangle area size
-    LCD_WriteReg(HOR_ADDR_START_POS, yStart);
-    LCD_WriteReg(HOR_ADDR_END_POS, yEnd);
-    LCD_WriteReg(VERT_ADDR_START_POS, xStart);
-    LCD_WriteReg(VERT_ADDR_END_POS, xEnd);
+    LCD_BUS_ACQUIRE();
+    LCD_PERF_BEGIN(LCD_PERF_RECTANGLE);
+    LCD_OpenWindow(xStart, xEnd, yStart, yEnd);
+
+    uint32_t pixels = (uint32_t)(xEnd - xStart + 1) * (uint32_t)(yEnd - yStart + 1);
+    LCD_PERF_PIXELS(pixels);
+    if(pixels * 2 >= LCD_DMA_MIN_BYTES){
+        LCD_DMAFill(Color, pixels);
+    }
+    else{
+        int i = 0;
+        int j = 0;
+        for(i = xStart; i < xEnd+1; i++){
+            for(j = yStart; j < yEnd+1; j++){
+                LCD_Write_Data_Only(Color);
+            }
+        }
+    }
+    LCD_SPIFinish();
+    SPI_CS_HIGH;
+    LCD_PERF_END();
+    LCD_BUS_RELEASE();
+    //LCD_SetPoint(uint16_t Xpos, uint16_t Ypos, uint16_t color)
 
-    //Y is horizontal and X is vertical
-//    LCD_WriteReg(GRAM_HORIZONTAL_ADDRESS_SET, yStart);
-//    LCD_WriteReg(GRAM_VERTICAL_ADDRESS_SET, xStart);
-    LCD_SetCursor(xStart,yStart);
-    //LCD_WriteReg(DATA_IN_GRAM, Color);
-    LCD_WriteIndex(DATA_IN_GRAM);
-    SPI_CS_LOW;
-    LCD_Write_Data_Start();
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_DrawLine
+ * Description    : Draws a one pixel wide line between two points (Bresenham)
+ * Input          : - x0, y0: first end point
+ *                  - x1, y1: second end point
+ *                  - Color: line color
+ * Output         : None
+ * Return         : None
+ * Attention      : Drawn as runs along the major axis, one window burst per run
+ *                  instead of 18 bytes per pixel. Clipped to the screen
+ *******************************************************************************/
+void LCD_DrawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t Color)
+{
+    int16_t dx = (x1 > x0) ? (x1 - x0) : (x0 - x1);
+    int16_t dy = (y1 > y0) ? (y1 - y0) : (y0 - y1);
+    int16_t stepX = (x1 >= x0) ? 1 : -1;
+    int16_t stepY = (y1 >= y0) ? 1 : -1;
+    bool steep = dy > dx;
+
+    //Walk the major axis, the run ends every time the minor axis steps
+    int16_t major = steep ? dy : dx;
+    int16_t minor = steep ? dx : dy;
+    int16_t error = major / 2;
+    int16_t x = x0, y = y0;
+    int16_t runStart = steep ? y0 : x0;
+    int16_t i;
+
+    //One bus hold for every run
+    LCD_BUS_ACQUIRE();
+    LCD_PERF_BEGIN(LCD_PERF_LINE);
+
+    for(i = 0; i < major; i++){
+        error -= minor;
+        if(error < 0){
+            error += major;
+            if(steep){
+                LCD_FillSpan(x, x, runStart, y, Color);
+                x += stepX;
+                y += stepY;
+                runStart = y;
+            }
+            else{
+                LCD_FillSpan(runStart, x, y, y, Color);
+                y += stepY;
+                x += stepX;
+                runStart = x;
+            }
+        }
+        else if(steep){
+            y += stepY;
+        }
+        else{
+            x += stepX;
+        }
+    }
+
+    //Last run ends on the end point
+    if(steep){
+        LCD_FillSpan(x, x, runStart, y, Color);
+    }
+    else{
+        LCD_FillSpan(runStart, x, y, y, Color);
+    }
+
+    LCD_PERF_END();
+    LCD_BUS_RELEASE();
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_DrawCircle
+ * Description    : Draws the outline of a circle
+ * Input          : - xCenter, yCenter: center of the circle
+ *                  - radius: radius in pixels
+ *                  - Color: outline color
+ * Output         : None
+ * Return         : None
+ * Attention      : Outline of LCD_FillCircle with the same radius, at most two
+ *                  horizontal spans per row. Clipped to the screen
+ *******************************************************************************/
+void LCD_DrawCircle(int16_t xCenter, int16_t yCenter, uint16_t radius, uint16_t Color)
+{
+    int32_t limit = (int32_t)radius * (radius + 1);
+    int16_t width = LCD_CircleWidth(radius, 0, limit);
+    int16_t dy;
+
+    LCD_BUS_ACQUIRE();
+    LCD_PERF_BEGIN(LCD_PERF_CIRCLE);
+
+    for(dy = 0; dy <= (int16_t)radius; dy++){
+        //Pixels past the width of the next row out have nothing beyond them
+        int16_t inner = (dy < (int16_t)radius) ? LCD_CircleWidth(width, dy + 1, limit) : -1;
+        int16_t first = (inner + 1 < width) ? (inner + 1) : width;
+
+        if(first == 0){
+            LCD_FillSpan(xCenter - width, xCenter + width, yCenter + dy, yCenter + dy, Color);
+            if(dy != 0){
+                LCD_FillSpan(xCenter - width, xCenter + width, yCenter - dy, yCenter - dy, Color);
+            }
+        }
+        else{
+            LCD_FillSpan(xCenter - width, xCenter - first, yCenter + dy, yCenter + dy, Color);
+            LCD_FillSpan(xCenter + first, xCenter + width, yCenter + dy, yCenter + dy, Color);
+            if(dy != 0){
+                LCD_FillSpan(xCenter - width, xCenter - first, yCenter - dy, yCenter - dy, Color);
+                LCD_FillSpan(xCenter + first, xCenter + width, yCenter - dy, yCenter - dy, Color);
+            }
+        }
+
+        width = (inner < 0) ? 0 : inner;
+    }
+
+    LCD_PERF_END();
+    LCD_BUS_RELEASE();
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_FillCircle
+ * Description    : Draws a filled circle
+ * Input          : - xCenter, yCenter: center of the circle
+ *                  - radius: radius in pixels
+ *                  - Color: fill color
+ * Output         : None
+ * Return         : None
+ * Attention      : One horizontal span per row, rows above and below the center
+ *                  share their column registers. Clipped to the screen
+ *******************************************************************************/
+void LCD_FillCircle(int16_t xCenter, int16_t yCenter, uint16_t radius, uint16_t Color)
+{
+    int32_t limit = (int32_t)radius * (radius + 1);
+    int16_t width = radius;
+    int16_t dy;
+
+    LCD_BUS_ACQUIRE();
+    LCD_PERF_BEGIN(LCD_PERF_CIRCLE);
+
+    for(dy = 0; dy <= (int16_t)radius; dy++){
+        width = LCD_CircleWidth(width, dy, limit);
+        LCD_FillSpan(xCenter - width, xCenter + width, yCenter + dy, yCenter + dy, Color);
+        if(dy != 0){
+            LCD_FillSpan(xCenter - width, xCenter + width, yCenter - dy, yCenter - dy, Color);
+        }
+    }
+
+    LCD_PERF_END();
+    LCD_BUS_RELEASE();
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_BlitRGB565
+ * Description    : Draws a block of pixels
+ * Input          : - x, y: top left corner on the screen (may be off screen)
+ *                  - w, h: size of the block
+ *                  - pixels: RGB565 pixels, row after row (pixels[row * w + column])
+ * Output         : None
+ * Return         : None
+ * Attention      : The window is set once and every pixel goes out in one CS low
+ *                  burst, 2 bytes per pixel instead of 18 for LCD_SetPoint.
+ *                  Clipped to the screen. Larger blocks are byte swapped into the
+ *                  bounce buffer and streamed by the uDMA
+ *******************************************************************************/
+void LCD_BlitRGB565(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint16_t *pixels)
+{
+    //Clip to the screen, the source keeps its full stride
+    int16_t xStart = (x < MIN_SCREEN_X) ? MIN_SCREEN_X : x;
+    int16_t yStart = (y < MIN_SCREEN_Y) ? MIN_SCREEN_Y : y;
+    int16_t xEnd = ((int32_t)x + w > MAX_SCREEN_X) ? (MAX_SCREEN_X - 1) : (x + w - 1);
+    int16_t yEnd = ((int32_t)y + h > MAX_SCREEN_Y) ? (MAX_SCREEN_Y - 1) : (y + h - 1);
+    if(w == 0 || h == 0 || xEnd < xStart || yEnd < yStart){
+        return;
+    }
+
+    uint16_t columns = xEnd - xStart + 1;
+    uint16_t rows = yEnd - yStart + 1;
+    const uint16_t *row = pixels + (uint32_t)(yStart - y) * w + (xStart - x);
 
-    int i = 0;
-    int j = 0;
-    for(i = xStart; i < xEnd+1; i++){
-        for(j = yStart; j < yEnd+1; j++){
-            LCD_Write_Data_Only(Color);
+    LCD_BUS_ACQUIRE();
+    LCD_PERF_BEGIN(LCD_PERF_BLIT);
+    LCD_OpenWindow(xStart, xEnd, yStart, yEnd);
+    LCD_PERF_PIXELS((uint32_t)columns * rows);
+
+    uint16_t i, j;
+    if((uint32_t)columns * rows * 2 < LCD_DMA_MIN_BYTES){
+        for(j = 0; j < rows; j++, row += w){
+            for(i = 0; i < columns; i++){
+                LCD_Write_Data_Only(row[i]);
+            }
         }
     }
+    else{
+        //Pixels sit little endian in memory but go out D8..D15 first
+        LCD_DMABufferHoldsFill = false;
+        uint16_t used = 0;
+        for(j = 0; j < rows; j++, row += w){
+            for(i = 0; i < columns; i++){
+                LCD_DMABuffer[used++] = row[i] >> 8;
+                LCD_DMABuffer[used++] = row[i] & 0xFF;
+                if(used == LCD_DMA_BUFFER_BYTES){
+                    LCD_DMAStream(LCD_DMABuffer, used, UDMA_SRC_INC_8, 0);
+                    LCD_BusCheckpoint();
+                    used = 0;
+                }
+            }
+        }
+        if(used){
+            LCD_DMAStream(LCD_DMABuffer, used, UDMA_SRC_INC_8, 0);
+        }
+    }
+
+    LCD_SPIFinish();
     SPI_CS_HIGH;
-    //LCD_SetPoint(uint16_t Xpos, uint16_t Ypos, uint16_t color)
+    LCD_PERF_END();
+    LCD_BUS_RELEASE();
+}
 
+/*******************************************************************************
+ * Function Name  : LCD_SetScroll
+ * Description    : Sets the hardware scroll offset
+ * Input          : - line: GRAM column shown at the left edge of the screen
+ * Output         : None
+ * Return         : None
+ * Attention      : The panel scrolls along its 320 gate lines, which is x in
+ *                  landscape. Screen column x shows GRAM column (x + line) % 320
+ *******************************************************************************/
+void LCD_SetScroll(uint16_t line)
+{
+    LCD_ScrollLine = line % MAX_SCREEN_X;
+    LCD_BUS_ACQUIRE();
+    LCD_WriteReg(GATE_SCAN_CONTROL_0X6A, LCD_ScrollLine);
+    LCD_BUS_RELEASE();
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_SetFrameMarker
+ * Description    : Turns the FMARK frame marker output on or off
+ * Input          : - interval: FMARK_EVERY_* frames, ignored when off
+ *                  - line: scan line the pulse comes out on, 0 is the first
+ *                    back porch line
+ *                  - enable: true to pulse FMARK
+ * Output         : None
+ * Return         : None
+ * Attention      : The panel scans its gate lines in screen x order, screen
+ *                  column x is drawn LCD_BACK_PORCH_LINES + x lines after line 0
+ *******************************************************************************/
+void LCD_SetFrameMarker(uint16_t interval, uint16_t line, bool enable)
+{
+    LCD_BUS_ACQUIRE();
+    LCD_WriteReg(FRAME_MARKER_POSITION, line % LCD_FRAME_LINES);
+    LCD_WriteReg(DISPLAY_CONTROL_4, enable ? (FMARK_OUTPUT_ENABLE | interval) : 0x0000);
+    LCD_BUS_RELEASE();
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_Scroll
+ * Description    : Scrolls the whole screen sideways and clears what comes in
+ * Input          : - columns: > 0 moves the picture left, < 0 moves it right
+ *                  - bkColor: color of the newly exposed columns
+ * Output         : None
+ * Return         : GRAM x of the first newly exposed column
+ * Attention      : One register write plus a fill of the exposed strip. Draw the
+ *                  new content at the returned x, it may wrap past 319 to 0
+ *******************************************************************************/
+uint16_t LCD_Scroll(int16_t columns, uint16_t bkColor)
+{
+    //Whole screen or more is just a clear
+    if(columns >= MAX_SCREEN_X || columns <= -MAX_SCREEN_X){
+        LCD_Clear(bkColor);
+        return LCD_ScrollLine;
+    }
+
+    //Moving left exposes the columns that used to be just off the left edge on
+    //the right, moving right exposes the columns in front of the new left edge
+    uint16_t count = (columns < 0) ? -columns : columns;
+    uint16_t first = (columns < 0) ? (LCD_ScrollLine + MAX_SCREEN_X - count) % MAX_SCREEN_X : LCD_ScrollLine;
+
+    if(count == 0){
+        return first;
+    }
+
+    //Clear the strip before it shows, split where it wraps in GRAM
+    if(first + count <= MAX_SCREEN_X){
+        LCD_DrawRectangle(first, first + count - 1, 0, MAX_SCREEN_Y - 1, bkColor);
+    }
+    else{
+        LCD_DrawRectangle(first, MAX_SCREEN_X - 1, 0, MAX_SCREEN_Y - 1, bkColor);
+        LCD_DrawRectangle(0, first + count - MAX_SCREEN_X - 1, 0, MAX_SCREEN_Y - 1, bkColor);
+    }
+
+    LCD_SetScroll(LCD_ScrollLine + MAX_SCREEN_X + columns);
+    return first;
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_ScreenToGramX
+ * Description    : Translates a screen column into the GRAM column shown there
+ * Input          : - x: screen column
+ * Output         : None
+ * Return         : GRAM column, what the drawing functions take as x
+ * Attention      : Identity while the scroll offset is 0
+ *******************************************************************************/
+uint16_t LCD_ScreenToGramX(uint16_t x)
+{
+    return (x + LCD_ScrollLine) % MAX_SCREEN_X;
 }
 
 /******************************************************************************
@@ -154,26 +919,15 @@ void LCD_DrawRectangle(int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEn
  *                  - Ypos: Vertical coordinate
  *                  - ASCI: Displayed character
  *                  - charColor: Character color
+ *                  - bkColor: Background color
  * Output         : None
  * Return         : None
- * Attention      : None
+ * Attention      : The whole 8x16 cell is written, no need to clear old text first
  *******************************************************************************/
-inline void PutChar( uint16_t Xpos, uint16_t Ypos, uint8_t ASCI, uint16_t charColor)
+void PutChar( uint16_t Xpos, uint16_t Ypos, uint8_t ASCI, uint16_t charColor, uint16_t bkColor)
 {
-    uint16_t i, j;
-    uint8_t buffer[16], tmp_char;
-    GetASCIICode(buffer,ASCI);  /* get font data */
-    for( i=0; i<16; i++ )
-    {
-        tmp_char = buffer[i];
-        for( j=0; j<8; j++ )
-        {
-            if( (tmp_char >> 7 - j) & 0x01 == 0x01 )
-            {
-                LCD_SetPoint( Xpos + j, Ypos + i, charColor );  /* Character color */
-            }
-        }
-    }
+    GetASCIICode(LCD_TextGlyphs[0], ASCI);  /* get font data */
+    LCD_TextRun(Xpos, Ypos, 1, charColor, bkColor);
 }
 
 /******************************************************************************
@@ -182,46 +936,128 @@ inline void PutChar( uint16_t Xpos, uint16_t Ypos, uint8_t ASCI, uint16_t charCo
  * Input          : - Xpos: Horizontal coordinate
  *                  - Ypos: Vertical coordinate
  *                  - str: Displayed string
- *                  - charColor: Character color
+ *                  - Color: Character color
+ *                  - bkColor: Background color
  * Output         : None
  * Return         : None
- * Attention      : None
+ * Attention      : Characters that share a line are drawn as one window and one
+ *                  pixel burst. Wraps to the next line, then back to the top
  *******************************************************************************/
-void LCD_Text(uint16_t Xpos, uint16_t Ypos, uint8_t *str, uint16_t Color)
+void LCD_Text(uint16_t Xpos, uint16_t Ypos, uint8_t *str, uint16_t Color, uint16_t bkColor)
 {
-    uint8_t TempChar;
+    uint16_t runX = Xpos;
+    uint16_t count = 0;
 
-    /* Set area back to span the entire LCD */
-    LCD_WriteReg(HOR_ADDR_START_POS, 0x0000);     /* Horizontal GRAM Start Address */
-    LCD_WriteReg(HOR_ADDR_END_POS, (MAX_SCREEN_Y - 1));  /* Horizontal GRAM End Address */
-    LCD_WriteReg(VERT_ADDR_START_POS, 0x0000);    /* Vertical GRAM Start Address */
-    LCD_WriteReg(VERT_ADDR_END_POS, (MAX_SCREEN_X - 1)); /* Vertical GRAM Start Address */
-//    LCD_WriteReg(HOR_ADDR_START_POS, 100);
-//    LCD_WriteReg(HOR_ADDR_END_POS, 200);
-//    LCD_WriteReg(VERT_ADDR_START_POS, 100);
-//    LCD_WriteReg(VERT_ADDR_END_POS, 200);
-    do
+    if(Ypos + LCD_CHAR_HEIGHT > MAX_SCREEN_Y)
+    {
+        Ypos = 0;
+    }
+
+    //One bus hold for every run, the string is counted as one call
+    LCD_BUS_ACQUIRE();
+    LCD_PERF_BEGIN(LCD_PERF_TEXT);
+
+    while(*str != 0)
     {
-        TempChar = *str++;
-        PutChar( Xpos, Ypos, TempChar, Color);
-        if( Xpos < MAX_SCREEN_X - 8)
+        //Character would run off the edge, draw the line so far and start it on the next one
+        if(Xpos + LCD_CHAR_WIDTH > MAX_SCREEN_X)
         {
-            Xpos += 8;
+            if(count)
+            {
+                LCD_TextRun(runX, Ypos, count, Color, bkColor);
+                count = 0;
+            }
+            Xpos = 0;
+            Ypos = (Ypos + 2 * LCD_CHAR_HEIGHT <= MAX_SCREEN_Y) ? (Ypos + LCD_CHAR_HEIGHT) : 0;
+            runX = Xpos;
         }
-        else if ( Ypos < MAX_SCREEN_X - 16)
+
+        GetASCIICode(LCD_TextGlyphs[count++], *str++);
+        Xpos += LCD_CHAR_WIDTH;
+    }
+
+    if(count)
+    {
+        LCD_TextRun(runX, Ypos, count, Color, bkColor);
+    }
+
+    LCD_PERF_END();
+    LCD_BUS_RELEASE();
+}
+
+
+/******************************************************************************
+* Function Name  : LCD_FontText
+* Description    : Displays the string in a font and size from LCD_Font.h
+* Input          : - Xpos: Horizontal coordinate
+*                  - Ypos: Vertical coordinate
+*                  - str: Displayed string
+*                  - font: Font_System8x16, Font_Proportional, ...
+*                  - scale: 1 to FONT_MAX_SCALE
+*                  - Color: Character color
+*                  - bkColor: Background color
+* Output         : None
+* Return         : None
+* Attention      : One window per glyph, glyphs in the font cache go straight from
+*                  there to the bus. Wraps to the next line, then back to the top
+*******************************************************************************/
+void LCD_FontText(uint16_t Xpos, uint16_t Ypos, const char *str, const Font_t *font, uint8_t scale, uint16_t Color, uint16_t bkColor)
+{
+    if(scale == 0 || scale > FONT_MAX_SCALE){
+        return;
+    }
+    uint16_t lineHeight = font->Height * scale;
+    if(Ypos + lineHeight > MAX_SCREEN_Y){
+        Ypos = 0;
+    }
+
+    //One bus hold for every glyph, the string is counted as one call
+    LCD_BUS_ACQUIRE();
+    LCD_PERF_BEGIN(LCD_PERF_FONT_TEXT);
+
+    while(*str != 0)
+    {
+        uint8_t ch = *str++;
+        uint16_t width = Font_Advance(font, ch) * scale;
+
+        //Glyph would run off the edge, start it on the next line
+        if(Xpos + width > MAX_SCREEN_X)
         {
             Xpos = 0;
-            Ypos += 16;
+            Ypos = (Ypos + 2 * lineHeight <= MAX_SCREEN_Y) ? (Ypos + lineHeight) : 0;
+        }
+
+        LCD_OpenWindow(Xpos, Xpos + width - 1, Ypos, Ypos + lineHeight - 1);
+        LCD_PERF_PIXELS((uint32_t)width * lineHeight);
+
+        FontGlyph_t glyph;
+        if(Font_GetGlyph(font, ch, scale, Color, bkColor, &glyph))
+        {
+            LCD_DMAStream(glyph.Bytes, (uint32_t)glyph.Width * glyph.Height * 2, UDMA_SRC_INC_8, 0);
         }
         else
         {
-            Xpos = 0;
-            Ypos = 0;
+            //Scaled glyphs are not cached, expand a row at a time and send it once per scaled row
+            uint16_t row, s;
+            LCD_DMABufferHoldsFill = false;
+            for(row = 0; row < font->Height; row++)
+            {
+                Font_ExpandRow(font, ch, row, scale, Color, bkColor, LCD_DMABuffer);
+                for(s = 0; s < scale; s++)
+                {
+                    LCD_DMAStream(LCD_DMABuffer, width * 2, UDMA_SRC_INC_8, 0);
+                }
+            }
         }
+
+        LCD_SPIFinish();
+        SPI_CS_HIGH;
+        Xpos += width;
     }
-    while ( *str != 0 );
-}
 
+    LCD_PERF_END();
+    LCD_BUS_RELEASE();
+}
 
 /*******************************************************************************
  * Function Name  : LCD_Clear
@@ -233,7 +1069,11 @@ void LCD_Text(uint16_t Xpos, uint16_t Ypos, uint8_t *str, uint16_t Color)
  *******************************************************************************/
 void LCD_Clear(uint16_t Color)
 {
+    LCD_BUS_ACQUIRE();
+    LCD_PERF_BEGIN(LCD_PERF_CLEAR);
     LCD_DrawRectangle(0x0000, MAX_SCREEN_X-1, 0x0000, MAX_SCREEN_Y-1, Color);
+    LCD_PERF_END();
+    LCD_BUS_RELEASE();
 
 }
 
@@ -248,9 +1088,14 @@ void LCD_Clear(uint16_t Color)
  *******************************************************************************/
 void LCD_SetPoint(uint16_t Xpos, uint16_t Ypos, uint16_t color)
 {
+    LCD_BUS_ACQUIRE();
+    LCD_PERF_BEGIN(LCD_PERF_POINT);
+    LCD_PERF_PIXELS(1);
     LCD_WriteReg(GRAM_HORIZONTAL_ADDRESS_SET, Ypos);
     LCD_WriteReg(GRAM_VERTICAL_ADDRESS_SET, Xpos);
     LCD_WriteReg(DATA_IN_GRAM, color);
+    LCD_PERF_END();
+    LCD_BUS_RELEASE();
 }
 
 /*******************************************************************************
@@ -263,8 +1108,8 @@ void LCD_SetPoint(uint16_t Xpos, uint16_t Ypos, uint16_t color)
  *******************************************************************************/
 inline void LCD_Write_Data_Only(uint16_t data)
 {
-    SPISendRecvByte((data >>   8));                    /* Write D8..D15                */
-    SPISendRecvByte((data & 0xFF));                    /* Write D0..D7                 */
+    LCD_SPIWrite((data >>   8));                       /* Write D8..D15                */
+    LCD_SPIWrite((data & 0xFF));                       /* Write D0..D7                 */
 }
 
 /*******************************************************************************
@@ -279,10 +1124,11 @@ inline void LCD_WriteData(uint16_t data)
 {
     SPI_CS_LOW;
 
-    SPISendRecvByte(SPI_START | SPI_WR | SPI_DATA);    /* Write : RS = 1, RW = 0       */
-    SPISendRecvByte((data >>   8));                    /* Write D8..D15                */
-    SPISendRecvByte((data & 0xFF));                    /* Write D0..D7                 */
+    LCD_SPIWrite(SPI_START | SPI_WR | SPI_DATA);       /* Write : RS = 1, RW = 0       */
+    LCD_SPIWrite((data >>   8));                       /* Write D8..D15                */
+    LCD_SPIWrite((data & 0xFF));                       /* Write D0..D7                 */
 
+    LCD_SPIFinish();
     SPI_CS_HIGH;
 }
 
@@ -312,13 +1158,15 @@ inline uint16_t LCD_ReadReg(uint16_t LCD_Reg)
  *******************************************************************************/
 inline void LCD_WriteIndex(uint16_t index)
 {
+    LCD_PERF_REG_WRITE();
     SPI_CS_LOW;
 
     /* SPI write data */
-    SPISendRecvByte(SPI_START | SPI_WR | SPI_INDEX);   /* Write : RS = 0, RW = 0  */
-    SPISendRecvByte(0);
-    SPISendRecvByte(index);
+    LCD_SPIWrite(SPI_START | SPI_WR | SPI_INDEX);      /* Write : RS = 0, RW = 0  */
+    LCD_SPIWrite(0);
+    LCD_SPIWrite(index);
 
+    LCD_SPIFinish();
     SPI_CS_HIGH;
 }
 
@@ -328,14 +1176,56 @@ inline void LCD_WriteIndex(uint16_t index)
  * Input          : uint8_t: byte
  * Output         : None
  * Return         : Recieved value 
- * Attention      : None
+ * Attention      : Full round trip, only for reads. Writes go through LCD_SPIWrite
  *******************************************************************************/
 inline uint8_t SPISendRecvByte (uint8_t byte)
 {
-    uint16_t temp;
-    SPI_transmitData(EUSCI_B3_BASE, byte);
-    temp = SPI_receiveData(EUSCI_B3_BASE);
-    return temp;
+    LCD_PERF_BYTES(1);
+#ifdef LCD_EMULATOR
+    return LCDEmu_Transfer(byte);
+#else
+    //Anything still queued has to be out first so RXBUF holds the answer to this byte
+    LCD_SPIFinish();
+    EUSCI_B3_SPI->TXBUF = byte;
+    while(!(EUSCI_B3_SPI->IFG & EUSCI_B_IFG_RXIFG));
+    return EUSCI_B3_SPI->RXBUF;
+#endif
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_SPIWrite
+ * Description    : Queues one byte for the LCD without waiting for an answer
+ * Input          : byte
+ * Output         : None
+ * Return         : None
+ * Attention      : TXBUF is double buffered, so the next byte is loaded while this
+ *                  one shifts out. RX is left alone, LCD_SPIFinish drains it
+ *******************************************************************************/
+inline void LCD_SPIWrite(uint8_t byte)
+{
+    LCD_PERF_BYTES(1);
+#ifdef LCD_EMULATOR
+    LCDEmu_Transfer(byte);
+#else
+    while(!(EUSCI_B3_SPI->IFG & EUSCI_B_IFG_TXIFG));
+    EUSCI_B3_SPI->TXBUF = byte;
+#endif
+}
+
+/*******************************************************************************
+ * Function Name  : LCD_SPIFinish
+ * Description    : Waits until every queued byte is on the wire
+ * Input          : None
+ * Output         : None
+ * Return         : None
+ * Attention      : Has to run before CS goes high. Drops what piled up in RX
+ *******************************************************************************/
+inline void LCD_SPIFinish()
+{
+#ifndef LCD_EMULATOR
+    while(EUSCI_B3_SPI->STATW & EUSCI_B_STATW_SPI_BUSY);
+    (void)EUSCI_B3_SPI->RXBUF;
+#endif
 }
 
 /*******************************************************************************
@@ -348,7 +1238,7 @@ inline uint8_t SPISendRecvByte (uint8_t byte)
  *******************************************************************************/
 inline void LCD_Write_Data_Start(void)
 {
-    SPISendRecvByte(SPI_START | SPI_WR | SPI_DATA);    /* Write : RS = 1, RW = 0 */
+    LCD_SPIWrite(SPI_START | SPI_WR | SPI_DATA);       /* Write : RS = 1, RW = 0 */
 }
 
 /*******************************************************************************
@@ -417,6 +1307,7 @@ void LCD_Init(bool usingTP)
 {
     LCD_initSPI();
 
+#ifndef LCD_EMULATOR
     if (usingTP)
     {
         /* Configure low true interrupt on P4.0 for TP */ 
@@ -430,7 +1321,9 @@ void LCD_Init(bool usingTP)
         //Maybe not
         //NVIC_EnableIRQ(PORT4_IRQn); //Enable da interrupt
     }
+#endif
 
+    LCD_BUS_ACQUIRE();
     LCD_reset();
 
     //uint16_t value = 0; //Just for debugging purposes
@@ -488,9 +1381,13 @@ void LCD_Init(bool usingTP)
     LCD_WriteReg(HOR_ADDR_END_POS, (MAX_SCREEN_Y - 1));  /* Horizontal GRAM End Address */
     LCD_WriteReg(VERT_ADDR_START_POS, 0x0000);    /* Vertical GRAM Start Address */
     LCD_WriteReg(VERT_ADDR_END_POS, (MAX_SCREEN_X - 1)); /* Vertical GRAM Start Address */
+    LCD_WindowRegs[0] = 0x0000;
+    LCD_WindowRegs[1] = MAX_SCREEN_Y - 1;
+    LCD_WindowRegs[2] = 0x0000;
+    LCD_WindowRegs[3] = MAX_SCREEN_X - 1;
     LCD_WriteReg(GATE_SCAN_CONTROL_0X60, 0x2700); /* Gate Scan Line */
-    LCD_WriteReg(GATE_SCAN_CONTROL_0X61, 0x0001); /* NDL,VLE, REV */
-    LCD_WriteReg(GATE_SCAN_CONTROL_0X6A, 0x0000); /* set scrolling line */
+    LCD_WriteReg(GATE_SCAN_CONTROL_0X61, GATE_SCAN_VLE | GATE_SCAN_REV); /* NDL,VLE, REV */
+    LCD_SetScroll(0); /* set scrolling line */
 
     /* Partial Display Control */
     LCD_WriteReg(PART_IMAGE_1_DISPLAY_POS, 0x0000);
@@ -505,100 +1402,52 @@ void LCD_Init(bool usingTP)
     LCD_WriteReg(PANEL_ITERFACE_CONTROL_2, 0x0600);
     LCD_WriteReg(DISPLAY_CONTROL_1, 0x0133); /* 262K color and display ON */
     Delay(50); /* delay 50 ms */
+    LCD_BUS_RELEASE();
 
     LCD_Clear(LCD_BLACK);
 }
 
+/*******************************************************************************
+ * Function Name  : TP_ReadChannel
+ * Description    : One 12 bit conversion of the touch controller
+ * Input          : - command: CHX or CHY
+ * Output         : None
+ * Return         : Raw reading, 0 to 4095
+ * Attention      : Data comes back as 16 bits in 2 bytes, bits 11:5 then 4:0
+ *                  followed by 3 zero bits
+ *******************************************************************************/
+uint16_t TP_ReadChannel(uint8_t command)
+{
+    TP_BUS_ACQUIRE();
+    SPI_CS_TP_LOW;  //CS low for the touch panel
+    SPISendRecvByte(command);    //Acquire
+    uint8_t top_half_data = SPISendRecvByte(0);
+    uint8_t bottom_half_data = SPISendRecvByte(0);
+    SPI_CS_TP_HIGH; //CS high for touch panel
+    TP_BUS_RELEASE();
+
+    return (((uint16_t) top_half_data) << 5) | (((uint16_t) bottom_half_data) >> 3);
+}
+
 /*******************************************************************************
  * Function Name  : TP_ReadXY
  * Description    : Obtain X and Y touch coordinates
  * Input          : None
  * Output         : None
  * Return         : Pointer to "Point" structure
- * Attention      : None
+ * Attention      : One unfiltered reading mapped with TouchCal_Default,
+ *                  Touch.h has the filtered, interrupt driven version
  *******************************************************************************/
 Point TP_ReadXY()
 {
-    Point XY;   //Output data :)
-    SPI_CS_TP_LOW;  //CS low for the touch panel
-    uint8_t junk;   //Dont really care about what comes back (maybe)
-    junk = SPISendRecvByte(CHX);    //Acquire
-
-    //So Data is returned as a 16 bit package received in 2 batches
-    //But the actual data is only 12 bits
-    //The first package is bits 11:5
-    //The second package is bits 4:0
-    //So Position: [15 14 13 12 11 10 9 8 7 6 5 4 3 2 1 0]
-    //             [XX 11 10  9  8  7 6 5]
-    //                                   [4 3 2 1 0 X X X] (because zero filled)
-    //We need to OR them together but that requires making them 16 bits
-    //And to save them in the proper place, they must be shifted correctly
-    //[15 14 13 12 11 10 9 8 7 6 5 4 3 2 1 0]
-    //[XX XX XX XX XX XX X X X1110 9 8 7 6 5] Shift left by 5
-    //[XX XX XX XX XX XX x X 4 3 2 1 0 X X X] Shift right by 3
-    uint8_t top_half_data;
-    uint8_t bottom_half_data;
-    top_half_data = SPISendRecvByte(0);
-    bottom_half_data = SPISendRecvByte(0);
-    SPI_CS_TP_HIGH; //CS high for touch panel
-    uint16_t complete_data; //Our correctly formatted data
-    complete_data = (((uint16_t) top_half_data) << 5) | (((uint16_t) bottom_half_data) >> 3);
-
-    //Now we need to convert the data to fit our LCD (because our LCD isnt as big or accurate)
-    float real_data;
-    real_data = (float) complete_data;
-    //So our data is 12 bits so it goes 4095:0
-    //We want to convert it to between 1:0
-    //Then multiply it by the max screen size for X. This gives the right coordinate
-    real_data = real_data/4095; //Because untouched is 4095
-    real_data = real_data * MAX_SCREEN_X;
-//    real_data = (real_data - 35) * (1.1636363636363636363636363636364);
-    real_data = (real_data-30) * 1.1428571428571428571428571428571;
-//    if(real_data > 160){
-//        real_data = real_data + 10;
-//    }
-//    else{
-//        real_data = real_data-30;
-//    }
-    XY.x = (uint16_t) real_data;
-
-    //NOW FOR YYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYYY
-    SPI_CS_TP_LOW;  //CS low for the touch panel
-    junk = SPISendRecvByte(CHY);    //Acquire
-
-    //So Data is returned as a 16 bit package received in 2 batches
-    //But the actual data is only 12 bits
-    //The first package is bits 11:5
-    //The second package is bits 4:0
-    //So Position: [15 14 13 12 11 10 9 8 7 6 5 4 3 2 1 0]
-    //             [XX 11 10  9  8  7 6 5]
-    //                                   [4 3 2 1 0 X X X] (because zero filled)
-    //We need to OR them together but that requires making them 16 bits
-    //And to save them in the proper place, they must be shifted correctly
-    //[15 14 13 12 11 10 9 8 7 6 5 4 3 2 1 0]
-    //[XX XX XX XX XX XX X X X1110 9 8 7 6 5] Shift left by 5
-    //[XX XX XX XX XX XX x X 4 3 2 1 0 X X X] Shift right by 3
-
-    top_half_data = SPISendRecvByte(0);
-    bottom_half_data = SPISendRecvByte(0);
-    SPI_CS_TP_HIGH; //CS high for touch panel
-    complete_data = (((uint16_t) top_half_data) << 5) | (((uint16_t) bottom_half_data) >> 3);
-    //Now we need to convert the data to fit our LCD (because our LCD isnt as big or accurate)
-    //So our data is 12 bits so it goes 4095:0
-    //We want to convert it to between 1:0
-    //Then multiply it by the max screen size for Y. This gives the right coordinate
-    real_data = (float) complete_data;
-    real_data = real_data/4095;
-    real_data = real_data * MAX_SCREEN_Y;
-    real_data = (real_data - 14) * (1.1009174311926605504587155963303);
-//    if(real_data > 120){
-//        real_data = real_data + 8;
-//    }
-//    else{
-//        real_data = real_data - 10;
-//    }
-    XY.y = (uint16_t) real_data;
-
+    TouchPoint_t raw, screen;
+    raw.x = TP_ReadChannel(CHX);
+    raw.y = TP_ReadChannel(CHY);
+    TouchCal_Apply(&TouchCal_Default, &raw, &screen);
+
+    Point XY;
+    XY.x = screen.x;
+    XY.y = screen.y;
     return XY;
 }
 
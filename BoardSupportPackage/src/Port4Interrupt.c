@@ -0,0 +1,81 @@
+/*
+ * Port4Interrupt.c
+ *
+ * Shared PORT4 interrupt vector
+ *  - The touch controller (P4.0 PENIRQ) and the joystick button (P4.3) both interrupt on PORT4,
+ *    the vector can only hold one handler so every pin handler is registered here instead
+ *  - The dispatcher calls the handler of every pin that is flagged and enabled,
+ *    a handler clears the IFG bits of its own pins
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "msp.h"
+#include "Port4Interrupt.h"
+#include "G8RTOS.h"
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+typedef struct Port4Handler_t{
+    uint8_t Pins;
+    void (*Handler)(void);
+} Port4Handler_t;
+
+static Port4Handler_t Handlers[PORT4_MAX_HANDLERS];
+static volatile uint8_t NumHandlers = 0;
+
+/* Serializes registrations, the dispatcher itself never waits on it */
+static semaphore_t Registering = 1;
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*
+ * PORT4 interrupt, hands every flagged and enabled pin to its handler
+ */
+static void Port4_Dispatch()
+{
+    uint8_t pending = P4->IFG & P4->IE;
+    uint8_t i;
+    for(i = 0; i < NumHandlers; i++){
+        if(pending & Handlers[i].Pins){
+            Handlers[i].Handler();
+        }
+    }
+}
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Adds the handler of one or more PORT4 pins, the first call takes the PORT4 vector
+ * Param "pins": BIT0 .. BIT7 mask the handler serves
+ * Param "handler": Runs in the PORT4 interrupt when one of the pins is flagged and enabled
+ * Returns: false if PORT4_MAX_HANDLERS are already registered or the vector could not be taken
+ */
+bool Port4_AddHandler(uint8_t pins, void (*handler)(void))
+{
+    G8RTOS_WaitSemaphore(&Registering);
+    if(NumHandlers == PORT4_MAX_HANDLERS){
+        G8RTOS_SignalSemaphore(&Registering);
+        return false;
+    }
+
+    //Entry first, the count store publishes it to the dispatcher in one go
+    Handlers[NumHandlers].Pins = pins;
+    Handlers[NumHandlers].Handler = handler;
+    NumHandlers++;
+
+    //Nothing dispatches before the vector is taken, so a failed first entry can simply go again
+    bool added = true;
+    if(NumHandlers == 1 && G8RTOS_AddAPeriodicEvent(Port4_Dispatch, PORT4_IRQ_PRIORITY, PORT4_IRQn) != NO_ERROR){
+        NumHandlers = 0;
+        added = false;
+    }
+    G8RTOS_SignalSemaphore(&Registering);
+    return added;
+}
+
+/*********************************************** Public Functions *********************************************************************/
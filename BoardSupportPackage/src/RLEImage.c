@@ -0,0 +1,78 @@
+/*
+ * RLEImage.c
+ *
+ * Decoder of the palette indexed RLE format, rows go out through the caller's blit
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "RLEImage.h"
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+static uint16_t DecodeBuffer[RLE_BUFFER_PIXELS];
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Draws an image, one caller at a time (the decode buffer is shared)
+ * Param "x", "y": Top left corner on the screen, the blit function clips
+ * Param "blit": Sends decoded rows (LCD_BlitRGB565 on the board)
+ * Returns: false if the data is corrupt or the image is too wide, drawing stops there
+ */
+bool RLEImage_Draw(const RLEImage_t *image, int16_t x, int16_t y, rle_Blit_t blit)
+{
+    if(image->Width == 0 || image->Width > RLE_BUFFER_PIXELS){
+        return false;
+    }
+
+    uint16_t rowsPerBlit = RLE_BUFFER_PIXELS / image->Width;
+    uint32_t blitPixels = (uint32_t)rowsPerBlit * image->Width;
+    uint32_t remaining = (uint32_t)image->Width * image->Height;
+    uint32_t filled = 0;
+    uint16_t row = 0;
+    uint32_t in = 0;
+
+    while(remaining > 0){
+        if(in >= image->DataSize){
+            return false;
+        }
+
+        //One packet, runs repeat one index, literals carry one per pixel
+        uint8_t header = image->Data[in++];
+        uint16_t count = (header & RLE_COUNT_MASK) + 1;
+        bool literal = (header & RLE_LITERAL) != 0;
+        if(count > remaining || in + (literal ? count : 1) > image->DataSize){
+            return false;
+        }
+        remaining -= count;
+
+        while(count > 0){
+            uint8_t index = image->Data[in];
+            if(index >= image->PaletteSize){
+                return false;
+            }
+            DecodeBuffer[filled++] = image->Palette[index];
+            if(literal){
+                in++;
+            }
+            count--;
+
+            //Buffer holds whole rows, send them in one window
+            if(filled == blitPixels || remaining + count == 0){
+                uint16_t rows = filled / image->Width;
+                blit(x, y + row, image->Width, rows, DecodeBuffer);
+                row += rows;
+                filled = 0;
+            }
+        }
+        if(!literal){
+            in++;
+        }
+    }
+    return true;
+}
+
+/*********************************************** Public Functions *********************************************************************/
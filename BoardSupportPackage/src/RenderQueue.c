@@ -0,0 +1,113 @@
+/*
+ * RenderQueue.c
+ *
+ * Ring buffer and coalescing of queued drawing commands
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "RenderQueue.h"
+#include "LCD_empty.h"
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*
+ * Area a command paints over completely (x, y, w, h)
+ * Returns: false if it has no simple area (text that wraps onto the next line)
+ */
+static bool PaintedArea(const RenderCmd_t *cmd, int32_t *x, int32_t *y, int32_t *w, int32_t *h)
+{
+    *x = cmd->x;
+    *y = cmd->y;
+    *w = cmd->w;
+    *h = cmd->h;
+
+    if(cmd->Type == RENDER_CLEAR){
+        *x = 0;
+        *y = 0;
+        *w = MAX_SCREEN_X;
+        *h = MAX_SCREEN_Y;
+    }
+    else if(cmd->Type == RENDER_TEXT){
+        *w = strlen(cmd->Text) * LCD_CHAR_WIDTH;
+        *h = LCD_CHAR_HEIGHT;
+        if(*x + *w > MAX_SCREEN_X){
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Returns true if "later" paints over every pixel "earlier" paints
+ */
+static bool PaintsOver(const RenderCmd_t *later, const RenderCmd_t *earlier)
+{
+    int32_t lx, ly, lw, lh;
+    int32_t ex, ey, ew, eh;
+    if(!PaintedArea(later, &lx, &ly, &lw, &lh) || !PaintedArea(earlier, &ex, &ey, &ew, &eh)){
+        return false;
+    }
+    return (lx <= ex) && (ex + ew <= lx + lw) && (ly <= ey) && (ey + eh <= ly + lh);
+}
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Empties the queue and clears its counters
+ */
+void RenderQueue_Init(RenderQueue_t *queue)
+{
+    queue->Head = 0;
+    queue->Count = 0;
+    queue->Coalesced = 0;
+    queue->Rejected = 0;
+}
+
+/*
+ * Queues a command behind the pending ones
+ *  - Pending commands at the back that the new one paints over completely are dropped first
+ * Returns: false if the queue is full
+ */
+bool RenderQueue_Push(RenderQueue_t *queue, const RenderCmd_t *cmd)
+{
+    //Only the back of the queue can go, anything older may sit under a command in between
+    while(queue->Count > 0){
+        uint16_t newest = (queue->Head + queue->Count - 1) % RENDER_QUEUE_SIZE;
+        if(cmd->Type != RENDER_CLEAR && !PaintsOver(cmd, &queue->Cmds[newest])){
+            break;
+        }
+        queue->Count--;
+        queue->Coalesced++;
+    }
+
+    if(queue->Count == RENDER_QUEUE_SIZE){
+        queue->Rejected++;
+        return false;
+    }
+
+    queue->Cmds[(queue->Head + queue->Count) % RENDER_QUEUE_SIZE] = *cmd;
+    queue->Count++;
+    return true;
+}
+
+/*
+ * Takes the oldest pending command
+ * Returns: false if nothing is pending
+ */
+bool RenderQueue_Pop(RenderQueue_t *queue, RenderCmd_t *cmd)
+{
+    if(queue->Count == 0){
+        return false;
+    }
+
+    *cmd = queue->Cmds[queue->Head];
+    queue->Head = (queue->Head + 1) % RENDER_QUEUE_SIZE;
+    queue->Count--;
+    return true;
+}
+
+/*********************************************** Public Functions *********************************************************************/
@@ -0,0 +1,236 @@
+/*
+ * SPIBus.c
+ *
+ * Arbiter for EUSCI_B3, shared by the LCD (CS P10.4) and the touch controller (CS P10.5)
+ *  - Every device has its own eUSCI configuration (clock, phase, polarity), it is loaded
+ *    whenever the bus changes hands
+ *  - A thread holds the bus from Acquire to Release, chip selects are only toggled in between.
+ *    Acquire nests for the thread that already holds it
+ *  - Release and Yield pass the bus straight to the waiting device of highest priority,
+ *    waiters of one device take turns
+ *  - Long holders (LCD fills) call SPIBus_Yield at safe points so a waiting device of
+ *    higher priority (touch reads) slots in between their DMA chunks, the bus then comes
+ *    back to the yielding thread before any other waiter of its device
+ *  - Before G8RTOS_Launch there is only one caller, Acquire then just loads the configuration
+ *  - Privileged threads only, the arbiter state is read only to protected threads
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "msp.h"
+#include "driverlib.h"
+#include "SPIBus.h"
+#include "G8RTOS.h"
+#include "G8RTOS_SVC.h"
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+typedef struct SPIBusDevice_t{
+    eUSCI_SPI_MasterConfig Config;
+    uint8_t Priority;
+    uint16_t Waiting;           //Threads blocked in Acquire for this device
+    semaphore_t Granted;        //Signalled once for every waiter the bus is handed to
+    bool Yielded;               //The holder gave the bus away in SPIBus_Yield and wants it back
+    semaphore_t Resumed;        //Signalled when the bus goes back to it
+} SPIBusDevice_t;
+
+static SPIBusDevice_t Devices[SPIBUS_DEVICES];
+
+/* Someone holds the bus or it is on its way to a waiter */
+static bool Busy = false;
+
+/* Guards Busy and the waiter bookkeeping, only ever held for a few lines */
+static semaphore_t StateLock = 1;
+
+static threadId_t Owner;
+static uint16_t Depth = 0;
+
+/* Device whose configuration is loaded in EUSCI_B3 */
+static int16_t Loaded = -1;
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*
+ * Loads the configuration of a device if another one is loaded
+ */
+static bool Configure(spiBusDevice_t device)
+{
+    if(Loaded == device){
+        return false;
+    }
+    SPI_disableModule(EUSCI_B3_BASE);
+    SPI_initMaster(EUSCI_B3_BASE, &Devices[device].Config);
+    SPI_enableModule(EUSCI_B3_BASE);
+    Loaded = device;
+    return true;
+}
+
+/*
+ * Only threads of a running kernel have anyone to share the bus with
+ */
+static bool Arbitrated()
+{
+    return G8RTOS_IsRunning() && G8RTOS_InThreadMode();
+}
+
+/*
+ * Returns: Device the bus goes to next, -1 if nobody wants it. Call with StateLock held
+ */
+static int16_t NextDevice()
+{
+    int16_t next = -1;
+    uint16_t i;
+    for(i = 0; i < SPIBUS_DEVICES; i++){
+        if((Devices[i].Waiting > 0 || Devices[i].Yielded) &&
+           (next < 0 || Devices[i].Priority < Devices[next].Priority)){
+            next = i;
+        }
+    }
+    return next;
+}
+
+/*
+ * Gives the held bus to the next device, or frees it if nobody waits
+ */
+static void HandOver()
+{
+    semaphore_t *grant = 0;
+
+    G8RTOS_WaitSemaphore(&StateLock);
+    int16_t next = NextDevice();
+    if(next < 0){
+        Busy = false;
+    }
+    else if(Devices[next].Yielded){
+        Devices[next].Yielded = false;
+        grant = &Devices[next].Resumed;
+    }
+    else{
+        Devices[next].Waiting--;
+        grant = &Devices[next].Granted;
+    }
+    G8RTOS_SignalSemaphore(&StateLock);
+
+    //Busy stays set, nobody else can take the bus before the waiter runs
+    if(grant){
+        G8RTOS_SignalSemaphore(grant);
+    }
+}
+
+/*
+ * Takes the bus if it is free, otherwise blocks until it is handed to this device
+ */
+static void WaitForBus(spiBusDevice_t device)
+{
+    bool wait = true;
+
+    G8RTOS_WaitSemaphore(&StateLock);
+    if(!Busy){
+        Busy = true;
+        wait = false;
+    }
+    else{
+        Devices[device].Waiting++;
+    }
+    G8RTOS_SignalSemaphore(&StateLock);
+
+    if(wait){
+        G8RTOS_WaitSemaphore(&Devices[device].Granted);
+    }
+    Owner = G8RTOS_GetThreadId();
+}
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Registers a device, call before G8RTOS_Launch (LCD_Init does it for both devices)
+ * Param "config": eUSCI settings of the device, copied
+ * Param "priority": SPIBUS_PRIORITY_*
+ */
+void SPIBus_InitDevice(spiBusDevice_t device, const eUSCI_SPI_MasterConfig *config, uint8_t priority)
+{
+    Devices[device].Config = *config;
+    Devices[device].Priority = priority;
+    Devices[device].Waiting = 0;
+    Devices[device].Granted = 0;
+    Devices[device].Yielded = false;
+    Devices[device].Resumed = 0;
+    if(Loaded == device){
+        Loaded = -1;    //New settings get loaded on the next Acquire
+    }
+}
+
+/*
+ * Waits for the bus and loads the configuration of the device, threads only once the kernel runs
+ */
+void SPIBus_Acquire(spiBusDevice_t device)
+{
+    if(Arbitrated()){
+        if(Depth > 0 && Owner == G8RTOS_GetThreadId()){
+            Depth++;
+            return;
+        }
+        WaitForBus(device);
+        Depth = 1;
+    }
+    Configure(device);
+}
+
+/*
+ * Gives the bus up (after the matching number of Acquires), CS of the device must be high
+ */
+void SPIBus_Release(spiBusDevice_t device)
+{
+    if(!Arbitrated() || Depth == 0){
+        return;
+    }
+    if(--Depth == 0){
+        HandOver();
+    }
+}
+
+/*
+ * Returns: true if a device of higher priority than "device" is waiting for the bus
+ */
+bool SPIBus_Contended(spiBusDevice_t device)
+{
+    uint16_t i;
+    for(i = 0; i < SPIBUS_DEVICES; i++){
+        if(Devices[i].Waiting > 0 && Devices[i].Priority < Devices[device].Priority){
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Lets waiting devices of higher priority use the bus, then takes it back
+ *  - The bus returns to this thread before other threads of the same device,
+ *    a call in progress (and its LCD_Perf count) is never interleaved with another one
+ *  - Call with CS high, the device has to restart its transfer afterwards
+ * Returns: true if the bus changed hands (and the device configuration was reloaded)
+ */
+bool SPIBus_Yield(spiBusDevice_t device)
+{
+    if(!Arbitrated() || Depth == 0 || !SPIBus_Contended(device)){
+        return false;
+    }
+
+    //Only devices of higher priority are ahead of the yielded holder, they are waiting already
+    uint16_t depth = Depth;
+    Depth = 0;
+    Devices[device].Yielded = true;
+    HandOver();
+
+    G8RTOS_WaitSemaphore(&Devices[device].Resumed);
+    Owner = G8RTOS_GetThreadId();
+    Depth = depth;
+    Configure(device);
+    return true;
+}
+
+/*********************************************** Public Functions *********************************************************************/
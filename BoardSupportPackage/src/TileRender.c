@@ -0,0 +1,112 @@
+/*
+ * TileRender.c
+ *
+ * Tile compositing of the game scene, sprite order decides what ends up on top
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "TileRender.h"
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*
+ * Draws the part of a sprite that falls inside the area into "out"
+ */
+static void ComposeSprite(const Sprite_t *sprite, int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t *out)
+{
+    //Intersection of the sprite and the area
+    int16_t xStart = (sprite->x > x) ? sprite->x : x;
+    int16_t yStart = (sprite->y > y) ? sprite->y : y;
+    int16_t xEnd = ((sprite->x + sprite->w) < (x + w)) ? (sprite->x + sprite->w) : (x + w);
+    int16_t yEnd = ((sprite->y + sprite->h) < (y + h)) ? (sprite->y + sprite->h) : (y + h);
+
+    int16_t i, j;
+    for(j = yStart; j < yEnd; j++){
+        uint16_t *row = out + (j - y) * w;
+        if(sprite->Pixels == 0){
+            for(i = xStart; i < xEnd; i++){
+                row[i - x] = sprite->Color;
+            }
+        }
+        else{
+            const uint16_t *source = sprite->Pixels + (j - sprite->y) * sprite->w;
+            for(i = xStart; i < xEnd; i++){
+                uint16_t pixel = source[i - sprite->x];
+                if(pixel != sprite->Transparent){
+                    row[i - x] = pixel;
+                }
+            }
+        }
+    }
+}
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Starts an empty scene
+ * Param "background": Color under every sprite
+ * Param "blit": Sends a finished tile (LCD_BlitRGB565 on the board)
+ */
+void TileRender_Init(Scene_t *scene, uint16_t background, tile_Blit_t blit)
+{
+    scene->Count = 0;
+    scene->Background = background;
+    scene->Blit = blit;
+}
+
+/*
+ * Puts a sprite on top of the ones already in the scene
+ * Returns: false if the scene is full
+ */
+bool TileRender_AddSprite(Scene_t *scene, Sprite_t *sprite)
+{
+    if(scene->Count == MAX_SPRITES){
+        return false;
+    }
+    scene->Sprites[scene->Count++] = sprite;
+    return true;
+}
+
+/*
+ * Composites one area of the scene into "out" (w x h, row after row)
+ *  - w * h must not be more than TILE_SIZE * TILE_SIZE
+ */
+void TileRender_Compose(Scene_t *scene, int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t *out)
+{
+    uint32_t i;
+    for(i = 0; i < (uint32_t)w * h; i++){
+        out[i] = scene->Background;
+    }
+
+    //Bottom to top, whatever is drawn last ends up on screen
+    for(i = 0; i < scene->Count; i++){
+        Sprite_t *sprite = scene->Sprites[i];
+        if(sprite->Visible &&
+           sprite->x < x + w && x < sprite->x + sprite->w &&
+           sprite->y < y + h && y < sprite->y + sprite->h){
+            ComposeSprite(sprite, x, y, w, h, out);
+        }
+    }
+}
+
+/*
+ * Repaints an area of the screen from the scene (corners inclusive)
+ *  - Walks the area one tile at a time, each tile is composited then blitted in one burst
+ */
+void TileRender_Draw(Scene_t *scene, int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd)
+{
+    int16_t x, y;
+    for(y = yStart; y <= yEnd; y += TILE_SIZE){
+        uint16_t h = ((yEnd - y + 1) < TILE_SIZE) ? (yEnd - y + 1) : TILE_SIZE;
+        for(x = xStart; x <= xEnd; x += TILE_SIZE){
+            uint16_t w = ((xEnd - x + 1) < TILE_SIZE) ? (xEnd - x + 1) : TILE_SIZE;
+            TileRender_Compose(scene, x, y, w, h, scene->Tile);
+            scene->Blit(x, y, w, h, scene->Tile);
+        }
+    }
+}
+
+/*********************************************** Public Functions *********************************************************************/
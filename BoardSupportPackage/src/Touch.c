@@ -0,0 +1,207 @@
+/*
+ * Touch.c
+ *
+ * Interrupt driven touch panel input
+ *  - The P4.0 pen down interrupt wakes Touch_Thread, nothing is read while nobody touches
+ *  - Every TOUCH_SAMPLE_MS while the pen is down a burst of TOUCH_OVERSAMPLE X/Y readings
+ *    is taken, median and IIR filtered (TouchFilter) and calibrated in fixed point
+ *  - Down, move and up events go to a G8RTOS FIFO, read them with Touch_ReadEvent
+ *  - Needs LCD_Init(true) first, PENIRQ shares the PORT4 vector through Port4Interrupt
+ *  - Reads go through SPIBus, a burst slots in between the DMA slices of a long LCD fill
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "msp.h"
+#include "Touch.h"
+#include "LCD_empty.h"
+#include "SPIBus.h"
+#include "Port4Interrupt.h"
+#include "G8RTOS.h"
+
+/*********************************************** Defines ******************************************************************************/
+
+/* PENIRQ is P4.0, IE/IFG are written through bit-band so the joystick button's bits on P4 are never lost */
+#define PENIRQ_BIT 0
+
+/*********************************************** Defines ******************************************************************************/
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+/* Signaled by the pen down interrupt */
+static semaphore_t PenDown;
+
+static uint32_t EventFIFO;
+static TouchCal_t Calibration;
+
+/* Touch_SetCalibration may run in another thread while the touch thread applies it */
+static semaphore_t CalibrationLock = 1;
+static uint32_t LostEvents = 0;
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*
+ * PENIRQ is low while the panel is pressed
+ */
+static bool PenIsDown()
+{
+    return (P4->IN & BIT0) == 0;
+}
+
+/*
+ * Pen down interrupt, masks itself until the touch thread is done with the touch
+ */
+static void Touch_PenDownHandler()
+{
+    if(P4->IFG & BIT0){
+        BITBAND_PERI(P4->IE, PENIRQ_BIT) = 0;
+        BITBAND_PERI(P4->IFG, PENIRQ_BIT) = 0;
+        G8RTOS_SignalSemaphore(&PenDown);
+    }
+}
+
+/*
+ * Takes one oversampled burst and returns the median of each axis
+ * Returns: false if the pen was lifted during the burst (the readings are not trusted)
+ */
+static bool SampleBurst(uint16_t *rawX, uint16_t *rawY)
+{
+    uint16_t xs[TOUCH_OVERSAMPLE];
+    uint16_t ys[TOUCH_OVERSAMPLE];
+    uint16_t i;
+
+    //One bus hold for the burst, the reads nest inside it
+    SPIBus_Acquire(SPIBUS_TOUCH);
+    for(i = 0; i < TOUCH_OVERSAMPLE; i++){
+        xs[i] = TP_ReadChannel(CHX);
+        ys[i] = TP_ReadChannel(CHY);
+    }
+    SPIBus_Release(SPIBUS_TOUCH);
+    if(!PenIsDown()){
+        return false;
+    }
+
+    *rawX = TouchFilter_Median(xs, TOUCH_OVERSAMPLE);
+    *rawY = TouchFilter_Median(ys, TOUCH_OVERSAMPLE);
+    return true;
+}
+
+/*
+ * Queues an event, dropped (and counted) if the reader is behind
+ */
+static void PostEvent(touchEventType_t type, const TouchPoint_t *point)
+{
+    if(writeFIFO(EventFIFO, TOUCH_EVENT_PACK(type, point->x, point->y)) < 0){
+        LostEvents++;
+    }
+}
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Sets up the event FIFO and the pen down interrupt, call before the touch thread is added
+ * Param "fifo": G8RTOS FIFO the events go to
+ * Returns: false if the pen down handler could not be added
+ */
+bool Touch_Init(uint32_t fifo)
+{
+    EventFIFO = fifo;
+    G8RTOS_InitFIFO(fifo);
+    G8RTOS_InitSemaphore(&PenDown, 0);
+    Calibration = TouchCal_Default;
+
+    P4->IES |= BIT0;        //Falling edge, PENIRQ goes low on a touch
+    if(!Port4_AddHandler(BIT0, Touch_PenDownHandler)){
+        return false;
+    }
+    BITBAND_PERI(P4->IFG, PENIRQ_BIT) = 0;
+    BITBAND_PERI(P4->IE, PENIRQ_BIT) = 1;
+    return true;
+}
+
+/*
+ * Touch thread, add it with G8RTOS_AddThread
+ *  - Sleeps on the pen down interrupt, samples while the pen is down
+ */
+void Touch_Thread()
+{
+    TouchIIR_t filter;
+
+    while(1){
+        G8RTOS_WaitSemaphore(&PenDown);
+
+        TouchFilter_Reset(&filter);
+        TouchPoint_t last;
+        bool touching = false;
+
+        while(PenIsDown()){
+            uint16_t rawX, rawY;
+            if(SampleBurst(&rawX, &rawY)){
+                TouchPoint_t raw, screen;
+                TouchFilter_Update(&filter, rawX, rawY, &raw);
+                G8RTOS_WaitSemaphore(&CalibrationLock);
+                TouchCal_Apply(&Calibration, &raw, &screen);
+                G8RTOS_SignalSemaphore(&CalibrationLock);
+
+                //Only real moves are worth an event
+                if(!touching){
+                    PostEvent(TOUCH_DOWN, &screen);
+                    touching = true;
+                }
+                else if(screen.x != last.x || screen.y != last.y){
+                    PostEvent(TOUCH_MOVE, &screen);
+                }
+                last = screen;
+            }
+            sleep(TOUCH_SAMPLE_MS);
+        }
+
+        if(touching){
+            PostEvent(TOUCH_UP, &last);
+        }
+
+        //Rearm, a touch that came back before this never made an edge so raise it by hand
+        BITBAND_PERI(P4->IFG, PENIRQ_BIT) = 0;
+        BITBAND_PERI(P4->IE, PENIRQ_BIT) = 1;
+        if(PenIsDown()){
+            BITBAND_PERI(P4->IFG, PENIRQ_BIT) = 1;
+        }
+    }
+}
+
+/*
+ * Replaces the calibration (TouchCal_Default until then)
+ */
+void Touch_SetCalibration(const TouchCal_t *cal)
+{
+    G8RTOS_WaitSemaphore(&CalibrationLock);
+    Calibration = *cal;
+    G8RTOS_SignalSemaphore(&CalibrationLock);
+}
+
+/*
+ * Waits for the next event
+ */
+TouchEvent_t Touch_ReadEvent()
+{
+    int32_t packed = readFIFO(EventFIFO);
+    TouchEvent_t event;
+    event.Type = (touchEventType_t)((packed >> 24) & 0xFF);
+    event.x = (packed >> 12) & 0xFFF;
+    event.y = packed & 0xFFF;
+    return event;
+}
+
+/*
+ * Returns: Events dropped because the FIFO was full
+ */
+uint32_t Touch_GetLostEvents()
+{
+    return LostEvents;
+}
+
+/*********************************************** Public Functions *********************************************************************/
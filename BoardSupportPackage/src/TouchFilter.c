@@ -0,0 +1,136 @@
+/*
+ * TouchFilter.c
+ *
+ * Median, IIR and affine calibration arithmetic of the touch readings
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "TouchFilter.h"
+#include "LCD_empty.h"
+
+/*********************************************** Public Data **************************************************************************/
+
+/*
+ * x = (raw / 4095 * 320 - 30) * 8 / 7
+ * y = (raw / 4095 * 240 - 14) * 1.1009
+ */
+const TouchCal_t TouchCal_Default = {
+    5853, 0, -2246949,
+    0, 4229, -1010096
+};
+
+/*********************************************** Public Data **************************************************************************/
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*
+ * One coordinate of the calibration, rounded and clamped to [0, limit)
+ */
+static int32_t ApplyAxis(int32_t a, int32_t b, int32_t c, const TouchPoint_t *raw, int32_t limit)
+{
+    int64_t value = (int64_t)a * raw->x + (int64_t)b * raw->y + c + (1 << (TOUCH_CAL_SHIFT - 1));
+    value >>= TOUCH_CAL_SHIFT;
+    if(value < 0){
+        return 0;
+    }
+    return (value >= limit) ? (limit - 1) : (int32_t)value;
+}
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Median of a burst, the samples are sorted in place
+ * Param "count": 1 to TOUCH_MAX_SAMPLES
+ */
+uint16_t TouchFilter_Median(uint16_t *samples, uint16_t count)
+{
+    //Insertion sort, a burst is a handful of samples
+    uint16_t i, j;
+    for(i = 1; i < count; i++){
+        uint16_t sample = samples[i];
+        for(j = i; j > 0 && samples[j - 1] > sample; j--){
+            samples[j] = samples[j - 1];
+        }
+        samples[j] = sample;
+    }
+    return samples[count / 2];
+}
+
+/*
+ * Starts a new touch, the next burst is taken as it is
+ */
+void TouchFilter_Reset(TouchIIR_t *filter)
+{
+    filter->Primed = false;
+}
+
+/*
+ * Adds the medians of one burst
+ * Param "filtered": Returns the smoothed raw reading
+ */
+void TouchFilter_Update(TouchIIR_t *filter, uint16_t rawX, uint16_t rawY, TouchPoint_t *filtered)
+{
+    int32_t x = (int32_t)rawX << TOUCH_IIR_FRACTION;
+    int32_t y = (int32_t)rawY << TOUCH_IIR_FRACTION;
+
+    if(!filter->Primed){
+        filter->X = x;
+        filter->Y = y;
+        filter->Primed = true;
+    }
+    else{
+        filter->X += (x - filter->X) >> TOUCH_IIR_SHIFT;
+        filter->Y += (y - filter->Y) >> TOUCH_IIR_SHIFT;
+    }
+
+    filtered->x = (filter->X + (1 << (TOUCH_IIR_FRACTION - 1))) >> TOUCH_IIR_FRACTION;
+    filtered->y = (filter->Y + (1 << (TOUCH_IIR_FRACTION - 1))) >> TOUCH_IIR_FRACTION;
+}
+
+/*
+ * Solves the calibration from three touches of known screen points
+ *  - The points should be far apart and not on one line (corners and the center edge work well)
+ * Param "screen": Where the three targets were drawn
+ * Param "raw": Filtered readings taken while each target was touched
+ * Returns: false if the points are on one line, "cal" is left untouched
+ */
+bool TouchCal_Compute(const TouchPoint_t screen[3], const TouchPoint_t raw[3], TouchCal_t *cal)
+{
+    //Cramer's rule on the differences to the third point
+    int64_t rx0 = raw[0].x - raw[2].x, ry0 = raw[0].y - raw[2].y;
+    int64_t rx1 = raw[1].x - raw[2].x, ry1 = raw[1].y - raw[2].y;
+    int64_t det = rx0 * ry1 - rx1 * ry0;
+    if(det == 0){
+        return false;
+    }
+
+    int64_t sx0 = screen[0].x - screen[2].x, sx1 = screen[1].x - screen[2].x;
+    int64_t sy0 = screen[0].y - screen[2].y, sy1 = screen[1].y - screen[2].y;
+
+    int64_t a = ((sx0 * ry1 - sx1 * ry0) * (1 << TOUCH_CAL_SHIFT)) / det;
+    int64_t b = ((rx0 * sx1 - rx1 * sx0) * (1 << TOUCH_CAL_SHIFT)) / det;
+    int64_t d = ((sy0 * ry1 - sy1 * ry0) * (1 << TOUCH_CAL_SHIFT)) / det;
+    int64_t e = ((rx0 * sy1 - rx1 * sy0) * (1 << TOUCH_CAL_SHIFT)) / det;
+
+    cal->A = a;
+    cal->B = b;
+    cal->C = ((int64_t)screen[2].x * (1 << TOUCH_CAL_SHIFT)) - a * raw[2].x - b * raw[2].y;
+    cal->D = d;
+    cal->E = e;
+    cal->F = ((int64_t)screen[2].y * (1 << TOUCH_CAL_SHIFT)) - d * raw[2].x - e * raw[2].y;
+    return true;
+}
+
+/*
+ * Maps a raw reading to the screen, clamped to the screen edges
+ */
+void TouchCal_Apply(const TouchCal_t *cal, const TouchPoint_t *raw, TouchPoint_t *screen)
+{
+    screen->x = ApplyAxis(cal->A, cal->B, cal->C, raw, MAX_SCREEN_X);
+    screen->y = ApplyAxis(cal->D, cal->E, cal->F, raw, MAX_SCREEN_Y);
+}
+
+/*********************************************** Public Functions *********************************************************************/
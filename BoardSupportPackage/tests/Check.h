@@ -0,0 +1,28 @@
+/*
+ * Check.h
+ *
+ * Smallest possible test support for the host tests
+ *  - CHECK prints the failing condition with its line and counts it
+ *  - CHECK_DONE ends main, the exit status is the number of failures
+ */
+
+#ifndef BOARDSUPPORTPACKAGE_TESTS_CHECK_H_
+#define BOARDSUPPORTPACKAGE_TESTS_CHECK_H_
+
+#include <stdio.h>
+
+static int CheckFailures = 0;
+
+#define CHECK(condition) do{ \
+        if(!(condition)){ \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            CheckFailures++; \
+        } \
+    }while(0)
+
+#define CHECK_DONE(name) do{ \
+        printf("%s: %s\n", (name), CheckFailures ? "FAILED" : "ok"); \
+        return CheckFailures ? 1 : 0; \
+    }while(0)
+
+#endif /* BOARDSUPPORTPACKAGE_TESTS_CHECK_H_ */
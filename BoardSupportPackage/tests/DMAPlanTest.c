@@ -0,0 +1,122 @@
+/*
+ * DMAPlanTest.c
+ *
+ * Host test of the uDMA chunk planning
+ *  - Chunks of a stream add up to it, in order, and DMAPlan_Count agrees with them
+ *  - Chunk lengths are clipped to DMA_MAX_TRANSFER and kept even
+ *  - A repeated pattern starts every chunk at offset 0, only the last one is short
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Check.h"
+#include "DMAPlan.h"
+
+/*
+ * Walks a whole plan, checks the chunks follow each other and returns how many there were
+ */
+static uint32_t WalkPlan(uint32_t bytes, uint16_t maxChunk, bool repeat, uint16_t expectedChunk)
+{
+    DMAPlan_t plan;
+    uint32_t offset, position = 0, chunks = 0;
+    uint16_t chunk;
+
+    DMAPlan_Init(&plan, bytes, maxChunk, repeat);
+    while((chunk = DMAPlan_Next(&plan, &offset)) != 0){
+        CHECK(offset == (repeat ? 0 : position));
+        CHECK(chunk <= expectedChunk);
+        //Only the last chunk may be short
+        CHECK(chunk == expectedChunk || position + chunk == bytes);
+        position += chunk;
+        chunks++;
+    }
+    CHECK(position == bytes);
+    CHECK(DMAPlan_Next(&plan, &offset) == 0);
+    return chunks;
+}
+
+/*
+ * Streams over many chunks, DMAPlan_Count matches what DMAPlan_Next hands out
+ */
+static void TestCount()
+{
+    CHECK(DMAPlan_Count(0, 0) == 0);
+    CHECK(DMAPlan_Count(1, 0) == 1);
+    CHECK(DMAPlan_Count(DMA_MAX_TRANSFER, 0) == 1);
+    CHECK(DMAPlan_Count(DMA_MAX_TRANSFER + 1, 0) == 2);
+    CHECK(DMAPlan_Count(320 * 240 * 2, 0) == 150);
+    CHECK(DMAPlan_Count(320 * 240 * 2, 512) == 300);
+
+    const uint32_t lengths[] = {2, 1000, 1024, 1026, 4096, 5000, 153600};
+    const uint16_t limits[] = {0, 2, 512, 1000, 1024};
+    uint16_t i, j;
+    for(i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++){
+        for(j = 0; j < sizeof(limits) / sizeof(limits[0]); j++){
+            uint16_t expected = limits[j] ? limits[j] : DMA_MAX_TRANSFER;
+            CHECK(WalkPlan(lengths[i], limits[j], false, expected) == DMAPlan_Count(lengths[i], limits[j]));
+        }
+    }
+}
+
+/*
+ * Chunks never go past the uDMA limit and never split a pixel
+ */
+static void TestClip()
+{
+    CHECK(DMAPlan_Count(4096, 4000) == 4);      //Clipped to DMA_MAX_TRANSFER
+    CHECK(DMAPlan_Count(4096, 0xFFFF) == 4);
+    CHECK(DMAPlan_Count(1000, 333) == 4);       //332 byte chunks
+
+    DMAPlan_t plan;
+    uint32_t offset;
+    DMAPlan_Init(&plan, 5000, 4000, false);
+    CHECK(plan.MaxChunk == DMA_MAX_TRANSFER);
+    CHECK(DMAPlan_Next(&plan, &offset) == DMA_MAX_TRANSFER);
+
+    DMAPlan_Init(&plan, 1000, 333, false);
+    CHECK(plan.MaxChunk == 332);
+    CHECK(DMAPlan_Next(&plan, &offset) == 332);
+
+    WalkPlan(1000, 333, false, 332);
+    WalkPlan(1000, 333, true, 332);
+}
+
+/*
+ * A fill pattern is sent from its start every time
+ */
+static void TestRepeat()
+{
+    //Whole screen from the 512 byte pattern buffer
+    CHECK(WalkPlan(320 * 240 * 2, 512, true, 512) == 300);
+    CHECK(WalkPlan(1000, 512, true, 512) == 2);
+    CHECK(WalkPlan(7, 0, true, DMA_MAX_TRANSFER) == 1);
+}
+
+/*
+ * The last chunk carries whatever is left
+ */
+static void TestLastChunk()
+{
+    DMAPlan_t plan;
+    uint32_t offset;
+
+    DMAPlan_Init(&plan, 2 * DMA_MAX_TRANSFER + 6, 0, false);
+    CHECK(DMAPlan_Next(&plan, &offset) == DMA_MAX_TRANSFER && offset == 0);
+    CHECK(DMAPlan_Next(&plan, &offset) == DMA_MAX_TRANSFER && offset == DMA_MAX_TRANSFER);
+    CHECK(DMAPlan_Next(&plan, &offset) == 6 && offset == 2 * DMA_MAX_TRANSFER);
+    CHECK(DMAPlan_Next(&plan, &offset) == 0);
+
+    DMAPlan_Init(&plan, 600, 512, true);
+    CHECK(DMAPlan_Next(&plan, &offset) == 512 && offset == 0);
+    CHECK(DMAPlan_Next(&plan, &offset) == 88 && offset == 0);
+    CHECK(DMAPlan_Next(&plan, &offset) == 0);
+}
+
+int main()
+{
+    TestCount();
+    TestClip();
+    TestRepeat();
+    TestLastChunk();
+    CHECK_DONE("DMAPlan");
+}
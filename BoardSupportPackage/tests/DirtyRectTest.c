@@ -0,0 +1,178 @@
+/*
+ * DirtyRectTest.c
+ *
+ * Host test of DirtyRect against a reference framebuffer
+ *  - Every area is also painted straight into the reference in the order it was
+ *    added, the flushed region has to leave exactly the same picture behind
+ *  - Covered areas are dropped, touching areas of one color merge and a move
+ *    only repaints its edges
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Check.h"
+#include "DirtyRect.h"
+
+#define FB_W 64
+#define FB_H 48
+
+static uint16_t Reference[FB_H][FB_W];
+static uint16_t Screen[FB_H][FB_W];
+static uint32_t Draws;
+static uint32_t DrawnPixels;
+
+static void Paint(uint16_t fb[FB_H][FB_W], int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd, uint16_t color)
+{
+    int16_t x, y;
+    for(y = yStart; y <= yEnd; y++){
+        for(x = xStart; x <= xEnd; x++){
+            if(x >= 0 && x < FB_W && y >= 0 && y < FB_H){
+                fb[y][x] = color;
+            }
+        }
+    }
+}
+
+/* dirtyRect_Draw_t into the screen */
+static void Draw(int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd, uint16_t color)
+{
+    Paint(Screen, xStart, xEnd, yStart, yEnd, color);
+    Draws++;
+    DrawnPixels += (uint32_t)(xEnd - xStart + 1) * (yEnd - yStart + 1);
+}
+
+static void Reset(DirtyRegion_t *region)
+{
+    memset(Reference, 0, sizeof(Reference));
+    memset(Screen, 0, sizeof(Screen));
+    Draws = 0;
+    DrawnPixels = 0;
+    DirtyRect_Init(region, Draw);
+}
+
+/*
+ * Random adds and moves, the flushed picture matches the reference every time
+ */
+static void TestRandomFrames()
+{
+    static DirtyRegion_t region;
+    uint32_t frame;
+    srand(1);
+
+    for(frame = 0; frame < 5000; frame++){
+        Reset(&region);
+        int areas = rand() % 60;
+        int i;
+        for(i = 0; i < areas; i++){
+            uint16_t color = rand() % 3;
+            if(rand() % 3 == 0){
+                //A block already on screen moves, the reference erases and redraws it whole
+                int16_t w = 1 + rand() % 10, h = 1 + rand() % 6;
+                int16_t oldX = rand() % 50, oldY = rand() % 40;
+                int16_t newX = oldX + rand() % 13 - 6, newY = oldY + rand() % 9 - 4;
+                Paint(Reference, oldX, oldX + w - 1, oldY, oldY + h - 1, color);
+                DirtyRect_Add(&region, oldX, oldX + w - 1, oldY, oldY + h - 1, color);
+
+                Paint(Reference, oldX, oldX + w - 1, oldY, oldY + h - 1, 7);
+                Paint(Reference, newX, newX + w - 1, newY, newY + h - 1, color);
+                DirtyRect_AddMove(&region, oldX, oldY, newX, newY, w, h, color, 7);
+            }
+            else{
+                int16_t xStart = rand() % FB_W, yStart = rand() % FB_H;
+                int16_t xEnd = xStart + rand() % 12 - 2, yEnd = yStart + rand() % 12 - 2;
+                Paint(Reference, xStart, xEnd, yStart, yEnd, color);
+                DirtyRect_Add(&region, xStart, xEnd, yStart, yEnd, color);
+            }
+        }
+        DirtyRect_Flush(&region);
+
+        if(memcmp(Reference, Screen, sizeof(Screen)) != 0){
+            printf("frame %u differs from the reference\n", frame);
+            CheckFailures++;
+            return;
+        }
+    }
+}
+
+/*
+ * An area painted over completely is never drawn, touching areas of one color are drawn once
+ */
+static void TestCoalescing()
+{
+    static DirtyRegion_t region;
+
+    Reset(&region);
+    DirtyRect_Add(&region, 2, 5, 2, 5, 1);
+    DirtyRect_Add(&region, 0, 9, 0, 9, 2);
+    DirtyRect_Flush(&region);
+    CHECK(Draws == 1);
+    CHECK(Screen[3][3] == 2);
+
+    Reset(&region);
+    DirtyRect_Add(&region, 0, 9, 0, 9, 1);
+    DirtyRect_Add(&region, 10, 19, 0, 9, 1);
+    DirtyRect_Flush(&region);
+    CHECK(Draws == 1);
+    CHECK(DrawnPixels == 200);
+
+    //Different colors never merge
+    Reset(&region);
+    DirtyRect_Add(&region, 0, 9, 0, 9, 1);
+    DirtyRect_Add(&region, 10, 19, 0, 9, 2);
+    DirtyRect_Flush(&region);
+    CHECK(Draws == 2);
+}
+
+/*
+ * A short move repaints the two edge strips, not the whole block twice
+ */
+static void TestMove()
+{
+    static DirtyRegion_t region;
+
+    Reset(&region);
+    Paint(Screen, 10, 19, 10, 13, 5);
+    DirtyRect_AddMove(&region, 10, 10, 12, 10, 10, 4, 5, 0);
+    DirtyRect_Flush(&region);
+    CHECK(DrawnPixels == 2 * 2 * 4);
+
+    Paint(Reference, 12, 21, 10, 13, 5);
+    CHECK(memcmp(Reference, Screen, sizeof(Screen)) == 0);
+
+    //Far enough apart to not overlap, erased and drawn whole
+    Reset(&region);
+    DirtyRect_AddMove(&region, 0, 0, 30, 30, 4, 4, 5, 0);
+    DirtyRect_Flush(&region);
+    CHECK(DrawnPixels == 2 * 16);
+}
+
+/*
+ * More disjoint areas than the region holds, it flushes early and keeps the order
+ */
+static void TestFull()
+{
+    static DirtyRegion_t region;
+    int16_t i;
+
+    Reset(&region);
+    for(i = 0; i < MAX_DIRTY_RECTS + 8; i++){
+        int16_t x = (i % 16) * 4, y = (i / 16) * 4;
+        DirtyRect_Add(&region, x, x + 1, y, y + 1, i + 1);
+        Paint(Reference, x, x + 1, y, y + 1, i + 1);
+    }
+    CHECK(Draws > 0);
+    DirtyRect_Flush(&region);
+    CHECK(Draws == MAX_DIRTY_RECTS + 8);
+    CHECK(memcmp(Reference, Screen, sizeof(Screen)) == 0);
+}
+
+int main()
+{
+    TestRandomFrames();
+    TestCoalescing();
+    TestMove();
+    TestFull();
+    CHECK_DONE("DirtyRect");
+}
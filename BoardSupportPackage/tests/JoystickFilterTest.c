@@ -0,0 +1,161 @@
+/*
+ * JoystickFilterTest.c
+ *
+ * Host test of JoystickFilter with the default tuning
+ *  - Noise at rest is never reported, the deadzone is round, the response grows
+ *    with the deflection and is symmetric, full deflection reads OutputMax (512)
+ *  - Small drifts are held back by the change threshold, rest is always reported
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "Check.h"
+#include "JoystickFilter.h"
+
+/*
+ * ADC noise of about +-150 counts around the center never leaves rest
+ */
+static void TestRestNoise()
+{
+    JoystickFilter_t filter;
+    int16_t x, y;
+    uint16_t i, reports = 0;
+
+    JoystickFilter_Init(&filter, &JoystickFilter_DefaultConfig);
+    srand(1);
+    for(i = 0; i < 1000; i++){
+        if(JoystickFilter_Update(&filter, rand() % 301 - 150, rand() % 301 - 150, &x, &y)){
+            reports++;
+        }
+    }
+    CHECK(reports == 0);
+    CHECK(x == 0 && y == 0);
+}
+
+/*
+ * Round deadzone, a diagonal inside the radius is still rest
+ */
+static void TestDeadzone()
+{
+    const JoystickFilterConfig_t *config = &JoystickFilter_DefaultConfig;
+    int16_t x, y;
+
+    JoystickFilter_Shape(config, config->Deadzone, 0, &x, &y);
+    CHECK(x == 0 && y == 0);
+    JoystickFilter_Shape(config, 0, -config->Deadzone, &x, &y);
+    CHECK(x == 0 && y == 0);
+    JoystickFilter_Shape(config, 420, 420, &x, &y);     //Radius 594
+    CHECK(x == 0 && y == 0);
+    JoystickFilter_Shape(config, config->Deadzone + 100, 0, &x, &y);
+    CHECK(x > 0 && y == 0);
+}
+
+/*
+ * Never goes down as the stick goes out, the same on every axis and direction,
+ * expo keeps the middle of the throw below linear
+ */
+static void TestMonotonic()
+{
+    JoystickFilterConfig_t linear = JoystickFilter_DefaultConfig;
+    int16_t x, y, otherX, otherY;
+    int16_t previous = 0;
+    int32_t raw;
+
+    for(raw = 0; raw <= JOYSTICK_FILTER_FULL_SCALE; raw += 16){
+        JoystickFilter_Shape(&JoystickFilter_DefaultConfig, raw, 0, &x, &y);
+        CHECK(x >= previous);
+        previous = x;
+
+        JoystickFilter_Shape(&JoystickFilter_DefaultConfig, -raw, 0, &otherX, &otherY);
+        CHECK(otherX == -x);
+        JoystickFilter_Shape(&JoystickFilter_DefaultConfig, 0, raw, &otherX, &otherY);
+        CHECK(otherY == x && otherX == 0);
+    }
+
+    linear.Expo = 0;
+    JoystickFilter_Shape(&JoystickFilter_DefaultConfig, 4000, 0, &x, &y);
+    JoystickFilter_Shape(&linear, 4000, 0, &otherX, &otherY);
+    CHECK(x < otherX);
+}
+
+/*
+ * Full deflection reads OutputMax, no reading anywhere goes past it
+ */
+static void TestFullScale()
+{
+    const JoystickFilterConfig_t *config = &JoystickFilter_DefaultConfig;
+    JoystickFilter_t filter;
+    int16_t x, y;
+    int32_t rawX, rawY;
+    uint16_t i;
+
+    CHECK(config->OutputMax == 512);
+
+    JoystickFilter_Init(&filter, config);
+    for(i = 0; i < 8; i++){
+        JoystickFilter_Update(&filter, JOYSTICK_FILTER_FULL_SCALE, 0, &x, &y);
+    }
+    CHECK(x == 512 && y == 0);
+
+    JoystickFilter_Shape(config, -JOYSTICK_FILTER_FULL_SCALE, 0, &x, &y);
+    CHECK(x == -512);
+
+    //Corner of the square range is clamped onto the circle
+    JoystickFilter_Shape(config, JOYSTICK_FILTER_FULL_SCALE, JOYSTICK_FILTER_FULL_SCALE, &x, &y);
+    CHECK(x == y && x >= 360 && x <= 363);
+
+    for(rawX = -JOYSTICK_FILTER_FULL_SCALE; rawX <= JOYSTICK_FILTER_FULL_SCALE; rawX += 512){
+        for(rawY = -JOYSTICK_FILTER_FULL_SCALE; rawY <= JOYSTICK_FILTER_FULL_SCALE; rawY += 512){
+            JoystickFilter_Shape(config, rawX, rawY, &x, &y);
+            CHECK(abs(x) <= 512 && abs(y) <= 512);
+        }
+    }
+}
+
+/*
+ * A slow drift is only reported in steps of Threshold, coming back to rest always is
+ */
+static void TestThreshold()
+{
+    const JoystickFilterConfig_t *config = &JoystickFilter_DefaultConfig;
+    JoystickFilter_t filter;
+    int16_t x, y;
+    int16_t raw = 3000, reported = 0;
+    uint16_t i, changes = 0;
+
+    JoystickFilter_Init(&filter, config);
+    for(i = 0; i < 8; i++){
+        JoystickFilter_Update(&filter, raw, 0, &x, &y);
+    }
+    reported = x;
+
+    for(i = 0; i < 100; i++){
+        raw += 5;
+        if(JoystickFilter_Update(&filter, raw, 0, &x, &y)){
+            CHECK(abs(x - reported) >= config->Threshold);
+            reported = x;
+            changes++;
+        }
+        else{
+            CHECK(x == reported);
+        }
+    }
+    CHECK(changes > 0 && changes < 60);
+
+    //Back at the center is always reported, even if the last step is below the threshold
+    for(i = 0; i < 4; i++){
+        JoystickFilter_Update(&filter, 0, 0, &x, &y);
+    }
+    CHECK(x == 0 && y == 0);
+}
+
+int main()
+{
+    TestRestNoise();
+    TestDeadzone();
+    TestMonotonic();
+    TestFullScale();
+    TestThreshold();
+    CHECK_DONE("JoystickFilter");
+}
@@ -0,0 +1,229 @@
+/*
+ * LCDGoldenTest.c
+ *
+ * Golden image test of the LCD drawing primitives on the ILI9325 emulator
+ *  - Every scene starts from a fresh LCD_Init, draws and compares the screen with
+ *    its reference framebuffer in golden/, a crop of the screen stored as a binary PPM
+ *  - Everything outside the crop has to be as LCD_Init left it, stray writes fail too
+ *  - On a mismatch the drawn crop goes to build/<scene>.ppm to look at
+ *  - Run with --update to rewrite the references after an intended change
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "Check.h"
+#include "LCD_empty.h"
+#include "LCD_Emulator.h"
+
+#ifndef GOLDEN_DIR
+#define GOLDEN_DIR "golden"
+#endif
+#ifndef OUT_DIR
+#define OUT_DIR "build"
+#endif
+
+/* Largest crop, bytes of RGB */
+#define CROP_MAX_BYTES (MAX_SCREEN_X * MAX_SCREEN_Y * 3)
+
+typedef struct GoldenScene_t{
+    const char *Name;
+    uint16_t x;             //Crop that is compared with the reference
+    uint16_t y;
+    uint16_t w;
+    uint16_t h;
+    void (*Draw)(void);
+} GoldenScene_t;
+
+static uint16_t Initial[MAX_SCREEN_Y][MAX_SCREEN_X];
+
+/*********************************************** Scenes *******************************************************************************/
+
+static void DrawFillRect()
+{
+    LCD_DrawRectangle(10, 29, 20, 24, LCD_RED);         //Short, written pixel by pixel
+    LCD_DrawRectangle(30, 89, 30, 59, LCD_BLUE);        //Long enough for the uDMA
+    LCD_DrawRectangle(5, 5, 5, 5, LCD_GREEN);           //Single pixel
+    LCD_DrawRectangle(0, 95, 63, 63, LCD_YELLOW);       //Crop edge
+}
+
+static void DrawBlit()
+{
+    static uint16_t gradient[7 * 5];
+    static uint16_t checker[16 * 16];
+    uint16_t i;
+    for(i = 0; i < 7 * 5; i++){
+        gradient[i] = i * 1000;
+    }
+    for(i = 0; i < 16 * 16; i++){
+        checker[i] = (((i >> 4) ^ i) & 2) ? LCD_WHITE : LCD_PURPLE;
+    }
+    LCD_BlitRGB565(4, 4, 7, 5, gradient);
+    LCD_BlitRGB565(20, 4, 16, 16, checker);
+}
+
+static void DrawBlitClipped()
+{
+    static uint16_t gradient[7 * 5];
+    uint16_t i;
+    for(i = 0; i < 7 * 5; i++){
+        gradient[i] = i * 1000;
+    }
+    LCD_BlitRGB565(316, 238, 7, 5, gradient);           //Only 4x2 of it is on screen
+}
+
+static void DrawSetPoint()
+{
+    uint16_t i;
+    for(i = 0; i < 32; i++){
+        LCD_SetPoint(100 + i, 100 + i, LCD_GREEN);
+        LCD_SetPoint(131 - i, 100 + i, i * 0x0841);
+        LCD_SetPoint(100 + i, 115, LCD_RED);
+    }
+}
+
+static void DrawText()
+{
+    LCD_Text(0, 200, (uint8_t *)"Score 12", LCD_WHITE, LCD_GRAY);
+    LCD_Text(0, 216, (uint8_t *)"~!{}", LCD_BLACK, LCD_CYAN);
+}
+
+/*
+ * Text that starts off the character grid wraps before a cell would cross the right edge,
+ * text that starts below the last full line moves to the top
+ */
+static void DrawTextWrap()
+{
+    LCD_Text(5, 16, (uint8_t *)"0123456789012345678901234567890123456789", LCD_YELLOW, LCD_BLUE);
+    LCD_Text(200, 230, (uint8_t *)"Low", LCD_WHITE, LCD_RED);
+}
+
+static const GoldenScene_t Scenes[] = {
+    {"fill_rect",       0,   0,   96, 64, DrawFillRect},
+    {"blit",            0,   0,   48, 24, DrawBlit},
+    {"blit_clipped",    304, 224, 16, 16, DrawBlitClipped},
+    {"set_point",       96,  96,  40, 40, DrawSetPoint},
+    {"text",            0,   200, 80, 32, DrawText},
+    {"text_wrap",       0,   0,   320, 48, DrawTextWrap},
+};
+
+/*********************************************** Scenes *******************************************************************************/
+
+/*
+ * Crop of the emulated screen as RGB bytes, the same expansion LCDEmu_WritePPM uses
+ */
+static uint32_t ReadCrop(const GoldenScene_t *scene, uint8_t *rgb)
+{
+    uint32_t n = 0;
+    uint16_t x, y;
+    for(y = scene->y; y < scene->y + scene->h; y++){
+        for(x = scene->x; x < scene->x + scene->w; x++){
+            uint16_t pixel = LCDEmu_GetPixel(x, y);
+            rgb[n++] = ((pixel >> 11) & 0x1F) * 255 / 31;
+            rgb[n++] = ((pixel >> 5) & 0x3F) * 255 / 63;
+            rgb[n++] = (pixel & 0x1F) * 255 / 31;
+        }
+    }
+    return n;
+}
+
+static bool WritePPM(const char *path, uint16_t w, uint16_t h, const uint8_t *rgb)
+{
+    FILE *file = fopen(path, "wb");
+    if(file == 0){
+        return false;
+    }
+    fprintf(file, "P6\n%u %u\n255\n", w, h);
+    fwrite(rgb, 1, (size_t)w * h * 3, file);
+    return fclose(file) == 0;
+}
+
+/*
+ * Returns: Bytes of RGB read, 0 if the file is missing or not a w x h binary PPM
+ */
+static uint32_t ReadPPM(const char *path, uint16_t w, uint16_t h, uint8_t *rgb)
+{
+    FILE *file = fopen(path, "rb");
+    unsigned fileW, fileH, maxValue;
+    uint32_t n = 0;
+    if(file == 0){
+        return 0;
+    }
+    if(fscanf(file, "P6 %u %u %u", &fileW, &fileH, &maxValue) == 3 && fgetc(file) != EOF &&
+       fileW == w && fileH == h && maxValue == 255){
+        n = fread(rgb, 1, (size_t)w * h * 3, file);
+    }
+    fclose(file);
+    return n;
+}
+
+/*
+ * Returns: true if nothing outside the crop changed since LCD_Init
+ */
+static bool OutsideUntouched(const GoldenScene_t *scene)
+{
+    uint16_t x, y;
+    for(y = 0; y < MAX_SCREEN_Y; y++){
+        for(x = 0; x < MAX_SCREEN_X; x++){
+            bool inside = x >= scene->x && x < scene->x + scene->w && y >= scene->y && y < scene->y + scene->h;
+            if(!inside && LCDEmu_GetPixel(x, y) != Initial[y][x]){
+                printf("%s: pixel %u,%u outside the crop was written\n", scene->Name, x, y);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void RunScene(const GoldenScene_t *scene, bool update)
+{
+    static uint8_t drawn[CROP_MAX_BYTES];
+    static uint8_t golden[CROP_MAX_BYTES];
+    char path[128];
+    uint16_t x, y;
+
+    LCD_Init(false);
+    for(y = 0; y < MAX_SCREEN_Y; y++){
+        for(x = 0; x < MAX_SCREEN_X; x++){
+            Initial[y][x] = LCDEmu_GetPixel(x, y);
+        }
+    }
+
+    scene->Draw();
+    uint32_t size = ReadCrop(scene, drawn);
+    snprintf(path, sizeof(path), "%s/%s.ppm", GOLDEN_DIR, scene->Name);
+
+    if(update){
+        CHECK(WritePPM(path, scene->w, scene->h, drawn));
+        return;
+    }
+
+    CHECK(OutsideUntouched(scene));
+    if(ReadPPM(path, scene->w, scene->h, golden) != size){
+        printf("%s: no usable reference in %s\n", scene->Name, path);
+        CheckFailures++;
+        return;
+    }
+
+    uint32_t i;
+    for(i = 0; i < size && drawn[i] == golden[i]; i++);
+    if(i < size){
+        uint32_t pixel = i / 3;
+        snprintf(path, sizeof(path), "%s/%s.ppm", OUT_DIR, scene->Name);
+        WritePPM(path, scene->w, scene->h, drawn);
+        printf("%s: differs from the reference at %u,%u, drawn crop in %s\n", scene->Name,
+               scene->x + pixel % scene->w, scene->y + pixel / scene->w, path);
+        CheckFailures++;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    bool update = (argc > 1 && strcmp(argv[1], "--update") == 0);
+    uint16_t i;
+    for(i = 0; i < sizeof(Scenes) / sizeof(Scenes[0]); i++){
+        RunScene(&Scenes[i], update);
+    }
+    CHECK_DONE(update ? "LCDGolden (references rewritten)" : "LCDGolden");
+}
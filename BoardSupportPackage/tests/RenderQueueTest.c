@@ -0,0 +1,219 @@
+/*
+ * RenderQueueTest.c
+ *
+ * Host test of RenderQueue: commands come out in the order they went in,
+ * coalescing only drops commands nothing later depends on, the ring wraps,
+ * a full queue refuses commands and copied blit pixels travel with the command
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "Check.h"
+#include "RenderQueue.h"
+
+static RenderCmd_t Rect(int16_t x, int16_t y, uint16_t w, uint16_t h, uint16_t color)
+{
+    RenderCmd_t cmd;
+    memset(&cmd, 0, sizeof(cmd));
+    cmd.Type = RENDER_RECT;
+    cmd.x = x;
+    cmd.y = y;
+    cmd.w = w;
+    cmd.h = h;
+    cmd.Color = color;
+    return cmd;
+}
+
+static RenderCmd_t Text(int16_t x, int16_t y, const char *str)
+{
+    RenderCmd_t cmd = Rect(x, y, 0, 0, 1);
+    cmd.Type = RENDER_TEXT;
+    strcpy(cmd.Text, str);
+    return cmd;
+}
+
+/*
+ * Disjoint commands come out first in, first out
+ */
+static void TestOrdering()
+{
+    RenderQueue_t queue;
+    RenderCmd_t cmd;
+    uint16_t i;
+
+    RenderQueue_Init(&queue);
+    for(i = 0; i < 10; i++){
+        cmd = Rect(i * 20, 0, 10, 10, i);
+        CHECK(RenderQueue_Push(&queue, &cmd));
+    }
+    for(i = 0; i < 10; i++){
+        CHECK(RenderQueue_Pop(&queue, &cmd));
+        CHECK(cmd.Color == i);
+    }
+    CHECK(!RenderQueue_Pop(&queue, &cmd));
+    CHECK(queue.Coalesced == 0);
+}
+
+/*
+ * Only the newest pending commands are replaced, and only when painted over completely
+ */
+static void TestCoalescing()
+{
+    RenderQueue_t queue;
+    RenderCmd_t cmd;
+
+    RenderQueue_Init(&queue);
+    cmd = Rect(0, 0, 10, 10, 1);
+    RenderQueue_Push(&queue, &cmd);
+    cmd = Rect(50, 50, 5, 5, 2);
+    RenderQueue_Push(&queue, &cmd);
+
+    //Covers the newest one
+    cmd = Rect(40, 40, 20, 20, 3);
+    RenderQueue_Push(&queue, &cmd);
+    CHECK(queue.Count == 2);
+    CHECK(queue.Coalesced == 1);
+
+    //Covers the oldest, but the one in between has to stay under it so both stay
+    cmd = Rect(0, 0, 10, 10, 4);
+    RenderQueue_Push(&queue, &cmd);
+    CHECK(queue.Count == 3);
+
+    //Partly covering does not count
+    cmd = Rect(5, 5, 10, 10, 5);
+    RenderQueue_Push(&queue, &cmd);
+    CHECK(queue.Count == 4);
+
+    //Text in the same place and of the same length replaces the old text
+    cmd = Text(8, 100, "12");
+    RenderQueue_Push(&queue, &cmd);
+    cmd = Text(8, 100, "13");
+    RenderQueue_Push(&queue, &cmd);
+    CHECK(queue.Count == 5);
+
+    //Text that wraps onto the next line has no simple area and never coalesces
+    cmd = Text(312, 120, "ab");
+    RenderQueue_Push(&queue, &cmd);
+    RenderQueue_Push(&queue, &cmd);
+    CHECK(queue.Count == 7);
+
+    //A clear drops everything
+    cmd = Rect(0, 0, 320, 240, 0);
+    cmd.Type = RENDER_CLEAR;
+    RenderQueue_Push(&queue, &cmd);
+    CHECK(queue.Count == 1);
+    CHECK(RenderQueue_Pop(&queue, &cmd));
+    CHECK(cmd.Type == RENDER_CLEAR);
+}
+
+/*
+ * Head runs around the ring many times without losing the order
+ */
+static void TestWrapAround()
+{
+    RenderQueue_t queue;
+    RenderCmd_t cmd;
+    uint16_t pushed = 0, popped = 0;
+    uint16_t i;
+
+    RenderQueue_Init(&queue);
+    for(i = 0; i < RENDER_QUEUE_SIZE - 3; i++, pushed++){
+        cmd = Rect(pushed, 0, 1, 1, pushed);
+        RenderQueue_Push(&queue, &cmd);
+    }
+    for(i = 0; i < 5 * RENDER_QUEUE_SIZE; i++){
+        cmd = Rect(pushed % 300, 10, 1, 1, pushed);
+        CHECK(RenderQueue_Push(&queue, &cmd));
+        pushed++;
+
+        CHECK(RenderQueue_Pop(&queue, &cmd));
+        CHECK(cmd.Color == popped);
+        popped++;
+    }
+    while(RenderQueue_Pop(&queue, &cmd)){
+        CHECK(cmd.Color == popped);
+        popped++;
+    }
+    CHECK(popped == pushed);
+    CHECK(queue.Coalesced == 0);
+}
+
+/*
+ * A full queue refuses and counts, what is queued is untouched
+ */
+static void TestFull()
+{
+    RenderQueue_t queue;
+    RenderCmd_t cmd;
+    uint16_t i;
+
+    RenderQueue_Init(&queue);
+    for(i = 0; i < RENDER_QUEUE_SIZE + 5; i++){
+        cmd = Rect(i * 3, 100, 2, 2, i);
+        CHECK(RenderQueue_Push(&queue, &cmd) == (i < RENDER_QUEUE_SIZE));
+    }
+    CHECK(queue.Count == RENDER_QUEUE_SIZE);
+    CHECK(queue.Rejected == 5);
+
+    //Still refused when it would only cover a command further back
+    cmd = Rect(0, 100, 2, 2, 99);
+    CHECK(!RenderQueue_Push(&queue, &cmd));
+
+    //Covering the newest makes room for itself
+    cmd = Rect((RENDER_QUEUE_SIZE - 1) * 3, 100, 2, 2, 77);
+    CHECK(RenderQueue_Push(&queue, &cmd));
+    CHECK(queue.Count == RENDER_QUEUE_SIZE);
+
+    for(i = 0; i < RENDER_QUEUE_SIZE - 1; i++){
+        CHECK(RenderQueue_Pop(&queue, &cmd));
+        CHECK(cmd.Color == i);
+    }
+    CHECK(RenderQueue_Pop(&queue, &cmd));
+    CHECK(cmd.Color == 77);
+}
+
+/*
+ * Pixels copied into a blit come back out unchanged after the source is reused
+ */
+static void TestBlitCopy()
+{
+    RenderQueue_t queue;
+    RenderCmd_t cmd;
+    uint16_t tile[RENDER_BLIT_COPY_MAX];
+    uint16_t i;
+
+    RenderQueue_Init(&queue);
+    for(i = 0; i < RENDER_BLIT_COPY_MAX; i++){
+        tile[i] = 0xF800 + i;
+    }
+    cmd = Rect(40, 40, 8, RENDER_BLIT_COPY_MAX / 8, 0);
+    cmd.Type = RENDER_BLIT;
+    memcpy(cmd.Copy, tile, sizeof(tile));
+    CHECK(RenderQueue_Push(&queue, &cmd));
+
+    //Buffer reused for the next sprite before the first one is drawn
+    memset(tile, 0, sizeof(tile));
+    cmd = Rect(100, 40, 8, RENDER_BLIT_COPY_MAX / 8, 0);
+    cmd.Type = RENDER_BLIT;
+    memcpy(cmd.Copy, tile, sizeof(tile));
+    CHECK(RenderQueue_Push(&queue, &cmd));
+
+    CHECK(RenderQueue_Pop(&queue, &cmd));
+    CHECK(cmd.x == 40 && cmd.Pixels == 0);
+    for(i = 0; i < RENDER_BLIT_COPY_MAX; i++){
+        CHECK(cmd.Copy[i] == 0xF800 + i);
+    }
+    CHECK(RenderQueue_Pop(&queue, &cmd));
+    CHECK(cmd.x == 100 && cmd.Copy[0] == 0);
+}
+
+int main()
+{
+    TestOrdering();
+    TestCoalescing();
+    TestWrapAround();
+    TestFull();
+    TestBlitCopy();
+    CHECK_DONE("RenderQueue");
+}
@@ -0,0 +1,205 @@
+/*
+ * TileRenderTest.c
+ *
+ * Host test of TileRender against a reference framebuffer
+ *  - The reference paints every visible sprite pixel by pixel in scene order,
+ *    a full or partial TileRender_Draw has to blit exactly that picture
+ *  - Blits stay inside the requested area and inside one tile
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Check.h"
+#include "TileRender.h"
+
+#define FB_W 100
+#define FB_H 80
+#define BACKGROUND 9
+#define UNTOUCHED 0xFFFF
+
+static uint16_t Reference[FB_H][FB_W];
+static uint16_t Screen[FB_H][FB_W];
+static uint16_t Image[9 * 7];
+
+/* Area the current TileRender_Draw may write */
+static int16_t AreaXStart, AreaXEnd, AreaYStart, AreaYEnd;
+static uint32_t Blits;
+static bool BlitOutside;
+
+/* tile_Blit_t into the screen */
+static void Blit(int16_t x, int16_t y, uint16_t w, uint16_t h, const uint16_t *pixels)
+{
+    uint16_t i, j;
+    Blits++;
+    if(w * h > TILE_SIZE * TILE_SIZE || x < AreaXStart || x + w - 1 > AreaXEnd ||
+       y < AreaYStart || y + h - 1 > AreaYEnd){
+        BlitOutside = true;
+    }
+    for(j = 0; j < h; j++){
+        for(i = 0; i < w; i++){
+            int16_t screenX = x + i, screenY = y + j;
+            if(screenX >= 0 && screenX < FB_W && screenY >= 0 && screenY < FB_H){
+                Screen[screenY][screenX] = pixels[j * w + i];
+            }
+        }
+    }
+}
+
+/*
+ * Straightforward compositing, one pixel at a time
+ */
+static void PaintReference(Sprite_t *sprites, uint16_t count)
+{
+    int16_t x, y;
+    uint16_t k;
+    for(y = 0; y < FB_H; y++){
+        for(x = 0; x < FB_W; x++){
+            uint16_t color = BACKGROUND;
+            for(k = 0; k < count; k++){
+                Sprite_t *s = &sprites[k];
+                if(!s->Visible || x < s->x || x >= s->x + s->w || y < s->y || y >= s->y + s->h){
+                    continue;
+                }
+                if(s->Pixels == 0){
+                    color = s->Color;
+                }
+                else if(s->Pixels[(y - s->y) * s->w + (x - s->x)] != s->Transparent){
+                    color = s->Pixels[(y - s->y) * s->w + (x - s->x)];
+                }
+            }
+            Reference[y][x] = color;
+        }
+    }
+}
+
+static void DrawArea(Scene_t *scene, int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd)
+{
+    memset(Screen, 0xFF, sizeof(Screen));
+    AreaXStart = xStart;
+    AreaXEnd = xEnd;
+    AreaYStart = yStart;
+    AreaYEnd = yEnd;
+    BlitOutside = false;
+    TileRender_Draw(scene, xStart, xEnd, yStart, yEnd);
+}
+
+/*
+ * Returns: true if the area matches the reference and nothing outside it was written
+ */
+static bool AreaMatches(int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd)
+{
+    int16_t x, y;
+    for(y = 0; y < FB_H; y++){
+        for(x = 0; x < FB_W; x++){
+            bool inside = x >= xStart && x <= xEnd && y >= yStart && y <= yEnd;
+            if(Screen[y][x] != (inside ? Reference[y][x] : UNTOUCHED)){
+                return false;
+            }
+        }
+    }
+    return !BlitOutside;
+}
+
+/*
+ * Random scenes of solid and image sprites, some hidden, some off the edges
+ */
+static void TestRandomScenes()
+{
+    static Scene_t scene;
+    static Sprite_t sprites[MAX_SPRITES];
+    uint32_t run;
+    uint16_t i;
+
+    srand(3);
+    for(i = 0; i < 9 * 7; i++){
+        Image[i] = rand() % 4;
+    }
+
+    for(run = 0; run < 2000; run++){
+        uint16_t count = rand() % (MAX_SPRITES + 1);
+        TileRender_Init(&scene, BACKGROUND, Blit);
+        for(i = 0; i < count; i++){
+            Sprite_t *s = &sprites[i];
+            s->x = rand() % FB_W - 10;
+            s->y = rand() % FB_H - 10;
+            s->Visible = (rand() % 5 != 0);
+            s->Color = 10 + i;
+            if(rand() % 2){
+                s->Pixels = Image;
+                s->w = 9;
+                s->h = 7;
+                s->Transparent = 0;
+            }
+            else{
+                s->Pixels = 0;
+                s->w = 1 + rand() % 40;
+                s->h = 1 + rand() % 40;
+            }
+            CHECK(TileRender_AddSprite(&scene, s));
+        }
+        PaintReference(sprites, count);
+
+        DrawArea(&scene, 0, FB_W - 1, 0, FB_H - 1);
+        if(!AreaMatches(0, FB_W - 1, 0, FB_H - 1)){
+            printf("scene %u differs from the reference\n", run);
+            CheckFailures++;
+            return;
+        }
+
+        int16_t xStart = rand() % FB_W, yStart = rand() % FB_H;
+        int16_t xEnd = xStart + rand() % (FB_W - xStart), yEnd = yStart + rand() % (FB_H - yStart);
+        DrawArea(&scene, xStart, xEnd, yStart, yEnd);
+        if(!AreaMatches(xStart, xEnd, yStart, yEnd)){
+            printf("scene %u area %d..%d, %d..%d differs from the reference\n", run, xStart, xEnd, yStart, yEnd);
+            CheckFailures++;
+            return;
+        }
+    }
+}
+
+/*
+ * Overlapping sprites go out in one burst per tile, no flicker from painting twice
+ */
+static void TestOneBlitPerTile()
+{
+    static Scene_t scene;
+    static Sprite_t ball = {4, 4, 8, 8, 1, 0, 0, true};
+    static Sprite_t paddle = {0, 8, 32, 4, 2, 0, 0, true};
+
+    TileRender_Init(&scene, BACKGROUND, Blit);
+    TileRender_AddSprite(&scene, &ball);
+    TileRender_AddSprite(&scene, &paddle);
+
+    Blits = 0;
+    DrawArea(&scene, 0, TILE_SIZE - 1, 0, 15);
+    CHECK(Blits == 1);
+    CHECK(Screen[8][6] == 2);       //Paddle on top of the ball
+    CHECK(Screen[5][6] == 1);
+    CHECK(Screen[0][0] == BACKGROUND);
+}
+
+/*
+ * A full scene refuses more sprites
+ */
+static void TestFull()
+{
+    static Scene_t scene;
+    static Sprite_t sprites[MAX_SPRITES + 1];
+    uint16_t i;
+
+    TileRender_Init(&scene, BACKGROUND, Blit);
+    for(i = 0; i < MAX_SPRITES; i++){
+        CHECK(TileRender_AddSprite(&scene, &sprites[i]));
+    }
+    CHECK(!TileRender_AddSprite(&scene, &sprites[MAX_SPRITES]));
+}
+
+int main()
+{
+    TestRandomScenes();
+    TestOneBlitPerTile();
+    TestFull();
+    CHECK_DONE("TileRender");
+}
@@ -0,0 +1,149 @@
+/*
+ * TouchFilterTest.c
+ *
+ * Host test of the touch filtering and calibration math
+ *  - Median of odd and even bursts, one wild reading never gets through
+ *  - IIR takes the first burst of a touch as it is, then closes in on a step
+ *  - Calibration solved from three touches maps like TouchCal_Default,
+ *    points on one line are refused and results stay on the screen
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "Check.h"
+#include "TouchFilter.h"
+#include "LCD_empty.h"
+
+/*
+ * Middle sample of an odd burst, upper middle of an even one, sorted in place
+ */
+static void TestMedian()
+{
+    uint16_t odd[5] = {900, 20, 4000, 510, 505};
+    CHECK(TouchFilter_Median(odd, 5) == 510);
+    CHECK(odd[0] == 20 && odd[4] == 4000);
+
+    uint16_t even[4] = {300, 100, 400, 200};
+    CHECK(TouchFilter_Median(even, 4) == 300);
+
+    uint16_t one[1] = {1234};
+    CHECK(TouchFilter_Median(one, 1) == 1234);
+
+    //A reading taken while the pen settles is thrown away
+    uint16_t settle[TOUCH_MAX_SAMPLES] = {2000, 2001, 1999, 4095, 2000, 2002, 0, 1998, 2000};
+    CHECK(TouchFilter_Median(settle, TOUCH_MAX_SAMPLES) == 2000);
+}
+
+/*
+ * First burst primes the filter, a step is approached from one side and reached
+ */
+static void TestIIR()
+{
+    TouchIIR_t filter;
+    TouchPoint_t out;
+    uint16_t i;
+
+    TouchFilter_Reset(&filter);
+    TouchFilter_Update(&filter, 1000, 3000, &out);
+    CHECK(out.x == 1000 && out.y == 3000);
+
+    //Step up in x, down in y, moves 1 / 2^TOUCH_IIR_SHIFT of the way each burst
+    int32_t lastX = out.x, lastY = out.y;
+    TouchFilter_Update(&filter, 2000, 2000, &out);
+    CHECK(out.x == 1000 + (1000 >> TOUCH_IIR_SHIFT));
+    CHECK(out.y == 3000 - (1000 >> TOUCH_IIR_SHIFT));
+    for(i = 0; i < 60; i++){
+        CHECK(out.x >= lastX && out.x <= 2000);
+        CHECK(out.y <= lastY && out.y >= 2000);
+        lastX = out.x;
+        lastY = out.y;
+        TouchFilter_Update(&filter, 2000, 2000, &out);
+    }
+    CHECK(out.x == 2000 && out.y == 2000);
+
+    //A new touch does not drag the old position along
+    TouchFilter_Reset(&filter);
+    TouchFilter_Update(&filter, 100, 200, &out);
+    CHECK(out.x == 100 && out.y == 200);
+}
+
+/*
+ * Three touches of points placed with TouchCal_Default give back the same mapping
+ */
+static void TestCalibrationRoundTrip()
+{
+    const TouchPoint_t raw[3] = {{400, 500}, {3700, 600}, {2000, 3600}};
+    TouchPoint_t screen[3];
+    TouchCal_t cal;
+    uint16_t i;
+
+    for(i = 0; i < 3; i++){
+        TouchCal_Apply(&TouchCal_Default, &raw[i], &screen[i]);
+    }
+    CHECK(TouchCal_Compute(screen, raw, &cal));
+
+    //Screen points are whole pixels, so the coefficients come back within about 1%
+    CHECK(abs(cal.A - TouchCal_Default.A) < TouchCal_Default.A / 100);
+    CHECK(abs(cal.E - TouchCal_Default.E) < TouchCal_Default.E / 100);
+    CHECK(abs(cal.B) < TouchCal_Default.A / 100);
+    CHECK(abs(cal.D) < TouchCal_Default.E / 100);
+
+    //and map the whole panel within a pixel of the default
+    int32_t x, y;
+    for(x = 0; x < 4096; x += 64){
+        for(y = 0; y < 4096; y += 64){
+            TouchPoint_t point = {x, y}, expected, mapped;
+            TouchCal_Apply(&TouchCal_Default, &point, &expected);
+            TouchCal_Apply(&cal, &point, &mapped);
+            CHECK(abs(mapped.x - expected.x) <= 1 && abs(mapped.y - expected.y) <= 1);
+        }
+    }
+}
+
+/*
+ * Points on one line can not fix the mapping, the old calibration stays
+ */
+static void TestCalibrationCollinear()
+{
+    const TouchPoint_t raw[3] = {{500, 500}, {1500, 1500}, {3000, 3000}};
+    const TouchPoint_t screen[3] = {{10, 10}, {100, 100}, {200, 200}};
+    TouchCal_t cal = TouchCal_Default;
+
+    CHECK(!TouchCal_Compute(screen, raw, &cal));
+    CHECK(cal.A == TouchCal_Default.A && cal.C == TouchCal_Default.C && cal.F == TouchCal_Default.F);
+
+    const TouchPoint_t same[3] = {{500, 500}, {500, 500}, {3000, 1000}};
+    CHECK(!TouchCal_Compute(screen, same, &cal));
+}
+
+/*
+ * Readings off the edges of the panel land on the screen edges
+ */
+static void TestApplyClamp()
+{
+    TouchPoint_t out;
+    const TouchPoint_t low = {0, 0}, high = {4095, 4095}, wild = {-5000, 100000};
+
+    TouchCal_Apply(&TouchCal_Default, &low, &out);
+    CHECK(out.x == 0 && out.y == 0);
+    TouchCal_Apply(&TouchCal_Default, &high, &out);
+    CHECK(out.x == MAX_SCREEN_X - 1 && out.y == MAX_SCREEN_Y - 1);
+    TouchCal_Apply(&TouchCal_Default, &wild, &out);
+    CHECK(out.x == 0 && out.y == MAX_SCREEN_Y - 1);
+
+    //The middle of the panel is well inside
+    const TouchPoint_t middle = {2048, 2048};
+    TouchCal_Apply(&TouchCal_Default, &middle, &out);
+    CHECK(out.x > 100 && out.x < 220 && out.y > 80 && out.y < 160);
+}
+
+int main()
+{
+    TestMedian();
+    TestIIR();
+    TestCalibrationRoundTrip();
+    TestCalibrationCollinear();
+    TestApplyClamp();
+    CHECK_DONE("TouchFilter");
+}
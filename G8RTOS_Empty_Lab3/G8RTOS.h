@@ -9,6 +9,8 @@
 #include "G8RTOS_Semaphores.h"
 #include "G8RTOS_Scheduler.h"
 #include "G8RTOS_IPC.h"
+#include "G8RTOS_Schedulability.h"
+#include "G8RTOS_Watchdog.h"
 
 
 
@@ -23,5 +23,21 @@ extern int32_t StartCriticalSection();
  */
 extern void EndCriticalSection(int32_t IBit_State);
 
+/*
+ * Starts a kernel section
+ * 	- Saves the state of the current BASEPRI
+ * 	- Masks interrupts at or below the given priority, higher ones keep running
+ * Param "basepri": Encoded priority to mask from (priority << (8 - __NVIC_PRIO_BITS))
+ * Returns: The current BASEPRI State
+ */
+extern int32_t StartKernelSection(int32_t basepri);
+
+/*
+ * Ends a kernel section
+ * 	- Restores the state of the BASEPRI given an input
+ * Param "basepri_State": BASEPRI State to update
+ */
+extern void EndKernelSection(int32_t basepri_State);
+
 
 #endif /* G8RTOS_CRITICALSECTION_H_ */
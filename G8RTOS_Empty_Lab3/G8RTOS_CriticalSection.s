@@ -4,6 +4,7 @@
 
 	; Functions Defined
 	.def StartCriticalSection, EndCriticalSection
+	.def StartKernelSection, EndKernelSection
 	
 	.thumb		; Set to thumb mode
 	.align 2	; Align by 2 bytes (thumb mode uses allignment by 2 or 4)
@@ -32,4 +33,31 @@ EndCriticalSection:
 	MSR PRIMASK, R0		; Save R0 (Param) to PRIMASK
 	BX LR				; Return
 	
-	.endasmfunc
\ No newline at end of file
+	.endasmfunc
+
+; Starts a kernel section
+; 	- Saves the state of the current BASEPRI
+; 	- Masks every interrupt at or below the given priority, higher ones keep running
+; 	- BASEPRI_MAX only ever raises the mask so nested sections are free
+; Param R0: Encoded priority to mask from (priority << (8 - __NVIC_PRIO_BITS))
+; Returns: The current BASEPRI State
+StartKernelSection:
+	.asmfunc
+
+	MRS R1, BASEPRI		; Save BASEPRI to R1
+	MSR BASEPRI_MAX, R0	; Raise the mask (never lowers it)
+	MOV R0, R1			; Old BASEPRI is the return value
+	BX LR				; Return
+
+	.endasmfunc
+
+; Ends a kernel section
+; 	- Restores the state of the BASEPRI given an input
+; Param R0: BASEPRI State to update
+EndKernelSection:
+	.asmfunc
+
+	MSR BASEPRI, R0		; Save R0 (Param) to BASEPRI
+	BX LR				; Return
+
+	.endasmfunc
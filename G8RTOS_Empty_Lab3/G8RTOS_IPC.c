@@ -5,9 +5,11 @@
  *      Author: Daniel Gonzalez
  */
 #include <stdint.h>
+#include <stdbool.h>
 #include "msp.h"
 #include "G8RTOS_IPC.h"
 #include "G8RTOS_Semaphores.h"
+#include "G8RTOS_SVC.h"
 
 /*********************************************** Defines ******************************************************************************/
 
@@ -26,7 +28,7 @@
  *  - tail
  *  - lost data
  *  - current size
- *  - mutex
+ *  - readers woken with an item set aside for them
  */
 
 /* Create FIFO struct here */
@@ -37,7 +39,7 @@ typedef struct FIFO_t{
     int32_t *Tail;
     uint32_t LostData;
     semaphore_t CurrentSize;
-    semaphore_t Mutex;
+    uint32_t Woken;
 } FIFO_t;
 
 /* Array of FIFOS */
@@ -51,10 +53,17 @@ static FIFO_t FIFOs[4];
 int G8RTOS_InitFIFO(uint32_t FIFOIndex)
 {
     /* Implement this */
+    //Threads trap into the kernel, handlers are already at kernel level
+    if(G8RTOS_InThreadMode()){
+        return G8RTOS_SVC_InitFIFO(FIFOIndex);
+    }
+
     if(FIFOIndex > 3){
         return -1;
     }
 
+    int32_t state = G8RTOS_KernelEnter();
+
     FIFO_t *Fptr = &(FIFOs[FIFOIndex]);
 
     int i = 0;
@@ -64,13 +73,31 @@ int G8RTOS_InitFIFO(uint32_t FIFOIndex)
     Fptr->Head = (Fptr->Buffer);
     Fptr->Tail = (Fptr->Buffer);
     Fptr->CurrentSize = 0;
-    Fptr->Mutex = 1;
+    Fptr->Woken = 0;
 
+    G8RTOS_KernelExit(state);
     return 1;
 }
 
 /*
- * Reads FIFO
+ * Takes the item at the head (wraps if necessary), kernel side
+ */
+static int32_t PopFIFO(FIFO_t *fifo)
+{
+    int32_t returnData = *(fifo->Head);    //Get first out
+
+    //CHeck to see if at the end of the buffer
+    if(fifo->Head == &(fifo->Buffer[FIFOSIZE - 1])){
+        fifo->Head = fifo->Buffer;  //Put it at beginning
+    }
+    else{
+        fifo->Head++;    //Push it further down the array
+    }
+    return returnData;
+}
+
+/*
+ * Reads FIFO, threads only
  *  - Waits until CurrentSize semaphore is greater than zero
  *  - Gets data and increments the head ptr (wraps if necessary)
  * Param: "FIFOChoice": chooses which buffer we want to read from
@@ -79,28 +106,52 @@ int G8RTOS_InitFIFO(uint32_t FIFOIndex)
 int32_t readFIFO(uint32_t FIFOChoice)
 {
     /* Implement this */
-    //Just in case fifo was in the middle of being read from another thread
-    G8RTOS_WaitSemaphore(&(FIFOs[FIFOChoice].Mutex));
-    G8RTOS_WaitSemaphore(&(FIFOs[FIFOChoice].CurrentSize));
-//    while(FIFOs[FIFOChoice].Mutex < 1);
-//    //Just in case fifo is empty
-//    while(FIFOs[FIFOChoice].CurrentSize < 1);
+    //The whole read is a system call, a blocked reader comes back once to collect its item
+    int32_t returnData = -1;
+    bool woken = false;
+    while(!G8RTOS_SVC_ReadFIFO(FIFOChoice, &returnData, woken)){
+        woken = true;
+    }
+    return returnData;
+}
 
-    int32_t returnData = *(FIFOs[FIFOChoice].Head);    //Get first out
+/*
+ * Kernel side of readFIFO
+ *  - Takes a CurrentSize count and pops in one go, readers never see the FIFO half updated
+ *    so no mutex is needed between them
+ *  - A reader that has to block is handed a count by writeFIFO, it calls again with
+ *    "woken" set and collects the item that was set aside for it
+ * Param "FIFOChoice": chooses which buffer we want to read from
+ * Param "data": Returns the item
+ * Returns: false if the caller blocked, a FIFO that does not exist gives -1 right away
+ */
+bool readFIFOData(uint32_t FIFOChoice, int32_t *data, bool woken)
+{
+    if(FIFOChoice >= MAX_NUMBER_OF_FIFOS){
+        *data = -1;
+        return true;
+    }
 
-    //CHeck to see if at the end of the buffer
+    int32_t state = G8RTOS_KernelEnter();
+    FIFO_t *fifo = &(FIFOs[FIFOChoice]);
+    bool taken = true;
 
-    if(FIFOs[FIFOChoice].Head == &(FIFOs[FIFOChoice].Buffer[15])){
-        FIFOs[FIFOChoice].Head = FIFOs[FIFOChoice].Buffer;  //Put it at beginning
+    if(woken && fifo->Woken > 0){
+        fifo->Woken--;
+        *data = PopFIFO(fifo);
     }
     else{
-        FIFOs[FIFOChoice].Head++;    //Push it further down the array
+        G8RTOS_WaitSemaphore(&(fifo->CurrentSize));
+        if(fifo->CurrentSize >= 0){
+            *data = PopFIFO(fifo);
+        }
+        else{
+            taken = false;  //Blocked, PendSV switches away once the system call returns
+        }
     }
 
-    G8RTOS_SignalSemaphore(&(FIFOs[FIFOChoice].Mutex));
-    //G8RTOS_SignalSemaphore(&(FIFOs[FIFOChoice].CurrentSize));
-    return returnData;
-
+    G8RTOS_KernelExit(state);
+    return taken;
 }
 
 /*
@@ -114,16 +165,28 @@ int32_t readFIFO(uint32_t FIFOChoice)
 int writeFIFO(uint32_t FIFOChoice, int32_t Data)
 {
     /* Implement this */
+    //Threads trap into the kernel, handlers are already at kernel level
+    if(G8RTOS_InThreadMode()){
+        return G8RTOS_SVC_WriteFIFO(FIFOChoice, Data);
+    }
+
+    if(FIFOChoice >= MAX_NUMBER_OF_FIFOS){
+        return -1;
+    }
+
+    int32_t state = G8RTOS_KernelEnter();
+
     //Check if an interrupt has happened between rading the fifo and inc the head pointer
     //G8RTOS_WaitSemaphore(&(FIFOs[FIFOChoice].Mutex));
 
     if(FIFOs[FIFOChoice].CurrentSize > (FIFOSIZE - 1)){
         FIFOs[FIFOChoice].LostData++;
+        G8RTOS_KernelExit(state);
         return -1;
     }
     else{
         *(FIFOs[FIFOChoice].Tail) = Data;
-        if(FIFOs[FIFOChoice].Tail == &(FIFOs[FIFOChoice].Buffer[15])){
+        if(FIFOs[FIFOChoice].Tail == &(FIFOs[FIFOChoice].Buffer[FIFOSIZE - 1])){
                 FIFOs[FIFOChoice].Tail = FIFOs[FIFOChoice].Buffer;  //Put it at beginning
             }
             else{
@@ -131,7 +194,12 @@ int writeFIFO(uint32_t FIFOChoice, int32_t Data)
             }
     }
 
+    //A blocked reader gets this item, it comes back for it with "woken" set
     G8RTOS_SignalSemaphore(&(FIFOs[FIFOChoice].CurrentSize));
+    if(FIFOs[FIFOChoice].CurrentSize <= 0){
+        FIFOs[FIFOChoice].Woken++;
+    }
+    G8RTOS_KernelExit(state);
     return 1;
 
 }
@@ -8,6 +8,9 @@
 #ifndef G8RTOS_G8RTOS_IPC_H_
 #define G8RTOS_G8RTOS_IPC_H_
 
+#include <stdint.h>
+#include <stdbool.h>
+
 /*********************************************** Error Codes **************************************************************************/
 
 /*********************************************** Error Codes **************************************************************************/
@@ -20,7 +23,7 @@
 int G8RTOS_InitFIFO(uint32_t FIFOIndex);
 
 /*
- * Reads FIFO
+ * Reads FIFO, threads only
  *  - Waits until CurrentSize semaphore is greater than zero
  *  - Gets data and increments the head ptr (wraps if necessary)
  * Param "FIFOChoice": chooses which buffer we want to read from
@@ -38,6 +41,18 @@ int32_t readFIFO(uint32_t FIFO);
  */
 int writeFIFO(uint32_t FIFO, int32_t data);
 
+/*
+ * Kernel side of readFIFO
+ *  - Takes a CurrentSize count and pops in one go, readers never see the FIFO half updated
+ *    so no mutex is needed between them
+ *  - A reader that has to block is handed a count by writeFIFO, it calls again with
+ *    "woken" set and collects the item that was set aside for it
+ * Param "FIFOChoice": chooses which buffer we want to read from
+ * Param "data": Returns the item
+ * Returns: false if the caller blocked, a FIFO that does not exist gives -1 right away
+ */
+bool readFIFOData(uint32_t FIFO, int32_t *data, bool woken);
+
 /*********************************************** Public Functions *********************************************************************/
 
 
@@ -0,0 +1,216 @@
+/*
+ * G8RTOS_SVC.c
+ */
+
+/*********************************************** Dependencies and Externs *************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "msp.h"
+#include "G8RTOS.h"
+#include "G8RTOS_SVC.h"
+#include "G8RTOS_CriticalSection.h"
+
+/*********************************************** Dependencies and Externs *************************************************************/
+
+
+/*********************************************** Defines ******************************************************************************/
+
+/* Stacked exception frame */
+#define FRAME_R0    0
+#define FRAME_R1    1
+#define FRAME_R2    2
+#define FRAME_R3    3
+#define FRAME_PC    6
+#define FRAME_PSR   7
+
+/* Stack arguments start right after the 8 word frame, plus one pad word if the hardware aligned the stack */
+#define FRAME_SIZE          8
+#define PSR_STACK_ALIGN     (1 << 9)
+
+/* IPSR exception number while in the SVC handler */
+#define SVCALL_EXCEPTION    11
+
+/* BASEPRI value that masks every interrupt allowed to call the kernel */
+#define KERNEL_BASEPRI      (SYSCALL_PRIORITY << (8 - __NVIC_PRIO_BITS))
+
+/*********************************************** Defines ******************************************************************************/
+
+
+/*********************************************** Private Variables ********************************************************************/
+
+/* Set while a system call from an unprivileged thread is being serviced */
+static bool CallerUnprivileged;
+
+/* Cycle count when the outermost kernel section started */
+static uint32_t KernelSectionStart;
+
+/* Longest kernel section measured, in cycles */
+static uint32_t MaxKernelSection;
+
+/*********************************************** Private Variables ********************************************************************/
+
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*
+ * Fifth argument of a system call, passed on the caller's stack above the frame
+ */
+static uint32_t FifthArgument(uint32_t *frame)
+{
+    if(frame[FRAME_PSR] & PSR_STACK_ALIGN){
+        return frame[FRAME_SIZE + 1];
+    }
+    return frame[FRAME_SIZE];
+}
+
+/*********************************************** Private Functions ********************************************************************/
+
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Kernel side only
+ * Returns: true while the kernel is servicing a system call made by an unprivileged thread
+ */
+bool G8RTOS_CallerIsUnprivileged()
+{
+    //An interrupt preempting the system call is not the caller
+    return CallerUnprivileged && (__get_IPSR() == SVCALL_EXCEPTION);
+}
+
+/*
+ * Kernel side only
+ * Starts a kernel section
+ *  - Masks interrupts that may call the kernel (SYSCALL_PRIORITY and lower)
+ *  - Interrupts above SYSCALL_PRIORITY are never held off by the kernel
+ *  - Nests, only the outermost section is timed
+ * Returns: State to hand back to G8RTOS_KernelExit
+ */
+int32_t G8RTOS_KernelEnter()
+{
+    int32_t state = StartKernelSection(KERNEL_BASEPRI);
+    if(state == 0){
+        KernelSectionStart = DWT->CYCCNT;
+    }
+    return state;
+}
+
+/*
+ * Kernel side only
+ * Ends a kernel section started by G8RTOS_KernelEnter
+ * Param "state": Value returned by G8RTOS_KernelEnter
+ */
+void G8RTOS_KernelExit(int32_t state)
+{
+    if(state == 0){
+        uint32_t length = DWT->CYCCNT - KernelSectionStart;
+        if(length > MaxKernelSection){
+            MaxKernelSection = length;
+        }
+    }
+    EndKernelSection(state);
+}
+
+/*
+ * Returns: Longest kernel section so far in CPU cycles (worst case added interrupt latency)
+ */
+uint32_t G8RTOS_GetMaxKernelSection()
+{
+    return MaxKernelSection;
+}
+
+/*
+ * C part of the SVC handler (called from SVC_Handler in asm)
+ *  - Runs at kernel priority (OSINT_PRIORITY) like PendSV and SysTick
+ *  - Decodes the SVC number from the instruction before the stacked PC
+ *  - Calls the kernel function with the stacked arguments
+ *  - Writes the return value into the stacked R0
+ *  - Semaphore and result pointers of an unprivileged caller have to lie in its own
+ *    stack or data region, otherwise the caller is killed like on an MPU fault
+ * Param "frame": Caller's exception frame (R0-R3, R12, LR, PC, xPSR)
+ * Param "unprivileged": CONTROL.nPRIV of the caller
+ */
+void G8RTOS_SVCHandler(uint32_t *frame, uint32_t unprivileged)
+{
+    //SVC is a 16 bit instruction with the number in its low byte
+    uint8_t number = ((uint8_t *)frame[FRAME_PC])[-2];
+
+    CallerUnprivileged = (unprivileged != 0);
+
+    //Semaphores and the FIFO result are passed by pointer, an unprivileged caller only gets
+    //its own memory written. Anything else is handled like an MPU violation, the caller is killed
+    bool ownsArgument = true;
+    if(number == SVC_INIT_SEMAPHORE || number == SVC_WAIT_SEMAPHORE || number == SVC_SIGNAL_SEMAPHORE){
+        ownsArgument = G8RTOS_CallerOwnsAddress((void *)frame[FRAME_R0], sizeof(semaphore_t));
+    }
+    else if(number == SVC_READ_FIFO){
+        ownsArgument = G8RTOS_CallerOwnsAddress((void *)frame[FRAME_R1], sizeof(int32_t));
+    }
+    if(!ownsArgument){
+        CallerUnprivileged = false;
+        if(G8RTOS_KillSelf() != NO_ERROR){
+            while(1);   //Nothing left to run
+        }
+        return;
+    }
+
+    switch(number){
+    case SVC_SLEEP:
+        sleep(frame[FRAME_R0]);
+        break;
+    case SVC_ADD_THREAD:
+        frame[FRAME_R0] = G8RTOS_AddThread((void (*)(void))frame[FRAME_R0], (uint8_t)frame[FRAME_R1], (char *)frame[FRAME_R2]);
+        break;
+    case SVC_ADD_PERIODIC_THREAD:
+        frame[FRAME_R0] = G8RTOS_AddPeriodicThread((void (*)(void))frame[FRAME_R0], (uint8_t)frame[FRAME_R1], (char *)frame[FRAME_R2],
+                                                   frame[FRAME_R3], FifthArgument(frame));
+        break;
+    case SVC_ADD_PROTECTED_THREAD:
+        frame[FRAME_R0] = G8RTOS_AddProtectedThread((void (*)(void))frame[FRAME_R0], (uint8_t)frame[FRAME_R1], (char *)frame[FRAME_R2],
+                                                    (void *)frame[FRAME_R3], FifthArgument(frame));
+        break;
+    case SVC_ADD_PERIODIC_EVENT:
+        frame[FRAME_R0] = G8RTOS_AddPeriodicEvent((void (*)(void))frame[FRAME_R0], frame[FRAME_R1], frame[FRAME_R2]);
+        break;
+    case SVC_ADD_APERIODIC_EVENT:
+        frame[FRAME_R0] = G8RTOS_AddAPeriodicEvent((void (*)(void))frame[FRAME_R0], (uint8_t)frame[FRAME_R1], (IRQn_Type)frame[FRAME_R2]);
+        break;
+    case SVC_KILL_THREAD:
+        frame[FRAME_R0] = G8RTOS_KillThread((threadId_t)frame[FRAME_R0]);
+        break;
+    case SVC_KILL_SELF:
+        frame[FRAME_R0] = G8RTOS_KillSelf();
+        break;
+    case SVC_INIT_SEMAPHORE:
+        G8RTOS_InitSemaphore((semaphore_t *)frame[FRAME_R0], (int32_t)frame[FRAME_R1]);
+        break;
+    case SVC_WAIT_SEMAPHORE:
+        G8RTOS_WaitSemaphore((semaphore_t *)frame[FRAME_R0]);   //PendSV tail-chains if the caller blocked
+        break;
+    case SVC_SIGNAL_SEMAPHORE:
+        G8RTOS_SignalSemaphore((semaphore_t *)frame[FRAME_R0]);
+        break;
+    case SVC_INIT_FIFO:
+        frame[FRAME_R0] = G8RTOS_InitFIFO(frame[FRAME_R0]);
+        break;
+    case SVC_WRITE_FIFO:
+        frame[FRAME_R0] = writeFIFO(frame[FRAME_R0], (int32_t)frame[FRAME_R1]);
+        break;
+    case SVC_READ_FIFO:
+        frame[FRAME_R0] = readFIFOData(frame[FRAME_R0], (int32_t *)frame[FRAME_R1], (bool)frame[FRAME_R2]);
+        break;
+    case SVC_WATCHDOG_REGISTER:
+        frame[FRAME_R0] = G8RTOS_WatchdogRegister(frame[FRAME_R0], (watchdog_Recovery_t)frame[FRAME_R1]);
+        break;
+    case SVC_WATCHDOG_CHECK_IN:
+        G8RTOS_WatchdogCheckIn();
+        break;
+    default:
+        break;  //Unknown call, caller gets its R0 back
+    }
+
+    CallerUnprivileged = false;
+}
+
+/*********************************************** Public Functions *********************************************************************/
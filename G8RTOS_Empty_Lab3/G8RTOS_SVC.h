@@ -0,0 +1,116 @@
+/*
+ * G8RTOS_SVC.h
+ */
+
+#ifndef G8RTOS_SVC_H_
+#define G8RTOS_SVC_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "G8RTOS_Semaphores.h"
+#include "G8RTOS_Scheduler.h"
+#include "G8RTOS_Watchdog.h"
+
+/*********************************************** Datatype Definitions *****************************************************************/
+
+/*
+ * System call numbers
+ * Must match the SVC immediates in G8RTOS_SVCASM.s
+ */
+typedef enum{
+    SVC_SLEEP                   =   0,
+    SVC_ADD_THREAD              =   1,
+    SVC_ADD_PERIODIC_THREAD     =   2,
+    SVC_ADD_PROTECTED_THREAD    =   3,
+    SVC_ADD_PERIODIC_EVENT      =   4,
+    SVC_ADD_APERIODIC_EVENT     =   5,
+    SVC_KILL_THREAD             =   6,
+    SVC_KILL_SELF               =   7,
+    SVC_INIT_SEMAPHORE          =   8,
+    SVC_WAIT_SEMAPHORE          =   9,
+    SVC_SIGNAL_SEMAPHORE        =   10,
+    SVC_INIT_FIFO               =   11,
+    SVC_WRITE_FIFO              =   12,
+    SVC_READ_FIFO               =   13,
+    SVC_WATCHDOG_REGISTER       =   14,
+    SVC_WATCHDOG_CHECK_IN       =   15
+} svc_Number_t;
+
+/*********************************************** Datatype Definitions *****************************************************************/
+
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Returns: true if called from a thread with interrupts enabled
+ * Threads never touch kernel data themselves, every kernel call traps through SVC
+ * and runs at kernel priority, so kernel calls are serialized against each other,
+ * PendSV and SysTick without turning interrupts off
+ */
+extern bool G8RTOS_InThreadMode();
+
+/*
+ * Kernel side only
+ * Starts a kernel section
+ *  - Masks interrupts that may call the kernel (SYSCALL_PRIORITY and lower)
+ *  - Interrupts above SYSCALL_PRIORITY are never held off by the kernel
+ *  - Nests, only the outermost section is timed
+ * Returns: State to hand back to G8RTOS_KernelExit
+ */
+int32_t G8RTOS_KernelEnter();
+
+/*
+ * Kernel side only
+ * Ends a kernel section started by G8RTOS_KernelEnter
+ * Param "state": Value returned by G8RTOS_KernelEnter
+ */
+void G8RTOS_KernelExit(int32_t state);
+
+/*
+ * Returns: Longest kernel section so far in CPU cycles (worst case added interrupt latency)
+ */
+uint32_t G8RTOS_GetMaxKernelSection();
+
+/*
+ * Kernel side only
+ * Returns: true while the kernel is servicing a system call made by an unprivileged thread
+ */
+bool G8RTOS_CallerIsUnprivileged();
+
+/*
+ * C part of the SVC handler (called from SVC_Handler in asm)
+ *  - Runs at kernel priority (OSINT_PRIORITY) like PendSV and SysTick
+ *  - Decodes the SVC number from the instruction before the stacked PC
+ *  - Calls the kernel function with the stacked arguments
+ *  - Writes the return value into the stacked R0
+ *  - Semaphore and result pointers of an unprivileged caller have to lie in its own
+ *    stack or data region, otherwise the caller is killed like on an MPU fault
+ * Param "frame": Caller's exception frame (R0-R3, R12, LR, PC, xPSR)
+ * Param "unprivileged": CONTROL.nPRIV of the caller
+ */
+void G8RTOS_SVCHandler(uint32_t *frame, uint32_t unprivileged);
+
+/*
+ * System call stubs (G8RTOS_SVCASM.s)
+ * Same arguments as the kernel functions they trap into
+ */
+extern void G8RTOS_SVC_Sleep(uint32_t durationMS);
+extern sched_ErrCode_t G8RTOS_SVC_AddThread(void (*threadToAdd)(void), uint8_t priority, char * name);
+extern sched_ErrCode_t G8RTOS_SVC_AddPeriodicThread(void (*threadToAdd)(void), uint8_t priority, char * name, uint32_t period, uint32_t wcet);
+extern sched_ErrCode_t G8RTOS_SVC_AddProtectedThread(void (*threadToAdd)(void), uint8_t priority, char * name, void * data, uint32_t dataSize);
+extern sched_ErrCode_t G8RTOS_SVC_AddPeriodicEvent(void (*PthreadToAdd)(void), uint32_t period, uint32_t wcet);
+extern sched_ErrCode_t G8RTOS_SVC_AddAPeriodicEvent(void (*AthreadToAdd)(void), uint8_t priority, IRQn_Type IRQn);
+extern sched_ErrCode_t G8RTOS_SVC_KillThread(threadId_t threadId);
+extern sched_ErrCode_t G8RTOS_SVC_KillSelf();
+extern void G8RTOS_SVC_InitSemaphore(semaphore_t *s, int32_t value);
+extern void G8RTOS_SVC_WaitSemaphore(semaphore_t *s);
+extern void G8RTOS_SVC_SignalSemaphore(semaphore_t *s);
+extern int G8RTOS_SVC_InitFIFO(uint32_t FIFOIndex);
+extern int G8RTOS_SVC_WriteFIFO(uint32_t FIFO, int32_t data);
+extern bool G8RTOS_SVC_ReadFIFO(uint32_t FIFO, int32_t *data, bool woken);
+extern sched_ErrCode_t G8RTOS_SVC_WatchdogRegister(uint32_t periodMS, watchdog_Recovery_t recovery);
+extern void G8RTOS_SVC_WatchdogCheckIn();
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* G8RTOS_SVC_H_ */
@@ -0,0 +1,154 @@
+; G8RTOS_SVCASM.s
+; Holds the SVC entry and the system call stubs every thread enters the kernel through
+; Note: If you have an h file, do not have a C file and an S file of the same name
+
+	; Functions Defined
+	.def SVC_Handler, G8RTOS_InThreadMode
+	.def G8RTOS_SVC_Sleep, G8RTOS_SVC_AddThread, G8RTOS_SVC_AddPeriodicThread, G8RTOS_SVC_AddProtectedThread
+	.def G8RTOS_SVC_AddPeriodicEvent, G8RTOS_SVC_AddAPeriodicEvent, G8RTOS_SVC_KillThread, G8RTOS_SVC_KillSelf
+	.def G8RTOS_SVC_InitSemaphore, G8RTOS_SVC_WaitSemaphore, G8RTOS_SVC_SignalSemaphore
+	.def G8RTOS_SVC_InitFIFO, G8RTOS_SVC_WriteFIFO, G8RTOS_SVC_ReadFIFO
+	.def G8RTOS_SVC_WatchdogRegister, G8RTOS_SVC_WatchdogCheckIn
+
+	; Dependencies
+	.ref G8RTOS_SVCHandler
+
+	.thumb		; Set to thumb mode
+	.align 2	; Align by 2 bytes (thumb mode uses allignment by 2 or 4)
+	.text		; Text section
+
+; SVC_Handler
+; - Entry point of every system call
+;	- Finds the caller's exception frame (PSP for threads, MSP before launch)
+;	- Passes the caller's privilege level along
+;	- Tail calls G8RTOS_SVCHandler(frame, unprivileged), which returns through LR
+SVC_Handler:
+	.asmfunc
+	TST LR, #4	;EXC_RETURN bit 2 tells which stack the caller was on
+	ITE EQ
+	MRSEQ R0, MSP
+	MRSNE R0, PSP
+	MRS R1, CONTROL	;nPRIV still belongs to the calling thread
+	AND R1, R1, #1
+	B G8RTOS_SVCHandler
+	.endasmfunc
+
+; G8RTOS_InThreadMode
+; Returns 1 if a kernel call has to trap through SVC
+;	- Handlers are already at kernel level and run the call directly
+;	- Thread code with PRIMASK set can't take the SVC (it would escalate to a
+;	  HardFault) and is already serialized, it runs the call directly too
+G8RTOS_InThreadMode:
+	.asmfunc
+	MRS R0, IPSR
+	MRS R1, PRIMASK
+	ORRS R0, R0, R1
+	ITE EQ
+	MOVEQ R0, #1
+	MOVNE R0, #0
+	BX LR
+	.endasmfunc
+
+; System call stubs
+; Arguments are already in R0-R3 (and on the stack for a fifth one), the
+; hardware stacks them and G8RTOS_SVCHandler writes the result into stacked R0.
+; SVC numbers must match svc_Number_t in G8RTOS_SVC.h
+G8RTOS_SVC_Sleep:
+	.asmfunc
+	SVC #0
+	BX LR
+	.endasmfunc
+
+G8RTOS_SVC_AddThread:
+	.asmfunc
+	SVC #1
+	BX LR
+	.endasmfunc
+
+G8RTOS_SVC_AddPeriodicThread:
+	.asmfunc
+	SVC #2
+	BX LR
+	.endasmfunc
+
+G8RTOS_SVC_AddProtectedThread:
+	.asmfunc
+	SVC #3
+	BX LR
+	.endasmfunc
+
+G8RTOS_SVC_AddPeriodicEvent:
+	.asmfunc
+	SVC #4
+	BX LR
+	.endasmfunc
+
+G8RTOS_SVC_AddAPeriodicEvent:
+	.asmfunc
+	SVC #5
+	BX LR
+	.endasmfunc
+
+G8RTOS_SVC_KillThread:
+	.asmfunc
+	SVC #6
+	BX LR
+	.endasmfunc
+
+G8RTOS_SVC_KillSelf:
+	.asmfunc
+	SVC #7
+	BX LR
+	.endasmfunc
+
+G8RTOS_SVC_InitSemaphore:
+	.asmfunc
+	SVC #8
+	BX LR
+	.endasmfunc
+
+G8RTOS_SVC_WaitSemaphore:
+	.asmfunc
+	SVC #9
+	BX LR
+	.endasmfunc
+
+G8RTOS_SVC_SignalSemaphore:
+	.asmfunc
+	SVC #10
+	BX LR
+	.endasmfunc
+
+G8RTOS_SVC_InitFIFO:
+	.asmfunc
+	SVC #11
+	BX LR
+	.endasmfunc
+
+G8RTOS_SVC_WriteFIFO:
+	.asmfunc
+	SVC #12
+	BX LR
+	.endasmfunc
+
+G8RTOS_SVC_ReadFIFO:
+	.asmfunc
+	SVC #13
+	BX LR
+	.endasmfunc
+
+G8RTOS_SVC_WatchdogRegister:
+	.asmfunc
+	SVC #14
+	BX LR
+	.endasmfunc
+
+G8RTOS_SVC_WatchdogCheckIn:
+	.asmfunc
+	SVC #15
+	BX LR
+	.endasmfunc
+
+	; end of the asm file
+	.align
+	.end
@@ -0,0 +1,262 @@
+/*
+ * G8RTOS_Schedulability.c
+ */
+
+/*********************************************** Dependencies and Externs *************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "msp.h"
+#include "G8RTOS_Schedulability.h"
+#include "G8RTOS_SVC.h"
+
+/* System Core Clock From system_msp432p401r.c */
+extern uint32_t SystemCoreClock;
+
+/*********************************************** Dependencies and Externs *************************************************************/
+
+
+/*********************************************** Defines ******************************************************************************/
+
+/* Utilization is kept in parts per million so everything stays integer */
+#define PPM 1000000
+
+/* Liu-Layland bound n(2^(1/n) - 1) once n gets large (ln 2) */
+#define LIU_LAYLAND_LIMIT 693147
+
+/*********************************************** Defines ******************************************************************************/
+
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+/* Declared periodic work, periodic events and periodic threads share this table */
+static rtTask_t RTTasks[MAX_RT_TASKS];
+
+/* Liu-Layland bound n(2^(1/n) - 1) in ppm for n = 1..10 */
+static const uint32_t LiuLaylandBound[10] = {
+    1000000, 828427, 779763, 756828, 743492, 734772, 728627, 724062, 720538, 717735
+};
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*
+ * Utilization of one task in ppm
+ * Period is in ms and WCET in us so C/T = WCET * 1000 / Period ppm
+ * 64-bit product, WCET * 1000 is past 32 bits from about 71 minutes on
+ */
+static uint32_t TaskUtilization(rtTask_t *task)
+{
+    return (uint32_t)(((uint64_t)task->WCET * 1000) / task->Period);
+}
+
+/*
+ * Returns true if task j can preempt (or delay) task i
+ * Equal level with a shorter or equal period is counted as interference,
+ * round robin between equal priorities makes this the safe choice
+ */
+static bool Interferes(rtTask_t *j, rtTask_t *i)
+{
+    if(j == i){
+        return false;
+    }
+    if(j->Level < i->Level){
+        return true;
+    }
+    return (j->Level == i->Level) && (j->Period <= i->Period);
+}
+
+/*
+ * Exact response time analysis for fixed priorities
+ *  R = C_i + sum over hp(i) of ceil(R / T_j) * C_j, iterated until it settles
+ *  Fails as soon as R is past the deadline (deadline = period)
+ */
+static bool ResponseTimeTest()
+{
+    int i, j;
+    for(i = 0; i < MAX_RT_TASKS; i++){
+        rtTask_t *task = &RTTasks[i];
+        if(!task->inUse){
+            continue;
+        }
+
+        //64-bit, a long period in us and the interference sums do not fit 32 bits
+        uint64_t deadline = (uint64_t)task->Period * 1000;    //ms to us
+        uint64_t response = task->WCET;
+        uint64_t next = 0;
+
+        while(response <= deadline){
+            next = task->WCET;
+            for(j = 0; j < MAX_RT_TASKS; j++){
+                rtTask_t *other = &RTTasks[j];
+                if(other->inUse && Interferes(other, task)){
+                    uint64_t otherPeriod = (uint64_t)other->Period * 1000;
+                    next += ((response + otherPeriod - 1) / otherPeriod) * other->WCET;
+                }
+            }
+
+            if(next == response){
+                break;  //Settled
+            }
+            response = next;
+        }
+
+        if(response > deadline){
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * Schedulability test of the current table
+ *  - Utilization above 100% can never be scheduled
+ *  - At or under the Liu-Layland bound is always schedulable
+ *  - Anything in between needs the exact test
+ */
+static bool TaskSetSchedulable()
+{
+    uint32_t utilization = 0;
+    uint32_t n = 0;
+    int i;
+    for(i = 0; i < MAX_RT_TASKS; i++){
+        if(RTTasks[i].inUse){
+            utilization += TaskUtilization(&RTTasks[i]);
+            n++;
+        }
+    }
+
+    if(utilization > PPM){
+        return false;
+    }
+
+    if(n == 0 || utilization <= ((n <= 10) ? LiuLaylandBound[n-1] : LIU_LAYLAND_LIMIT)){
+        return true;
+    }
+
+    return ResponseTimeTest();
+}
+
+/*********************************************** Private Functions ********************************************************************/
+
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Admits a piece of periodic work into the task set
+ *  - Quick Liu-Layland utilization bound first
+ *  - Exact response time analysis if the bound is exceeded
+ *  - Task set is left untouched if the new task would make it unschedulable
+ * Param "period": Declared period in ms (system ticks)
+ * Param "wcet": Declared worst case execution time in us
+ * Param "level": Analysis level of the work (RT_LEVEL_*)
+ * Param "task": Returns the handle of the admitted task
+ * Returns: NO_ERROR, THREAD_LIMIT_REACHED or SCHEDULE_INFEASIBLE
+ */
+sched_ErrCode_t G8RTOS_AdmitTask(uint32_t period, uint32_t wcet, uint16_t level, rtTask_t **task)
+{
+    //A zero period, or a job longer than its period, can never meet its deadline.
+    //Also keeps every utilization term at or under PPM so their sum fits 32 bits
+    if(period == 0 || (uint64_t)wcet > (uint64_t)period * 1000){
+        return SCHEDULE_INFEASIBLE;
+    }
+
+    int32_t state = G8RTOS_KernelEnter();
+
+    //Find a free slot for the candidate
+    rtTask_t *candidate = 0;
+    int i;
+    for(i = 0; i < MAX_RT_TASKS; i++){
+        if(!RTTasks[i].inUse){
+            candidate = &RTTasks[i];
+            break;
+        }
+    }
+
+    if(candidate == 0){
+        G8RTOS_KernelExit(state);
+        return THREAD_LIMIT_REACHED;
+    }
+
+    //Tentatively add it and test the whole set
+    candidate->Period = period;
+    candidate->WCET = wcet;
+    candidate->Level = level;
+    candidate->Jobs = 0;
+    candidate->MaxExecution = 0;
+    candidate->Overruns = 0;
+    candidate->inUse = true;
+
+    if(!TaskSetSchedulable()){
+        candidate->inUse = false;   //Reject, set stays the way it was
+        G8RTOS_KernelExit(state);
+        return SCHEDULE_INFEASIBLE;
+    }
+
+    *task = candidate;
+    G8RTOS_KernelExit(state);
+    return NO_ERROR;
+}
+
+/*
+ * Removes a task from the task set (thread killed)
+ * Param "task": Handle returned by G8RTOS_AdmitTask
+ */
+void G8RTOS_ReleaseTask(rtTask_t *task)
+{
+    if(task != 0){
+        task->inUse = false;
+    }
+}
+
+/*
+ * Runtime monitor, records one finished job of a task
+ * Param "task": Task the job belongs to
+ * Param "cycles": Measured execution time of the job in CPU cycles (DWT)
+ */
+void G8RTOS_RecordExecution(rtTask_t *task, uint32_t cycles)
+{
+    uint32_t executionTime = cycles / (SystemCoreClock / 1000000);  //cycles to us
+
+    task->Jobs++;
+    if(executionTime > task->MaxExecution){
+        task->MaxExecution = executionTime;
+    }
+    if(executionTime > task->WCET){
+        task->Overruns++;
+    }
+}
+
+/*
+ * Returns: Total declared utilization of the task set in parts per million
+ */
+uint32_t G8RTOS_GetUtilization()
+{
+    uint32_t utilization = 0;
+    int i;
+    for(i = 0; i < MAX_RT_TASKS; i++){
+        if(RTTasks[i].inUse){
+            utilization += TaskUtilization(&RTTasks[i]);
+        }
+    }
+    return utilization;
+}
+
+/*
+ * Returns: Number of jobs (all tasks) that exceeded their declared WCET
+ */
+uint32_t G8RTOS_GetBudgetOverruns()
+{
+    uint32_t overruns = 0;
+    int i;
+    for(i = 0; i < MAX_RT_TASKS; i++){
+        if(RTTasks[i].inUse){
+            overruns += RTTasks[i].Overruns;
+        }
+    }
+    return overruns;
+}
+
+/*********************************************** Public Functions *********************************************************************/
@@ -0,0 +1,88 @@
+/*
+ * G8RTOS_Schedulability.h
+ */
+
+#ifndef G8RTOS_SCHEDULABILITY_H_
+#define G8RTOS_SCHEDULABILITY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "G8RTOS_Scheduler.h"
+
+/*********************************************** Sizes and Limits *********************************************************************/
+
+/* Every periodic event and every thread can carry a declared budget */
+#define MAX_RT_TASKS (MAXPTHREADS + MAX_THREADS)
+
+/*
+ * Analysis levels (lower level runs first)
+ *  - Periodic events run inside the SysTick handler so they preempt every thread
+ *  - Threads are ordered by their scheduler priority behind the periodic events
+ */
+#define RT_LEVEL_PERIODIC_EVENT     0
+#define RT_LEVEL_THREAD(priority)   ((uint16_t)(priority) + 1)
+
+/*********************************************** Sizes and Limits *********************************************************************/
+
+/*********************************************** Datatype Definitions *****************************************************************/
+
+/*
+ *  Real Time Task:
+ *      - Declared period and worst case execution time of a piece of periodic work
+ *      - Holds what the runtime monitor measured against the declared budget
+ */
+typedef struct rtTask_t{
+    uint32_t Period;        //Declared period in ms (system ticks)
+    uint32_t WCET;          //Declared worst case execution time in us
+    uint16_t Level;         //Analysis level, see RT_LEVEL_*
+    bool inUse;
+
+    uint32_t Jobs;          //Number of completed jobs measured
+    uint32_t MaxExecution;  //Longest measured job in us
+    uint32_t Overruns;      //Jobs that ran longer than WCET
+} rtTask_t;
+
+/*********************************************** Datatype Definitions *****************************************************************/
+
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Admits a piece of periodic work into the task set
+ *  - Quick Liu-Layland utilization bound first
+ *  - Exact response time analysis if the bound is exceeded
+ *  - Task set is left untouched if the new task would make it unschedulable
+ * Param "period": Declared period in ms (system ticks)
+ * Param "wcet": Declared worst case execution time in us
+ * Param "level": Analysis level of the work (RT_LEVEL_*)
+ * Param "task": Returns the handle of the admitted task
+ * Returns: NO_ERROR, THREAD_LIMIT_REACHED or SCHEDULE_INFEASIBLE
+ */
+sched_ErrCode_t G8RTOS_AdmitTask(uint32_t period, uint32_t wcet, uint16_t level, rtTask_t **task);
+
+/*
+ * Removes a task from the task set (thread killed)
+ * Param "task": Handle returned by G8RTOS_AdmitTask
+ */
+void G8RTOS_ReleaseTask(rtTask_t *task);
+
+/*
+ * Runtime monitor, records one finished job of a task
+ * Param "task": Task the job belongs to
+ * Param "cycles": Measured execution time of the job in CPU cycles (DWT)
+ */
+void G8RTOS_RecordExecution(rtTask_t *task, uint32_t cycles);
+
+/*
+ * Returns: Total declared utilization of the task set in parts per million
+ */
+uint32_t G8RTOS_GetUtilization();
+
+/*
+ * Returns: Number of jobs (all tasks) that exceeded their declared WCET
+ */
+uint32_t G8RTOS_GetBudgetOverruns();
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* G8RTOS_SCHEDULABILITY_H_ */
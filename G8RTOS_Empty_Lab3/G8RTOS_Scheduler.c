@@ -13,7 +13,8 @@
 #include "BSP.h"
 #include "interrupt.h"
 #include <stdbool.h>
-#include "G8RTOS_CriticalSection.h"
+#include "G8RTOS_SVC.h"
+#include "G8RTOS_Watchdog.h"
 /*
  * G8RTOS_Start exists in asm
  */
@@ -35,6 +36,30 @@ extern tcb_t * CurrentlyRunningThread;
 /* Status Register with the Thumb-bit Set */
 #define THUMBBIT 0x01000000
 
+/* VTOR gets relocated here by G8RTOS_Init */
+#define SRAM_VECTOR_TABLE 0x20000000
+#define VECTOR_TABLE_SIZE (57*4)
+
+/*
+ * MPU regions, higher numbers win where regions overlap
+ *  - 0-2 are fixed and only matter to unprivileged threads (privileged code keeps the default map)
+ *  - 3-4 are reloaded by PendSV for every thread
+ */
+#define MPU_FLASH_REGION        0
+#define FLASH_REGION_END        0x04000000      //MPU_FLASH_REGION covers the first 64 MB
+#define MPU_SRAM_REGION         1
+#define MPU_PERIPHERAL_REGION   2
+#define MPU_STACK_REGION        3
+#define MPU_DATA_REGION         4
+
+/* Memory attributes for the RASR (TEX = 0) */
+#define MPU_ATTR_FLASH          MPU_RASR_C_Msk                      //Normal, write through
+#define MPU_ATTR_SRAM           (MPU_RASR_S_Msk | MPU_RASR_C_Msk)   //Normal, shareable
+#define MPU_ATTR_PERIPHERAL     MPU_RASR_B_Msk                      //Device
+
+/* Each thread stack is STACKSIZE words and is mapped as one region */
+#define STACK_REGION_SIZE       MPU_RGN_SIZE_1K
+
 /*********************************************** Defines ******************************************************************************/
 
 
@@ -47,7 +72,9 @@ static tcb_t threadControlBlocks[MAX_THREADS];
 
 /* Thread Stacks
  *	- An array of arrays that will act as invdividual stacks for each thread
+ *	- Every stack is aligned to its size so it can be one MPU region
  */
+#pragma DATA_ALIGN(threadStacks, 1024)
 static int32_t threadStacks[MAX_THREADS][STACKSIZE];
 
 /* Periodic Event Threads
@@ -80,6 +107,12 @@ static uint16_t currentMaxPriority = 256;
 //used to count number of threads initialized
 static uint16_t IDCounter = 0;
 
+//Fixed MPU regions only get set up once the first protected thread is added
+static bool MPUEnabled = false;
+
+//Set by G8RTOS_Launch, drivers only block on semaphores once threads exist
+static bool Launched = false;
+
 /*********************************************** Private Functions ********************************************************************/
 
 /*
@@ -95,6 +128,118 @@ static void InitSysTick(uint32_t numCycles)
 
 }
 
+/*
+ * Sets up the fixed MPU regions and turns the MPU on
+ *  - Flash (and ROM) read only and executable for threads
+ *  - SRAM read only for threads, so kernel data and the vector table are safe
+ *  - Peripherals fully accessible so drivers still work from unprivileged threads
+ *  - Privileged code keeps the default memory map
+ */
+static void InitMPU()
+{
+    MPU_setRegion(MPU_FLASH_REGION, 0x00000000,
+                  MPU_RGN_SIZE_64M | MPU_RGN_PERM_EXEC | MPU_RGN_PERM_PRV_RW_USR_RO | MPU_ATTR_FLASH | MPU_RGN_ENABLE);
+    MPU_setRegion(MPU_SRAM_REGION, 0x20000000,
+                  MPU_RGN_SIZE_64K | MPU_RGN_PERM_NOEXEC | MPU_RGN_PERM_PRV_RW_USR_RO | MPU_ATTR_SRAM | MPU_RGN_ENABLE);
+    MPU_setRegion(MPU_PERIPHERAL_REGION, 0x40000000,
+                  MPU_RGN_SIZE_512M | MPU_RGN_PERM_NOEXEC | MPU_RGN_PERM_PRV_RW_USR_RW | MPU_ATTR_PERIPHERAL | MPU_RGN_ENABLE);
+
+    __NVIC_SetPriority(MemoryManagement_IRQn, OSINT_PRIORITY);   //Kills threads, so it runs at kernel priority
+    SCB->SHCSR |= SCB_SHCSR_MEMFAULTENA_Msk;    //Violations go to MemManage_Handler instead of HardFault
+    MPU_enableModule(MPU_CONFIG_PRIV_DEFAULT);
+    MPUEnabled = true;
+}
+
+/*
+ * Turns a region size in bytes into the RASR size field
+ * Returns: 0 if the size is not a power of two of at least 32 bytes
+ */
+static uint32_t RegionSizeField(uint32_t size)
+{
+    if(size < 32 || (size & (size - 1))){
+        return 0;
+    }
+
+    uint32_t log2 = 0;
+    while(size > 1){
+        size >>= 1;
+        log2++;
+    }
+    return (log2 - 1) << 1;
+}
+
+/*
+ * Returns: true if [addr, addr + size) lies inside an enabled per-thread region
+ * Param "rbar", "rasr": Region pair as kept in tcb_t MPURegions
+ */
+static bool InThreadRegion(uint32_t rbar, uint32_t rasr, uint32_t addr, uint32_t size)
+{
+    if(!(rasr & MPU_RASR_ENABLE_Msk)){
+        return false;
+    }
+
+    uint32_t base = rbar & MPU_RBAR_ADDR_Msk;
+    uint32_t regionSize = 2UL << ((rasr & MPU_RASR_SIZE_Msk) >> MPU_RASR_SIZE_Pos);
+    return addr >= base && size <= regionSize && (addr - base) <= regionSize - size;
+}
+
+/*
+ * Returns: true if the calling thread may have the kernel read the byte at addr
+ *  - Its own stack and data regions, and flash where name literals live (read only for everyone)
+ */
+static bool CallerCanRead(const char *addr)
+{
+    return ((uint32_t)addr < FLASH_REGION_END) || G8RTOS_CallerOwnsAddress(addr, 1);
+}
+
+/*
+ * Makes a thread unprivileged and gives it its stack and data regions
+ * Param "tcb": Thread to protect
+ * Param "data": Base of the data region, 0 for stack only
+ * Param "dataSizeField": RASR size field of the data region (already validated)
+ */
+static void ProtectThread(tcb_t *tcb, void *data, uint32_t dataSizeField)
+{
+    uint32_t index = tcb - threadControlBlocks;     //Stacks and tcbs share the index
+
+    tcb->Unprivileged = 1;
+    tcb->MPURegions[0] = (uint32_t)threadStacks[index] | MPU_RBAR_VALID_Msk | MPU_STACK_REGION;
+    tcb->MPURegions[1] = STACK_REGION_SIZE | MPU_RGN_PERM_NOEXEC | MPU_RGN_PERM_PRV_RW_USR_RW | MPU_ATTR_SRAM | MPU_RGN_ENABLE;
+
+    if(data != 0){
+        tcb->MPURegions[2] = (uint32_t)data | MPU_RBAR_VALID_Msk | MPU_DATA_REGION;
+        tcb->MPURegions[3] = dataSizeField | MPU_RGN_PERM_NOEXEC | MPU_RGN_PERM_PRV_RW_USR_RW | MPU_ATTR_SRAM | MPU_RGN_ENABLE;
+    }
+}
+
+/*
+ * Gives a thread a fresh fake context that starts at its entry point
+ * Param "tcb": Thread to reset, must not be running (PendSV saves over it otherwise)
+ */
+static void ResetContext(tcb_t *tcb)
+{
+    uint32_t index = tcb - threadControlBlocks;     //Stacks and tcbs share the index
+
+    /*
+     * 1008 = SP (R13) (Moves up/down automatically as stack changes)
+     * 1009-1016 = R4:R11 (1024 - 15 to 1024 - 8)
+     * 1017-1020 = R0:3, R12 (1024 - 7 to 1024-4)
+     * 1021 = LR (R14) (1024-3)
+     * 1022 = PC (R15) (1024 - 2)
+     * 1023 = PSR
+     */
+    tcb->Stack_Pointer = &threadStacks[index][STACKSIZE-16];
+    int i = 0;
+    for(i = 3; i < 16; i++){    //Give R0-R12 default values of 0b101 (for testing purposes)
+        threadStacks[index][STACKSIZE-i] = 5; //Look at table above
+    }
+
+    threadStacks[index][STACKSIZE-2] = (int32_t)tcb->Entry; //PC to threads function pointer. int32_t fixes warning about void void
+    threadStacks[index][STACKSIZE-1] = THUMBBIT;   //PSR to some value with thumb-bit set
+
+    tcb->RestartPending = false;
+}
+
 /*
  * Chooses the next thread to run.
  * Lab 2 Scheduling Algorithm:
@@ -104,6 +249,18 @@ static void InitSysTick(uint32_t numCycles)
 void G8RTOS_Scheduler()
 {
 	/* Implement This */
+    //Runs inside PendSV at kernel priority, only interrupts that may call the kernel are held off
+    int32_t state = G8RTOS_KernelEnter();
+
+    //Charge the outgoing thread for the time it just ran (budget monitor)
+    uint32_t now = DWT->CYCCNT;
+    CurrentlyRunningThread->JobCycles += now - CurrentlyRunningThread->SwitchInCycles;
+
+    //Watchdog restarted the outgoing thread, its context was just saved so it can be replaced now
+    if(CurrentlyRunningThread->RestartPending){
+        ResetContext(CurrentlyRunningThread);
+    }
+
     //Set to next thread in linked list fot round robin scheduling
     tcb_t *tempNextThread = CurrentlyRunningThread->nextTCB;
 
@@ -113,7 +270,7 @@ void G8RTOS_Scheduler()
     //semaphore_t test = 1;
 
     //Checks self here
-    if((CurrentlyRunningThread->Asleep) || (CurrentlyRunningThread->blocked < 0) || !(CurrentlyRunningThread->isAlive)){
+    if((CurrentlyRunningThread->Asleep) || (CurrentlyRunningThread->blocked != 0) || !(CurrentlyRunningThread->isAlive)){
         currentMaxPriority = 256;
     }
 
@@ -125,7 +282,7 @@ void G8RTOS_Scheduler()
     //DOes not use -1 because needs to check self
     //Use -1 if no need to check self
     for(i = 0; i < NumberOfThreads-1; i++){
-        if(!((tempNextThread->Asleep) || ((tempNextThread->blocked) < 0) || !(tempNextThread->isAlive)) ){
+        if(!((tempNextThread->Asleep) || ((tempNextThread->blocked) != 0) || !(tempNextThread->isAlive)) ){
             if(tempNextThread->priority < currentMaxPriority){
                 CurrentlyRunningThread = tempNextThread;
                 currentMaxPriority = tempNextThread->priority;
@@ -134,6 +291,10 @@ void G8RTOS_Scheduler()
         tempNextThread = tempNextThread->nextTCB;
     }
 
+    CurrentlyRunningThread->SwitchInCycles = now;
+
+    G8RTOS_KernelExit(state);
+
 //    //If thread if asleep or blocked then we assign the next tcb as the current tcb
 //    while((CurrentlyRunningThread->Asleep) || (*(CurrentlyRunningThread->blocked) < 0)){
 //        CurrentlyRunningThread = CurrentlyRunningThread->nextTCB;
@@ -161,7 +322,11 @@ void SysTick_Handler()
     for(i = 0; i < NumberOfPthreads; i++){
         if(Pptr->Execute_Time == SystemTime){
             Pptr->Execute_Time = Pptr->Period + SystemTime;
+            uint32_t start = DWT->CYCCNT;
             Pptr->Handler();
+            if(Pptr->RTTask){
+                G8RTOS_RecordExecution(Pptr->RTTask, DWT->CYCCNT - start);   //Check against declared budget
+            }
         }
         Pptr = Pptr->Next_P_Event;
     }
@@ -169,6 +334,8 @@ void SysTick_Handler()
     //increment system time after periodic thread to avoid initial time 0 threads not running
     SystemTime++;
 
+        //Thread list can change under an interrupt that calls the kernel
+        int32_t state = G8RTOS_KernelEnter();
         tcb_t *ptr = CurrentlyRunningThread;
         for(i = 0; i < NumberOfThreads; i++){
             if(ptr->Asleep){
@@ -181,6 +348,10 @@ void SysTick_Handler()
 
             ptr = ptr->nextTCB;
         }
+        G8RTOS_KernelExit(state);
+
+        //Missed check-ins get their recovery right away, restarts happen in the PendSV below
+        G8RTOS_WatchdogTick();
 
 //        SystemTime++;
 
@@ -188,6 +359,21 @@ void SysTick_Handler()
                                                     //causing it to execute on the next available time
 }
 
+/*
+ * MemManage Handler
+ * An unprivileged thread touched memory outside of its regions
+ *  - Only the faulting thread is killed, the rest of the system keeps running
+ *  - PendSV tail-chains on the way out so the thread never resumes
+ */
+void MemManage_Handler()
+{
+    SCB->CFSR = SCB_CFSR_MEMFAULTSR_Msk;    //Write one to clear the MemManage status
+
+    if(!CurrentlyRunningThread->Unprivileged || (G8RTOS_KillThread(CurrentlyRunningThread->threadID) != NO_ERROR)){
+        while(1);   //Kernel itself faulted or nothing left to run
+    }
+}
+
 /*********************************************** Private Functions ********************************************************************/
 
 
@@ -212,10 +398,21 @@ void G8RTOS_Init()
 
         //Relocate ISR interrupt vector table to SRAM so we can relocate an ISRs interrupt vector
         //We will relocate the table to 0x200000000
-        uint32_t newVTORTable = 0x20000000;
-        memcpy((uint32_t *)newVTORTable, (uint32_t *)SCB->VTOR, 57*4);  // 57 interrupt vectors to copy
+        uint32_t newVTORTable = SRAM_VECTOR_TABLE;
+        memcpy((uint32_t *)newVTORTable, (uint32_t *)SCB->VTOR, VECTOR_TABLE_SIZE);  // 57 interrupt vectors to copy
         SCB->VTOR=newVTORTable;
 
+        //SVC, PendSV and SysTick share the kernel priority so they never preempt each other,
+        //kernel calls are serialized without disabling interrupts
+        __NVIC_SetPriority(SVCall_IRQn, OSINT_PRIORITY);
+        __NVIC_SetPriority(PendSV_IRQn, OSINT_PRIORITY);
+        __NVIC_SetPriority(SysTick_IRQn, OSINT_PRIORITY);
+
+        //Cycle counter for the budget monitor
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
         SystemTime = 0;
         NumberOfThreads = 0;
         BSP_InitBoard();    //Inits the whole board
@@ -245,17 +442,26 @@ int G8RTOS_Launch()
     }
     uint32_t numcycles = 48000;  //0.001 * 48*10^6
     InitSysTick(numcycles);  //Init the systick
-    Interrupt_setPriority(FAULT_PENDSV, 7); //Lowest priority
-    Interrupt_setPriority(FAULT_SYSTICK, 7);    //Lowest priority
-    //Interrupt_setPriority(FAULT_PENDSV, 0xE0); //Lowest priority
-    //Interrupt_setPriority(FAULT_SYSTICK, 0xC0);    //2nd Lowest priority
+    //PendSV and SysTick priorities are set in G8RTOS_Init (Interrupt_setPriority wants the
+    //priority in the top 3 bits, 7 there was really priority 0)
     //SysTick_enableInterrupt();    //Dont need, enabled in assembly
     SysTick_enableInterrupt();
+    CurrentlyRunningThread->SwitchInCycles = DWT->CYCCNT;   //First job starts now
+    Launched = true;
     G8RTOS_Start();
     return -1; //Failure code :(
 }
 
 
+/*
+ * Returns: true once G8RTOS_Launch started the first thread
+ * Drivers use it to decide between blocking on a semaphore and spinning
+ */
+bool G8RTOS_IsRunning()
+{
+    return Launched;
+}
+
 /*
  * Adds threads to G8RTOS Scheduler
  * 	- Checks if there are stil available threads to insert to scheduler
@@ -266,10 +472,25 @@ int G8RTOS_Launch()
  * Param "threadToAdd": Void-Void Function to add as preemptable main thread
  * Returns: Error code for adding threads
  */
-sched_ErrCode_t G8RTOS_AddThread(void (*threadToAdd)(void), uint8_t priority, char * name)
+static sched_ErrCode_t AddThread(void (*threadToAdd)(void), uint8_t priority, char * name)
 {
+    //The name is copied privileged, an unprivileged caller may only hand in memory it can read itself
+    int i = 0;
+    if(name == 0){
+        name = "";
+    }
+    if(G8RTOS_CallerIsUnprivileged()){
+        for(i = 0; i < MAX_NAME_LENGTH - 1; i++){
+            if(!CallerCanRead(&name[i])){
+                return PERMISSION_DENIED;
+            }
+            if(name[i] == '\0'){
+                break;
+            }
+        }
+    }
+
     /* Implement this */
-    uint32_t PRIMASK = StartCriticalSection();
     if(NumberOfThreads == MAX_THREADS){
         return THREAD_LIMIT_REACHED;  //Error Code, reached max number of threads, can't add new one
     }
@@ -278,7 +499,6 @@ sched_ErrCode_t G8RTOS_AddThread(void (*threadToAdd)(void), uint8_t priority, ch
     }
 
     tcb_t* newThread = &(threadControlBlocks[NumberOfThreads-1]);
-    newThread->Stack_Pointer = &threadStacks[NumberOfThreads-1][STACKSIZE-16];  //Doesn't matter how many threads
 
     //Only thread so points to itself
     //This might not be necessary?                 GET BACK TO THIS :)
@@ -327,35 +547,37 @@ sched_ErrCode_t G8RTOS_AddThread(void (*threadToAdd)(void), uint8_t priority, ch
     }
 
     //Give Fake News/Context
-    /*
-     * 1008 = SP (R13) (Moves up/down automatically as stack changes)
-     * 1009-1016 = R4:R11 (1024 - 15 to 1024 - 8)
-     * 1017-1020 = R0:3, R12 (1024 - 7 to 1024-4)
-     * 1021 = LR (R14) (1024-3)
-     * 1022 = PC (R15) (1024 - 2)
-     * 1023 = PSR
-     */
-    int i = 0;
-    for(i = 3; i < 16; i++){    //Give R0-R12 default values of 0b101 (for testing purposes)
-        threadStacks[NumberOfThreads-1][STACKSIZE-i] = 5; //Look at table above
-    }
-
-    threadStacks[NumberOfThreads-1][STACKSIZE-2] = (int32_t)threadToAdd; //PC to threads function pointer. int32_t fixes warning about void void
-    threadStacks[NumberOfThreads-1][STACKSIZE-1] = THUMBBIT;   //PSR to some value with thumb-bit set
+    newThread->Entry = threadToAdd;
+    ResetContext(newThread);
 
     //IDCounter++;    //incrementys everytime a thread is initialized
     newThread->isAlive = true;
     //newThread->threadName = name;
 
+    //Longer names are cut, the copy never runs past threadName
     i = 0;
-    while(*name != '\0'){
-        *((newThread->threadName) + i) = *name;
-        name++;
+    while(i < MAX_NAME_LENGTH - 1 && name[i] != '\0'){
+        newThread->threadName[i] = name[i];
         i++;
     }
-    *((newThread->threadName) + i) = '\0';
+    newThread->threadName[i] = '\0';
 
     newThread->priority = priority;
+    newThread->RTTask = 0;  //Only periodic threads carry a budget
+    newThread->JobCycles = 0;
+    newThread->SwitchInCycles = 0;
+
+    //Privileged with both per-thread regions off unless protected later
+    newThread->Unprivileged = 0;
+    newThread->MPURegions[0] = MPU_RBAR_VALID_Msk | MPU_STACK_REGION;
+    newThread->MPURegions[1] = 0;
+    newThread->MPURegions[2] = MPU_RBAR_VALID_Msk | MPU_DATA_REGION;
+    newThread->MPURegions[3] = 0;
+
+    //Unprivileged threads can't hand out more privilege than they have
+    if(G8RTOS_CallerIsUnprivileged()){
+        ProtectThread(newThread, 0, 0);
+    }
     uint32_t tcbToInitialize = 0;
     bool correct = true;
     for(i = 0; i < NumberOfThreads; i++){
@@ -378,8 +600,6 @@ sched_ErrCode_t G8RTOS_AddThread(void (*threadToAdd)(void), uint8_t priority, ch
 
     newThread->threadID = ((IDCounter++)<<16) | tcbToInitialize;
 
-    EndCriticalSection(PRIMASK);
-
     if(correct){
         return NO_ERROR;
     }
@@ -389,6 +609,153 @@ sched_ErrCode_t G8RTOS_AddThread(void (*threadToAdd)(void), uint8_t priority, ch
 
 }
 
+/*
+ * System call entry of AddThread
+ *  - Threads trap through SVC, handlers run it inside one kernel section
+ *  - Every early return of AddThread leaves through the same G8RTOS_KernelExit
+ */
+sched_ErrCode_t G8RTOS_AddThread(void (*threadToAdd)(void), uint8_t priority, char * name)
+{
+    //Threads trap into the kernel, handlers are already at kernel level
+    if(G8RTOS_InThreadMode()){
+        return G8RTOS_SVC_AddThread(threadToAdd, priority, name);
+    }
+
+    int32_t state = G8RTOS_KernelEnter();
+    sched_ErrCode_t error = AddThread(threadToAdd, priority, name);
+    G8RTOS_KernelExit(state);
+    return error;
+}
+
+
+/*
+ * Adds an unprivileged thread to G8RTOS Scheduler
+ *  - Thread runs with CONTROL.nPRIV set and has to make kernel calls through SVC
+ *  - MPU gives it read/write access to its own stack and to one data region,
+ *    the rest of SRAM (thread control blocks, vector table) is read only
+ *  - Data region size has to be a power of two (32 bytes or more) and base aligned to its size
+ * Param "threadToAdd": Void-Void Function to add as preemptable main thread
+ * Param "data": Base of the thread's data region, 0 for stack only
+ * Param "dataSize": Size of the data region in bytes, 0 for stack only
+ * Returns: Error code for adding threads, MPU_REGION_INVALID if the data region can't be mapped
+ */
+static sched_ErrCode_t AddProtectedThread(void (*threadToAdd)(void), uint8_t priority, char * name, void * data, uint32_t dataSize)
+{
+    //Check the data region before anything is touched
+    uint32_t dataSizeField = 0;
+    if(data != 0){
+        dataSizeField = RegionSizeField(dataSize);
+        if(dataSizeField == 0 || ((uint32_t)data & (dataSize - 1))){
+            return MPU_REGION_INVALID;
+        }
+        //Unprivileged callers may only share their own data region
+        if(G8RTOS_CallerIsUnprivileged() &&
+           (CurrentlyRunningThread->MPURegions[3] != (dataSizeField | MPU_RGN_PERM_NOEXEC | MPU_RGN_PERM_PRV_RW_USR_RW | MPU_ATTR_SRAM | MPU_RGN_ENABLE) ||
+            (CurrentlyRunningThread->MPURegions[2] & MPU_RBAR_ADDR_Msk) != (uint32_t)data)){
+            return PERMISSION_DENIED;
+        }
+    }
+
+    sched_ErrCode_t error = AddThread(threadToAdd, priority, name);
+    if(error != NO_ERROR){
+        return error;
+    }
+
+    if(!MPUEnabled){
+        InitMPU();
+    }
+
+    //The thread that was just added is always the last tcb
+    ProtectThread(&threadControlBlocks[NumberOfThreads-1], data, dataSizeField);
+
+    return NO_ERROR;
+}
+
+/*
+ * System call entry of AddProtectedThread
+ *  - Threads trap through SVC, handlers run it inside one kernel section
+ *  - Every early return of AddProtectedThread leaves through the same G8RTOS_KernelExit
+ */
+sched_ErrCode_t G8RTOS_AddProtectedThread(void (*threadToAdd)(void), uint8_t priority, char * name, void * data, uint32_t dataSize)
+{
+    //Threads trap into the kernel, handlers are already at kernel level
+    if(G8RTOS_InThreadMode()){
+        return G8RTOS_SVC_AddProtectedThread(threadToAdd, priority, name, data, dataSize);
+    }
+
+    int32_t state = G8RTOS_KernelEnter();
+    sched_ErrCode_t error = AddProtectedThread(threadToAdd, priority, name, data, dataSize);
+    G8RTOS_KernelExit(state);
+    return error;
+}
+
+/*
+ * Kernel side only
+ * Returns: true if the caller may have the kernel write [address, address + size) for it
+ *  - Privileged callers always may
+ *  - An unprivileged caller only inside its own stack and data regions, everything
+ *    else in SRAM (kernel tables, other threads, drivers) is refused
+ */
+bool G8RTOS_CallerOwnsAddress(const void * address, uint32_t size)
+{
+    if(!G8RTOS_CallerIsUnprivileged()){
+        return true;
+    }
+
+    uint32_t addr = (uint32_t)address;
+    const uint32_t *regions = CurrentlyRunningThread->MPURegions;
+    return InThreadRegion(regions[0], regions[1], addr, size) ||
+           InThreadRegion(regions[2], regions[3], addr, size);
+}
+
+/*
+ * Adds a periodic thread (a thread that sleeps once per period) to G8RTOS Scheduler
+ *  - Runs the admission test with the declared budget before adding the thread
+ *  - One job ends every time the thread calls sleep()
+ * Param "threadToAdd": Void-Void Function to add as preemptable main thread
+ * Param "period": Declared period in ms
+ * Param "wcet": Declared worst case execution time of one job in us
+ * Returns: Error code for adding threads, SCHEDULE_INFEASIBLE if rejected
+ */
+static sched_ErrCode_t AddPeriodicThread(void (*threadToAdd)(void), uint8_t priority, char * name, uint32_t period, uint32_t wcet)
+{
+    //Admission and insertion happen in the same kernel section
+    rtTask_t *task;
+    sched_ErrCode_t error = G8RTOS_AdmitTask(period, wcet, RT_LEVEL_THREAD(priority), &task);
+    if(error != NO_ERROR){
+        return error;
+    }
+
+    error = AddThread(threadToAdd, priority, name);
+    if(error != NO_ERROR){
+        G8RTOS_ReleaseTask(task);   //Thread never made it in, give the budget back
+        return error;
+    }
+
+    //The thread that was just added is always the last tcb
+    threadControlBlocks[NumberOfThreads-1].RTTask = task;
+
+    return NO_ERROR;
+}
+
+/*
+ * System call entry of AddPeriodicThread
+ *  - Threads trap through SVC, handlers run it inside one kernel section
+ *  - Every early return of AddPeriodicThread leaves through the same G8RTOS_KernelExit
+ */
+sched_ErrCode_t G8RTOS_AddPeriodicThread(void (*threadToAdd)(void), uint8_t priority, char * name, uint32_t period, uint32_t wcet)
+{
+    //Threads trap into the kernel, handlers are already at kernel level
+    if(G8RTOS_InThreadMode()){
+        return G8RTOS_SVC_AddPeriodicThread(threadToAdd, priority, name, period, wcet);
+    }
+
+    int32_t state = G8RTOS_KernelEnter();
+    sched_ErrCode_t error = AddPeriodicThread(threadToAdd, priority, name, period, wcet);
+    G8RTOS_KernelExit(state);
+    return error;
+}
+
 
 /*
  * Adds periodic threads to G8RTOS Scheduler
@@ -396,64 +763,115 @@ sched_ErrCode_t G8RTOS_AddThread(void (*threadToAdd)(void), uint8_t priority, ch
  * The struct will be added to a linked list of periodic events
  * Param Pthread To Add: void-void function for P thread handler
  * Param period: period of P thread to add
- * Returns: Error code for adding threads
+ * Param wcet: declared worst case execution time of the handler in us
+ * Returns: Error code for adding threads, SCHEDULE_INFEASIBLE if rejected
  */
-sched_ErrCode_t G8RTOS_AddPeriodicEvent(void (*PthreadToAdd)(void), uint32_t period)
+static sched_ErrCode_t AddPeriodicEvent(void (*PthreadToAdd)(void), uint32_t period, uint32_t wcet)
 {
-    int32_t PRIMASK;
-    PRIMASK = StartCriticalSection();   //Make critical section is it can run at the start of the OS
+    //Handler would run privileged inside SysTick
+    if(G8RTOS_CallerIsUnprivileged()){
+        return PERMISSION_DENIED;
+    }
+
     /* Implement this */
     /* Implement this */
     if(NumberOfPthreads == MAXPTHREADS){
         return THREAD_LIMIT_REACHED;  //Error Code, reached max number of threads, can't add new one
     }
-    else{
-        NumberOfPthreads++;  //Adding a thread...
+
+    //Reject the event if the task set would no longer be schedulable
+    rtTask_t *task;
+    sched_ErrCode_t error = G8RTOS_AdmitTask(period, wcet, RT_LEVEL_PERIODIC_EVENT, &task);
+    if(error != NO_ERROR){
+        return error;
     }
 
-    ptcb_t *newThread = &(Pthread[NumberOfPthreads-1]);
+    //SysTick walks the list without a kernel section, link the event in completely before counting it
+    ptcb_t *newThread = &(Pthread[NumberOfPthreads]);
+
+    newThread->Period = period;
+    newThread->Handler = PthreadToAdd;
+    newThread->RTTask = task;
 
-    if(NumberOfPthreads == 1){
+    if(NumberOfPthreads == 0){
             newThread->Next_P_Event = newThread;
             newThread->Previous_P_Event = newThread;
         }
         else{
-            (Pthread[0]).Previous_P_Event = &(Pthread[NumberOfPthreads-1]);    //Point to newest
-            (Pthread[NumberOfPthreads-2]).Next_P_Event = &(Pthread[NumberOfPthreads-1]); //point to newest
-            newThread->Previous_P_Event = &(Pthread[NumberOfPthreads-2]);
+            newThread->Previous_P_Event = &(Pthread[NumberOfPthreads-1]);
             newThread->Next_P_Event = &(Pthread[0]);
+            (Pthread[0]).Previous_P_Event = newThread;    //Point to newest
+            (Pthread[NumberOfPthreads-1]).Next_P_Event = newThread; //point to newest
         }
 
-    newThread->Period = period;
-    newThread->Handler = PthreadToAdd;
-
-    EndCriticalSection(PRIMASK);
+    NumberOfPthreads++;  //Adding a thread...
 
     return NO_ERROR;
 }
 
+/*
+ * System call entry of AddPeriodicEvent
+ *  - Threads trap through SVC, handlers run it inside one kernel section
+ *  - Every early return of AddPeriodicEvent leaves through the same G8RTOS_KernelExit
+ */
+sched_ErrCode_t G8RTOS_AddPeriodicEvent(void (*PthreadToAdd)(void), uint32_t period, uint32_t wcet)
+{
+    //Threads trap into the kernel, handlers are already at kernel level
+    if(G8RTOS_InThreadMode()){
+        return G8RTOS_SVC_AddPeriodicEvent(PthreadToAdd, period, wcet);
+    }
+
+    int32_t state = G8RTOS_KernelEnter();
+    sched_ErrCode_t error = AddPeriodicEvent(PthreadToAdd, period, wcet);
+    G8RTOS_KernelExit(state);
+    return error;
+}
+
 
 /*
  * Puts the current thread into a sleep state.
  *  param durationMS: Duration of sleep time in ms
  */
-void sleep(uint32_t durationMS)
+static void Sleep(uint32_t durationMS)
 {
     /* Implement this */
+    //Sleeping ends the current job of a periodic thread
+    if(CurrentlyRunningThread->RTTask){
+        uint32_t now = DWT->CYCCNT;
+        CurrentlyRunningThread->JobCycles += now - CurrentlyRunningThread->SwitchInCycles;
+        G8RTOS_RecordExecution(CurrentlyRunningThread->RTTask, CurrentlyRunningThread->JobCycles);
+        CurrentlyRunningThread->JobCycles = 0;
+        CurrentlyRunningThread->SwitchInCycles = now;
+    }
+
     CurrentlyRunningThread->Sleep_Count = durationMS + SystemTime;
     CurrentlyRunningThread->Asleep = true;
     SCB -> ICSR |= SCB_ICSR_PENDSVSET_Msk;      //Pend the PENSV interrupt to the interrupt controller,
                                                 //causing it to execute on the next available time
 }
 
+/*
+ * System call entry of Sleep
+ *  - Threads trap through SVC, handlers run it inside one kernel section
+ */
+void sleep(uint32_t durationMS)
+{
+    //Threads trap into the kernel, handlers are already at kernel level
+    if(G8RTOS_InThreadMode()){
+        G8RTOS_SVC_Sleep(durationMS);
+        return;
+    }
+
+    int32_t state = G8RTOS_KernelEnter();
+    Sleep(durationMS);
+    G8RTOS_KernelExit(state);
+}
+
 threadId_t G8RTOS_GetThreadId(){
     return CurrentlyRunningThread->threadID;
 }
 
-sched_ErrCode_t G8RTOS_KillThread(threadId_t threadId){
-    int32_t PRIMASK;
-    PRIMASK = StartCriticalSection();
-
+static sched_ErrCode_t KillThread(threadId_t threadId){
     //Return error if only one thread running
     if(NumberOfThreads == 1){
         return CANNOT_KILL_LAST_THREAD;
@@ -480,6 +898,9 @@ sched_ErrCode_t G8RTOS_KillThread(threadId_t threadId){
 
     //rip
     searcher->isAlive = false;
+    G8RTOS_WatchdogUnregister(searcher->threadID);   //Dead threads don't check in
+    G8RTOS_ReleaseTask(searcher->RTTask);   //Budget no longer part of the task set
+    searcher->RTTask = 0;
 
     //Close the gap (update thread pointers)
     tcb_t *previousThread = searcher->preTCB;
@@ -490,8 +911,6 @@ sched_ErrCode_t G8RTOS_KillThread(threadId_t threadId){
     //Decrement number of threads
     NumberOfThreads--;
 
-    EndCriticalSection(PRIMASK);
-
     //If we killed the currentlyRunningThread then we need to do context switching
     if(searcher == CurrentlyRunningThread){
         SCB -> ICSR |= SCB_ICSR_PENDSVSET_Msk;      //Pend the PENSV interrupt to the interrupt controller,
@@ -501,10 +920,25 @@ sched_ErrCode_t G8RTOS_KillThread(threadId_t threadId){
     return NO_ERROR;
 }
 
-sched_ErrCode_t G8RTOS_KillSelf(){
-    int32_t PRIMASK;
-    PRIMASK = StartCriticalSection();
+/*
+ * System call entry of KillThread
+ *  - Threads trap through SVC, handlers run it inside one kernel section
+ *  - Every early return of KillThread leaves through the same G8RTOS_KernelExit
+ */
+sched_ErrCode_t G8RTOS_KillThread(threadId_t threadId)
+{
+    //Threads trap into the kernel, handlers are already at kernel level
+    if(G8RTOS_InThreadMode()){
+        return G8RTOS_SVC_KillThread(threadId);
+    }
+
+    int32_t state = G8RTOS_KernelEnter();
+    sched_ErrCode_t error = KillThread(threadId);
+    G8RTOS_KernelExit(state);
+    return error;
+}
 
+static sched_ErrCode_t KillSelf(){
     //If only one thread running then it can't kill itself for personal reasons
     if(NumberOfThreads == 1){
         return CANNOT_KILL_LAST_THREAD;
@@ -512,6 +946,9 @@ sched_ErrCode_t G8RTOS_KillSelf(){
 
     //Cri errytim
     CurrentlyRunningThread->isAlive = false;
+    G8RTOS_WatchdogUnregister(CurrentlyRunningThread->threadID);   //Dead threads don't check in
+    G8RTOS_ReleaseTask(CurrentlyRunningThread->RTTask);   //Budget no longer part of the task set
+    CurrentlyRunningThread->RTTask = 0;
 
     //Close the gap (update thread pointers)
     tcb_t *previousThread = CurrentlyRunningThread->preTCB;
@@ -526,8 +963,6 @@ sched_ErrCode_t G8RTOS_KillSelf(){
     //Decrement num of threads
     NumberOfThreads--;
 
-    EndCriticalSection(PRIMASK);
-
 //    //Context switch
     SCB -> ICSR |= SCB_ICSR_PENDSVSET_Msk;      //Pend the PENSV interrupt to the interrupt controller,
 //                                                //causing it to execute on the next available time
@@ -535,10 +970,95 @@ sched_ErrCode_t G8RTOS_KillSelf(){
     return NO_ERROR;
 }
 
-sched_ErrCode_t G8RTOS_AddAPeriodicEvent(void (*AthreadToAdd)(void), uint8_t priority, IRQn_Type IRQn){
-    int32_t PRIMASK;
-    PRIMASK = StartCriticalSection();   //Make critical section so they can be called once the OS is running
+/*
+ * System call entry of KillSelf
+ *  - Threads trap through SVC, handlers run it inside one kernel section
+ *  - Every early return of KillSelf leaves through the same G8RTOS_KernelExit
+ */
+sched_ErrCode_t G8RTOS_KillSelf()
+{
+    //Threads trap into the kernel, handlers are already at kernel level
+    if(G8RTOS_InThreadMode()){
+        return G8RTOS_SVC_KillSelf();
+    }
 
+    int32_t state = G8RTOS_KernelEnter();
+    sched_ErrCode_t error = KillSelf();
+    G8RTOS_KernelExit(state);
+    return error;
+}
+
+/*
+ * Kernel side only (watchdog recovery)
+ * Starts a thread over from its entry point, keeping its ID, priority and MPU regions
+ *  - A thread blocked on a semaphore gives its place in the queue back first
+ *  - The running thread is reset by the next PendSV, after its context is saved
+ *  - Anything the thread held (a FIFO mutex, a half drawn screen) stays the way it was
+ * Param "threadId": Thread to restart
+ * Returns: NO_ERROR or THREAD_DOES_NOT_EXIST
+ */
+sched_ErrCode_t G8RTOS_RestartThread(threadId_t threadId){
+    int32_t state = G8RTOS_KernelEnter();
+
+    tcb_t *tcb = 0;
+    int i = 0;
+    for(i = 0; i < MAX_THREADS; i++){
+        if(threadControlBlocks[i].isAlive && threadControlBlocks[i].threadID == threadId){
+            tcb = &threadControlBlocks[i];
+            break;
+        }
+    }
+
+    if(tcb == 0){
+        G8RTOS_KernelExit(state);
+        return THREAD_DOES_NOT_EXIST;
+    }
+
+    if(tcb->blocked != 0){
+        (*(tcb->blocked))++;    //Undo the wait, the restarted thread is no longer in line
+        tcb->blocked = 0;
+    }
+    tcb->Asleep = false;
+    tcb->Sleep_Count = 0;
+    tcb->JobCycles = 0;
+
+    if(tcb == CurrentlyRunningThread){
+        tcb->RestartPending = true;
+        SCB -> ICSR |= SCB_ICSR_PENDSVSET_Msk;
+    }
+    else{
+        ResetContext(tcb);
+    }
+
+    G8RTOS_KernelExit(state);
+    return NO_ERROR;
+}
+
+/*
+ * Benchmarks one context switch round trip with the DWT cycle counter
+ *  - Pends PendSV from the calling thread and measures until it runs again
+ *  - Calling thread should be the highest priority ready thread so the
+ *    scheduler picks it again and the result is pure switch cost
+ * Returns: Cycles spent in the switch (exception entry, save, scheduler, restore, exit)
+ */
+uint32_t G8RTOS_MeasureContextSwitch(){
+    uint32_t start = DWT->CYCCNT;
+    SCB -> ICSR |= SCB_ICSR_PENDSVSET_Msk;      //PendSV is taken right away from thread mode
+    __DSB();
+    __ISB();
+    return DWT->CYCCNT - start;
+}
+
+/*
+ * Adds an aperiodic event (ISR) to G8RTOS
+ *  - Only handlers at SYSCALL_PRIORITY or lower may call kernel functions,
+ *    kernel sections never hold off anything above it
+ */
+static sched_ErrCode_t AddAPeriodicEvent(void (*AthreadToAdd)(void), uint8_t priority, IRQn_Type IRQn){
+    //Handler would run privileged as an ISR
+    if(G8RTOS_CallerIsUnprivileged()){
+        return PERMISSION_DENIED;
+    }
 
     //Errors if IRQn  is less than the last exception and greater than last acceptable user IRQn
     if(!(IRQn > PSS_IRQn)){
@@ -553,6 +1073,11 @@ sched_ErrCode_t G8RTOS_AddAPeriodicEvent(void (*AthreadToAdd)(void), uint8_t pri
         return HWI_PRIORITY_INVALID;
     }
 
+    //Above SYSCALL_PRIORITY the handler would not be masked by kernel sections
+    if(priority < SYSCALL_PRIORITY){
+        return HWI_PRIORITY_INVALID;
+    }
+
     //Sets an interrupt vector in SRAM based interrupt vector table.
     //The interrupt number can be positive to specify a device specific interrupt,
     //or negative to specify a processor exception.
@@ -565,9 +1090,25 @@ sched_ErrCode_t G8RTOS_AddAPeriodicEvent(void (*AthreadToAdd)(void), uint8_t pri
     __NVIC_SetPriority(IRQn, priority);
     __NVIC_EnableIRQ(IRQn); //Enables a device specific interrupt in the NVIC interrupt controller.
 
-
-    EndCriticalSection(PRIMASK);
     return NO_ERROR;
 }
 
+/*
+ * System call entry of AddAPeriodicEvent
+ *  - Threads trap through SVC, handlers run it inside one kernel section
+ *  - Every early return of AddAPeriodicEvent leaves through the same G8RTOS_KernelExit
+ */
+sched_ErrCode_t G8RTOS_AddAPeriodicEvent(void (*AthreadToAdd)(void), uint8_t priority, IRQn_Type IRQn)
+{
+    //Threads trap into the kernel, handlers are already at kernel level
+    if(G8RTOS_InThreadMode()){
+        return G8RTOS_SVC_AddAPeriodicEvent(AthreadToAdd, priority, IRQn);
+    }
+
+    int32_t state = G8RTOS_KernelEnter();
+    sched_ErrCode_t error = AddAPeriodicEvent(AthreadToAdd, priority, IRQn);
+    G8RTOS_KernelExit(state);
+    return error;
+}
+
 /*********************************************** Public Functions *********************************************************************/
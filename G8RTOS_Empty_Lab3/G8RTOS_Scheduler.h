@@ -5,6 +5,9 @@
 #ifndef G8RTOS_SCHEDULER_H_
 #define G8RTOS_SCHEDULER_H_
 
+#include <stdint.h>
+#include <stdbool.h>
+
 /*
  * Error codes for scheduler
  */
@@ -17,14 +20,18 @@ typedef enum{
     THREAD_DOES_NOT_EXIST       =   -4,
     CANNOT_KILL_LAST_THREAD     =   -5,
     IRQn_INVALID                =   -6,
-    HWI_PRIORITY_INVALID        =   -7
+    HWI_PRIORITY_INVALID        =   -7,
+    SCHEDULE_INFEASIBLE         =   -8,
+    MPU_REGION_INVALID          =   -9,
+    PERMISSION_DENIED           =   -10
 } sched_ErrCode_t;
 
 /*********************************************** Sizes and Limits *********************************************************************/
 #define MAX_THREADS 32
 #define MAXPTHREADS 6
 #define STACKSIZE 256
-#define OSINT_PRIORITY 7
+#define OSINT_PRIORITY 7     //SVC, PendSV and SysTick (kernel priority)
+#define SYSCALL_PRIORITY 5   //Highest interrupt priority allowed to call the kernel
 /*********************************************** Sizes and Limits *********************************************************************/
 
 /*********************************************** Public Variables *********************************************************************/
@@ -50,6 +57,12 @@ void G8RTOS_Init();
  */
 int32_t G8RTOS_Launch();
 
+/*
+ * Returns: true once G8RTOS_Launch started the first thread
+ * Drivers use it to decide between blocking on a semaphore and spinning
+ */
+bool G8RTOS_IsRunning();
+
 /*
  * Adds threads to G8RTOS Scheduler
  * 	- Checks if there are stil available threads to insert to scheduler
@@ -62,15 +75,50 @@ int32_t G8RTOS_Launch();
 sched_ErrCode_t G8RTOS_AddThread(void (*threadToAdd)(void), uint8_t priority, char * name);
 
 
+/*
+ * Adds an unprivileged thread to G8RTOS Scheduler
+ *  - Thread runs with CONTROL.nPRIV set and has to make kernel calls through SVC
+ *  - MPU gives it read/write access to its own stack and to one data region,
+ *    the rest of SRAM (thread control blocks, vector table) is read only
+ *  - Data region size has to be a power of two (32 bytes or more) and base aligned to its size
+ * Param "threadToAdd": Void-Void Function to add as preemptable main thread
+ * Param "data": Base of the thread's data region, 0 for stack only
+ * Param "dataSize": Size of the data region in bytes, 0 for stack only
+ * Returns: Error code for adding threads, MPU_REGION_INVALID if the data region can't be mapped
+ */
+sched_ErrCode_t G8RTOS_AddProtectedThread(void (*threadToAdd)(void), uint8_t priority, char * name, void * data, uint32_t dataSize);
+
+/*
+ * Kernel side only
+ * Returns: true if the caller may have the kernel write [address, address + size) for it
+ *  - Privileged callers always may
+ *  - An unprivileged caller only inside its own stack and data regions, everything
+ *    else in SRAM (kernel tables, other threads, drivers) is refused
+ */
+bool G8RTOS_CallerOwnsAddress(const void * address, uint32_t size);
+
+/*
+ * Adds a periodic thread (a thread that sleeps once per period) to G8RTOS Scheduler
+ *  - Runs the admission test with the declared budget before adding the thread
+ *  - One job ends every time the thread calls sleep()
+ * Param "threadToAdd": Void-Void Function to add as preemptable main thread
+ * Param "period": Declared period in ms
+ * Param "wcet": Declared worst case execution time of one job in us
+ * Returns: Error code for adding threads, SCHEDULE_INFEASIBLE if rejected
+ */
+sched_ErrCode_t G8RTOS_AddPeriodicThread(void (*threadToAdd)(void), uint8_t priority, char * name, uint32_t period, uint32_t wcet);
+
+
 /*
  * Adds periodic threads to G8RTOS Scheduler
  * Function will initialize a periodic event struct to represent event.
  * The struct will be added to a linked list of periodic events
  * Param Pthread To Add: void-void function for P thread handler
  * Param period: period of P thread to add
- * Returns: Error code for adding threads
+ * Param wcet: declared worst case execution time of the handler in us
+ * Returns: Error code for adding threads, SCHEDULE_INFEASIBLE if rejected
  */
-sched_ErrCode_t G8RTOS_AddPeriodicEvent(void (*PthreadToAdd)(void), uint32_t period);
+sched_ErrCode_t G8RTOS_AddPeriodicEvent(void (*PthreadToAdd)(void), uint32_t period, uint32_t wcet);
 
 
 /*
@@ -84,6 +132,23 @@ threadId_t G8RTOS_GetThreadId();
 sched_ErrCode_t G8RTOS_KillThread(threadId_t threadId);
 sched_ErrCode_t G8RTOS_KillSelf();
 
+/*
+ * Kernel side only (watchdog recovery)
+ * Starts a thread over from its entry point, keeping its ID, priority and MPU regions
+ * Param "threadId": Thread to restart
+ * Returns: NO_ERROR or THREAD_DOES_NOT_EXIST
+ */
+sched_ErrCode_t G8RTOS_RestartThread(threadId_t threadId);
+
+/*
+ * Benchmarks one context switch round trip with the DWT cycle counter
+ *  - Pends PendSV from the calling thread and measures until it runs again
+ *  - Calling thread should be the highest priority ready thread so the
+ *    scheduler picks it again and the result is pure switch cost
+ * Returns: Cycles spent in the switch (exception entry, save, scheduler, restore, exit)
+ */
+uint32_t G8RTOS_MeasureContextSwitch();
+
 /*********************************************** Public Functions *********************************************************************/
 
 #endif /* G8RTOS_SCHEDULER_H_ */
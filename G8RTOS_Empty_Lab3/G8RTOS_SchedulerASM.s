@@ -16,62 +16,77 @@
 ; (label needs to be close enough to asm code to be reached with PC relative addressing)
 RunningPtr: .field CurrentlyRunningThread, 32
 
+; MPU Region Base Address register followed by RASR and the A1 aliases,
+; one STMIA of four words reprograms both per-thread regions
+MPURegionPtr: .field 0xE000ED9C, 32
+
 ; G8RTOS_Start
 ;	Sets the first thread to be the currently running thread
+;	Programs the thread's MPU regions
+;	Moves thread mode onto the process stack (PSP), handlers keep the main stack (MSP)
 ;	Starts the currently running thread by setting Link Register to tcb's Program Counter
+;	Privilege is dropped last, CPSIE is ignored once a thread is unprivileged
 G8RTOS_Start:
 
 	.asmfunc
-	; Implement this
+	CPSID I	;No switches until the first thread is running
 	LDR R1, RunningPtr	;Gets currentRunningthread's address
-	LDR R0, [R1]	;Gets the thread pointed to by currentlyrunningthread
-	;LDR SP, [R0, #8]	;Makes stack pointer point to the firt thread
-	LDR SP, [R0]	;Dont need that offset anymore :)	
-	;Restoring Context
-	POP {R4-R11}	;LAst thing pushed to the stack (by pendSV)
-	POP {R0-R3}
-	POP {R12}
-	ADD SP, SP, #4	;Skipping SP
-	POP	{LR}
-	ADD SP, SP, #4	;SKipping PSR
-	;PUSH {LR}
-	;BL SysTick_enableInterrupt ;Didnt really need this, also became a hassle here
-	;POP {LR}
+	LDR R1, [R1]	;Gets the thread pointed to by currentlyrunningthread
+	ADD R2, R1, #8	;MPU region values follow the privilege flag
+	LDMIA R2, {R2, R3, R6, R7}
+	LDR R0, MPURegionPtr
+	STMIA R0, {R2, R3, R6, R7}	;RBAR, RASR, RBAR_A1, RASR_A1
+	DSB
+	LDR R0, [R1]	;Thread stack pointer is at the top of the tcb
+	LDMIA R0!, {R4-R11}	;Fake R4-R11 pushed when the thread was added
+	LDR LR, [R0, #24]	;Thread's PC out of the fake hardware frame
+	ADD R0, R0, #32	;Fake R0-R3, R12, LR and PSR are never used
+	MSR PSP, R0
+	MOV R0, #2	;CONTROL.SPSEL = 1, thread mode runs on PSP
+	MSR CONTROL, R0
+	ISB
 	CPSIE I	;Enabling interrupts
+	LDR R0, [R1, #4]	;Thread's privilege flag
+	ORR R0, R0, #2	;Keep SPSEL
+	MSR CONTROL, R0
+	ISB
 	BX LR	;Return
 	.endasmfunc
 
 ; PendSV_Handler
 ; - Performs a context switch in G8RTOS
-; 	- Saves remaining registers into thread stack
-;	- Saves current stack pointer to tcb
+;	- Hardware already stacked R0-R3, R12, LR, PC, PSR on the thread's PSP
+; 	- Saves R4-R11 below that frame with a single STMDB
+;	- Saves PSP to tcb
 ;	- Calls G8RTOS_Scheduler to get new tcb
-;	- Set stack pointer to new stack pointer from new tcb
-;	- Pops registers from thread stack 
+;	- Sets the new thread's privilege level and MPU regions
+;	- Restores R4-R11 of the new tcb with a single LDMIA and hands PSP back
+; PendSV runs at the lowest priority, so it only ever tail-chains behind other
+; handlers and never needs the CPSID/CPSIE pair. R4 and R5 are callee saved so
+; EXC_RETURN and RunningPtr survive the call without touching the main stack.
 PendSV_Handler:
-	;Remove interrupt disables
 	.asmfunc
-	;Implement this  
-	;BL SysTick_disableInterrupt	;Prevents error of jumping from one handler to another
-	CPSID I	;Disable the interrupts for now to prevent jumping out
-	PUSH {R4-R11}	;PendSV should push remaining registers, others are pushed when calling this funcion
-	;PUSH {LR}
-	;Didnt need this junk either
-	;BL SysTick_disableInterrupt	;Prevents error of jumping from one handler to another
-	;POP	{LR}	
-	LDR R4, RunningPtr	;For register operations
-	LDR R5, [R4]	;Dereference to get the real address of currentlyRunningThread
-	;ADD R4, R4, 2	;Relative addressing to stack_pointer in tcb
-	;STR SP, [R5,#8]	;Store stack pointer to tcb's stack_pointer (SP = R13)
-	STR SP, [R5]	;Moved the stack pointer to the top of the struct so no need offset
-	PUSH {R4, LR}	;Save LR or else we might nor return from this handler
-	BL G8RTOS_Scheduler	;Call Function. New currently running thread (pointer still works)
-	POP {R4, LR}	;Pop back the saved values 
-	LDR R5, [R4]	;Dereference to get the real address of currentlyrunningthread
-	;LDR SP, [R5, #8]	;Offset to get the struct's stack pointer addr and deref to get the address the SP points to
-	LDR SP, [R5]	;NO increment needed anymore :)
-	POP {R4-R11}	;POP the new TCB's Registers that were pushed during the context save
-	CPSIE I	;Renable the interrupts for more fun
+	MRS R0, PSP	;Thread's stack pointer, hardware frame already on it
+	STMDB R0!, {R4-R11}	;Remaining registers under the hardware frame
+	LDR R5, RunningPtr	;For register operations
+	LDR R1, [R5]	;Dereference to get the real address of currentlyRunningThread
+	STR R0, [R1]	;Stack pointer is at the top of the struct so no offset
+	MOV R4, LR	;EXC_RETURN, G8RTOS_Scheduler preserves R4
+	BL G8RTOS_Scheduler	;New currently running thread
+	MOV LR, R4	;EXC_RETURN back before R4 is overwritten
+	LDR R1, [R5]	;Dereference to get the real address of currentlyrunningthread
+	LDR R2, [R1, #4]	;New thread's privilege flag
+	MRS R3, CONTROL
+	BFI R3, R2, #0, #1	;CONTROL.nPRIV applies once we are back in thread mode
+	MSR CONTROL, R3
+	ADD R2, R1, #8	;New thread's stack and data regions
+	LDMIA R2, {R2, R3, R6, R7}
+	LDR R0, MPURegionPtr
+	STMIA R0, {R2, R3, R6, R7}	;RBAR, RASR, RBAR_A1, RASR_A1
+	DSB
+	LDR R0, [R1]	;New thread's saved stack pointer
+	LDMIA R0!, {R4-R11}	;POP the new TCB's Registers that were pushed during the context save
+	MSR PSP, R0	;Hardware pops the rest of the frame on exception return
 	BX LR	;Return
 	.endasmfunc
 	
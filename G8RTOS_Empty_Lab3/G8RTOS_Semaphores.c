@@ -7,8 +7,8 @@
 #include <stdint.h>
 #include "msp.h"
 #include "G8RTOS_Semaphores.h"
-#include "G8RTOS_CriticalSection.h"
 #include "G8RTOS_Structures.h"
+#include "G8RTOS_SVC.h"
 
 /*********************************************** Dependencies and Externs *************************************************************/
 
@@ -25,15 +25,20 @@ void StartContextSwitch(){
  * Initializes a semaphore to a given value
  * Param "s": Pointer to semaphore
  * Param "value": Value to initialize semaphore to
- * THIS IS A CRITICAL SECTION
+ * Runs at kernel priority (system call)
  */
 void G8RTOS_InitSemaphore(semaphore_t *s, int32_t value)
 {
     /* Implement this */
-    int32_t test;
-    test = StartCriticalSection();  //Can be called once OS is running
+    //Threads trap into the kernel, handlers are already at kernel level
+    if(G8RTOS_InThreadMode()){
+        G8RTOS_SVC_InitSemaphore(s, value);
+        return;
+    }
+
+    int32_t state = G8RTOS_KernelEnter();  //Can be called once OS is running
     *s = value;
-    EndCriticalSection(test);
+    G8RTOS_KernelExit(state);
 }
 
 /*
@@ -41,15 +46,20 @@ void G8RTOS_InitSemaphore(semaphore_t *s, int32_t value)
  *  - Decrements semaphore
  *  - Blocks thread is sempahore is unavalible
  * Param "s": Pointer to semaphore to wait on
- * THIS IS A CRITICAL SECTION
+ * Runs at kernel priority (system call)
  */
 void G8RTOS_WaitSemaphore(semaphore_t *s)
 {
     /* Implement this */
-    (*s)--;
+    //Threads trap into the kernel, PendSV tail-chains if they block
+    if(G8RTOS_InThreadMode()){
+        G8RTOS_SVC_WaitSemaphore(s);
+        return;
+    }
+
+    int32_t state = G8RTOS_KernelEnter();
 
-    int32_t test;
-    test = StartCriticalSection();
+    (*s)--;
 
     /*
      * if s < 0, then the semaphore was already being used,
@@ -67,7 +77,7 @@ void G8RTOS_WaitSemaphore(semaphore_t *s)
 //        test = StartCriticalSection(); //Disable interrupts
 //    }
     //(*s)--;
-    EndCriticalSection(test); //Enable INterrupts
+    G8RTOS_KernelExit(state);
 }
 
 /*
@@ -75,28 +85,37 @@ void G8RTOS_WaitSemaphore(semaphore_t *s)
  *  - Increments the semaphore value by 1
  *  - Unblocks any threads waiting on that semaphore
  * Param "s": Pointer to semaphore to be signaled
- * THIS IS A CRITICAL SECTION
+ * Runs at kernel priority (system call)
  */
 void G8RTOS_SignalSemaphore(semaphore_t *s)
 {
     /* Implement this */
-    int32_t test = StartCriticalSection(); //Enter critical section, disables interrupts
+    //Threads trap into the kernel, handlers are already at kernel level
+    if(G8RTOS_InThreadMode()){
+        G8RTOS_SVC_SignalSemaphore(s);
+        return;
+    }
+
+    int32_t state = G8RTOS_KernelEnter();
     (*s)++;  //Increment the semaphore
 
     /*
-     * If semaphore is < 0 then a thread(s) is still blocked,
+     * If semaphore is <= 0 then a thread(s) is still blocked,
      * we must find the next thread that is blocked to that semaphore
      * and unblock it (set blocked to 0)
      */
-    if((*s) < 0){
-        tcb_t *pt = (tcb_t *) &CurrentlyRunningThread->nextTCB;
-        while(pt -> blocked != s){
+    if((*s) <= 0){
+        tcb_t *pt = CurrentlyRunningThread->nextTCB;
+        int i;
+        for(i = 0; (i < MAX_THREADS) && (pt -> blocked != s); i++){   //Bounded, a killed waiter never shows up
             pt = pt -> nextTCB;
         }
 
-        pt -> blocked = 0;
+        if(pt -> blocked == s){
+            pt -> blocked = 0;
+        }
     }
-    EndCriticalSection(test);   //Enable interrupts, exit critical section
+    G8RTOS_KernelExit(state);
 }
 
 /*********************************************** Public Functions *********************************************************************/
@@ -27,6 +27,9 @@
 typedef struct tcb_t{
     //Moved stack pointer to the top so we dont need an increment at the assembly level
     int32_t* Stack_Pointer;
+    //PendSV loads these right after the stack pointer, keep them at offsets 4 and 8
+    uint32_t Unprivileged;      //CONTROL.nPRIV for this thread
+    uint32_t MPURegions[4];     //RBAR/RASR pairs for the thread's stack and data regions
     struct tcb_t* preTCB;
     struct tcb_t* nextTCB;
     //int32_t* Stack_Pointer;
@@ -50,6 +53,15 @@ typedef struct tcb_t{
     //Thread name for super convenience in variable explorer
     char threadName[MAX_NAME_LENGTH];
 
+    //Declared budget for periodic threads, 0 for everything else
+    rtTask_t *RTTask;
+    uint32_t JobCycles;         //Cycles spent in the current job
+    uint32_t SwitchInCycles;    //DWT stamp of the last switch in
+
+    //Entry point so the watchdog can start the thread over
+    void (*Entry)(void);
+    bool RestartPending;        //Restart once PendSV has saved its context
+
 } tcb_t;
 
 
@@ -69,6 +81,7 @@ typedef struct ptcb_t{
     uint32_t Current_Time;
     struct ptcb_t *Previous_P_Event;
     struct ptcb_t *Next_P_Event;
+    rtTask_t *RTTask;   //Declared budget of the handler
 
 } ptcb_t;
 
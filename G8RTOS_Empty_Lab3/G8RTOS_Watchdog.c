@@ -0,0 +1,239 @@
+/*
+ * G8RTOS_Watchdog.c
+ */
+
+/*********************************************** Dependencies and Externs *************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "msp.h"
+#include <driverlib.h>
+#include "G8RTOS_Watchdog.h"
+#include "G8RTOS_Structures.h"
+#include "G8RTOS_SVC.h"
+
+/*********************************************** Dependencies and Externs *************************************************************/
+
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+/*
+ *  Watched Thread:
+ *      - Check-in period and the time the next check-in is due
+ *      - Recovery callback and how often the thread has missed
+ */
+typedef struct watchdog_t{
+    threadId_t threadID;
+    uint32_t Period;                //Longest time allowed between check-ins in ms
+    uint32_t Deadline;              //SystemTime the next check-in is due
+    watchdog_Recovery_t Recovery;   //0 restarts the thread
+    uint32_t Misses;
+    bool Overdue;                   //Recovery already ran for this miss
+    bool inUse;
+} watchdog_t;
+
+/* Only touched at kernel priority (system calls and SysTick) */
+static watchdog_t WatchedThreads[MAX_WATCHED_THREADS];
+
+/*********************************************** Data Structures Used *****************************************************************/
+
+
+/*********************************************** Private Variables ********************************************************************/
+
+/* WDT_A is only serviced once it was started */
+static bool HardwareWatchdog = false;
+
+/* Missed check-ins since boot */
+static uint32_t TotalMisses;
+
+/*********************************************** Private Variables ********************************************************************/
+
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*
+ * Returns: Watchdog entry of a thread, 0 if it isn't watched
+ */
+static watchdog_t * FindWatchedThread(threadId_t threadId)
+{
+    int i;
+    for(i = 0; i < MAX_WATCHED_THREADS; i++){
+        if(WatchedThreads[i].inUse && WatchedThreads[i].threadID == threadId){
+            return &WatchedThreads[i];
+        }
+    }
+    return 0;
+}
+
+/*
+ * Runs the recovery of a thread that just missed its check-in
+ * Returns: true if the thread is back on time (restarted)
+ */
+static bool Recover(watchdog_t *watched)
+{
+    watched->Misses++;
+    TotalMisses++;
+
+    watchdog_Action_t action = WATCHDOG_RESTART;
+    if(watched->Recovery){
+        action = watched->Recovery(watched->threadID, watched->Misses);
+    }
+
+    switch(action){
+    case WATCHDOG_RESTART:
+        if(G8RTOS_RestartThread(watched->threadID) != NO_ERROR){
+            watched->inUse = false;     //Thread is gone, nothing left to watch
+        }
+        watched->Deadline = SystemTime + watched->Period;   //Fresh start, fresh period
+        return true;
+    case WATCHDOG_RESET:
+        ResetCtl_initiateHardReset();
+        return false;
+    case WATCHDOG_LOG:
+    default:
+        return false;   //Stays overdue, WDT_A is the last resort
+    }
+}
+
+/*********************************************** Private Functions ********************************************************************/
+
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Starts the hardware watchdog (WDT_A, ACLK / 32K = 1s)
+ *  - main halts WDT_A, call this right before G8RTOS_Launch
+ *  - The kernel services it from SysTick only while every watched thread is on time
+ */
+void G8RTOS_WatchdogStart()
+{
+    WDT_A_initWatchdogTimer(WDT_A_CLOCKSOURCE_ACLK, WDT_A_CLOCKITERATIONS_32K);
+    HardwareWatchdog = true;
+    WDT_A_startTimer();
+}
+
+/*
+ * Puts the calling thread under the watchdog (calling it again updates the entry)
+ *  - A check-in is missed once periodMS passes without G8RTOS_WatchdogCheckIn
+ *  - Missed check-ins are caught by the next tick, so recovery starts at most periodMS + 1ms
+ *    after the last check-in
+ * Param "periodMS": Longest time allowed between check-ins
+ * Param "recovery": Callback deciding what to do, 0 to always restart the thread
+ * Returns: NO_ERROR, THREAD_LIMIT_REACHED, THREAD_DOES_NOT_EXIST (not called from a thread)
+ *          or PERMISSION_DENIED (unprivileged threads can't install a callback)
+ */
+sched_ErrCode_t G8RTOS_WatchdogRegister(uint32_t periodMS, watchdog_Recovery_t recovery)
+{
+    //Threads trap into the kernel
+    if(G8RTOS_InThreadMode()){
+        return G8RTOS_SVC_WatchdogRegister(periodMS, recovery);
+    }
+
+    if(CurrentlyRunningThread == 0){
+        return THREAD_DOES_NOT_EXIST;
+    }
+
+    //Callback would run privileged inside SysTick
+    if(recovery != 0 && G8RTOS_CallerIsUnprivileged()){
+        return PERMISSION_DENIED;
+    }
+
+    watchdog_t *watched = FindWatchedThread(CurrentlyRunningThread->threadID);
+    if(watched == 0){
+        int i;
+        for(i = 0; i < MAX_WATCHED_THREADS; i++){
+            if(!WatchedThreads[i].inUse){
+                watched = &WatchedThreads[i];
+                watched->Misses = 0;
+                break;
+            }
+        }
+    }
+
+    if(watched == 0){
+        return THREAD_LIMIT_REACHED;
+    }
+
+    watched->threadID = CurrentlyRunningThread->threadID;
+    watched->Period = periodMS;
+    watched->Deadline = SystemTime + periodMS;
+    watched->Recovery = recovery;
+    watched->Overdue = false;
+    watched->inUse = true;
+
+    return NO_ERROR;
+}
+
+/*
+ * Tells the watchdog the calling thread is still making progress
+ */
+void G8RTOS_WatchdogCheckIn()
+{
+    //Threads trap into the kernel
+    if(G8RTOS_InThreadMode()){
+        G8RTOS_SVC_WatchdogCheckIn();
+        return;
+    }
+
+    watchdog_t *watched = FindWatchedThread(CurrentlyRunningThread->threadID);
+    if(watched){
+        watched->Deadline = SystemTime + watched->Period;
+        watched->Overdue = false;
+    }
+}
+
+/*
+ * Kernel side only
+ * Takes a thread off the watchdog (thread was killed)
+ * Param "threadId": Thread to remove
+ */
+void G8RTOS_WatchdogUnregister(threadId_t threadId)
+{
+    watchdog_t *watched = FindWatchedThread(threadId);
+    if(watched){
+        watched->inUse = false;
+    }
+}
+
+/*
+ * Kernel side only, called by SysTick every tick
+ *  - Runs the recovery of every thread that just missed its check-in
+ *  - Services WDT_A only if no watched thread is overdue
+ */
+void G8RTOS_WatchdogTick()
+{
+    bool healthy = true;
+
+    int i;
+    for(i = 0; i < MAX_WATCHED_THREADS; i++){
+        watchdog_t *watched = &WatchedThreads[i];
+
+        //Difference instead of compare so SystemTime wrapping is fine
+        if(!watched->inUse || (int32_t)(SystemTime - watched->Deadline) < 0){
+            continue;
+        }
+
+        //Recovery runs once per miss, the thread stays overdue until it checks in
+        if(!watched->Overdue){
+            if(Recover(watched)){
+                continue;
+            }
+            watched->Overdue = true;
+        }
+        healthy = false;
+    }
+
+    if(healthy && HardwareWatchdog){
+        WDT_A_clearTimer();
+    }
+}
+
+/*
+ * Returns: Total number of missed check-ins since boot
+ */
+uint32_t G8RTOS_GetWatchdogMisses()
+{
+    return TotalMisses;
+}
+
+/*********************************************** Public Functions *********************************************************************/
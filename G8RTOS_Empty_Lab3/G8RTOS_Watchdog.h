@@ -0,0 +1,88 @@
+/*
+ * G8RTOS_Watchdog.h
+ */
+
+#ifndef G8RTOS_WATCHDOG_H_
+#define G8RTOS_WATCHDOG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "G8RTOS_Scheduler.h"
+
+/*********************************************** Sizes and Limits *********************************************************************/
+
+/* Threads that can be watched at the same time */
+#define MAX_WATCHED_THREADS 8
+
+/*********************************************** Sizes and Limits *********************************************************************/
+
+/*********************************************** Datatype Definitions *****************************************************************/
+
+/*
+ * What the kernel does about a missed check-in
+ */
+typedef enum{
+    WATCHDOG_RESTART            =   0,  //Start the thread over from its entry point
+    WATCHDOG_LOG                =   1,  //Leave it, WDT_A resets the board unless it checks in again
+    WATCHDOG_RESET              =   2   //Reset the board right away
+} watchdog_Action_t;
+
+/*
+ * Recovery callback, runs inside SysTick at kernel priority
+ * Param "threadId": Thread that missed its check-in
+ * Param "misses": Number of check-ins that thread has missed so far
+ * Returns: What the kernel does about it
+ */
+typedef watchdog_Action_t (*watchdog_Recovery_t)(threadId_t threadId, uint32_t misses);
+
+/*********************************************** Datatype Definitions *****************************************************************/
+
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Starts the hardware watchdog (WDT_A, ACLK / 32K = 1s)
+ *  - main halts WDT_A, call this right before G8RTOS_Launch
+ *  - The kernel services it from SysTick only while every watched thread is on time
+ */
+void G8RTOS_WatchdogStart();
+
+/*
+ * Puts the calling thread under the watchdog (calling it again updates the entry)
+ *  - A check-in is missed once periodMS passes without G8RTOS_WatchdogCheckIn
+ *  - Missed check-ins are caught by the next tick, so recovery starts at most periodMS + 1ms
+ *    after the last check-in
+ * Param "periodMS": Longest time allowed between check-ins
+ * Param "recovery": Callback deciding what to do, 0 to always restart the thread
+ * Returns: NO_ERROR, THREAD_LIMIT_REACHED, THREAD_DOES_NOT_EXIST (not called from a thread)
+ *          or PERMISSION_DENIED (unprivileged threads can't install a callback)
+ */
+sched_ErrCode_t G8RTOS_WatchdogRegister(uint32_t periodMS, watchdog_Recovery_t recovery);
+
+/*
+ * Tells the watchdog the calling thread is still making progress
+ */
+void G8RTOS_WatchdogCheckIn();
+
+/*
+ * Kernel side only
+ * Takes a thread off the watchdog (thread was killed)
+ * Param "threadId": Thread to remove
+ */
+void G8RTOS_WatchdogUnregister(threadId_t threadId);
+
+/*
+ * Kernel side only, called by SysTick every tick
+ *  - Runs the recovery of every thread that just missed its check-in
+ *  - Services WDT_A only if no watched thread is overdue
+ */
+void G8RTOS_WatchdogTick();
+
+/*
+ * Returns: Total number of missed check-ins since boot
+ */
+uint32_t G8RTOS_GetWatchdogMisses();
+
+/*********************************************** Public Functions *********************************************************************/
+
+#endif /* G8RTOS_WATCHDOG_H_ */
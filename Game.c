@@ -15,6 +15,67 @@
 #include <stdio.h>
 #include <time.h>
 #include "G8RTOS_CriticalSection.h"
+#include "Game.h"
+#include "DirtyRect.h"
+#include "TileRender.h"
+#include "FramePacing.h"
+
+/*********************************************** Data Structures ********************************************************************/
+
+/* Game state as the host keeps it (the client mirrors it from packets) */
+GameState_t GameState;
+
+/* Everything that changed on screen this frame, painted once per frame by DrawObjects */
+static DirtyRegion_t FrameRegion;
+
+/* What the changed areas are repainted from, balls under the paddles */
+static Scene_t FrameScene;
+static Sprite_t BallSprites[MAX_NUM_OF_BALLS];
+static Sprite_t PlayerSprites[MAX_NUM_OF_PLAYERS];
+
+/*********************************************** Data Structures ********************************************************************/
+
+/*********************************************** Private Functions ********************************************************************/
+
+/*
+ * First row a paddle covers
+ */
+static int16_t PaddleTop(playerPosition position)
+{
+    return (position == TOP) ? ARENA_MIN_Y : BOTTOM_PADDLE_EDGE;
+}
+
+/*
+ * Screen area a paddle covers with its center at "center"
+ */
+static void AddPaddle(int16_t center, playerPosition position, uint16_t color)
+{
+    int16_t yStart = PaddleTop(position);
+    DirtyRect_Add(&FrameRegion, center - PADDLE_LEN_D2, center + PADDLE_LEN_D2 - 1,
+                  yStart, yStart + PADDLE_WID - 1, color);
+}
+
+/*
+ * Repaints a changed area from the scene
+ *  - The area's color is not needed, overlapping sprites are composited tile by tile
+ *  - With frame pacing on the area waits until the panel scan is out of its way
+ */
+static void RepaintArea(int16_t xStart, int16_t xEnd, int16_t yStart, int16_t yEnd, uint16_t Color)
+{
+    FramePacing_WaitClear(xStart, xEnd, (uint32_t)(xEnd - xStart + 1) * (yEnd - yStart + 1));
+    TileRender_Draw(&FrameScene, xStart, xEnd, yStart, yEnd);
+}
+
+/*
+ * Screen area a ball covers with its center at (centerX, centerY)
+ */
+static void AddBall(int16_t centerX, int16_t centerY, uint16_t color)
+{
+    DirtyRect_Add(&FrameRegion, centerX - BALL_SIZE_D2, centerX + BALL_SIZE_D2 - 1,
+                  centerY - BALL_SIZE_D2, centerY + BALL_SIZE_D2 - 1, color);
+}
+
+/*********************************************** Private Functions ********************************************************************/
 
 /*********************************************** Common Threads *********************************************************************/
 /*
@@ -33,10 +94,92 @@ void IdleThread(){
  * -Should hold arrays of previous players and ball positions
  * -Draw and/or update balls (use alive attribute to tell if draw new or update position)
  * -Update players
- * -Sleep for 20ms (reasonable refresh rate)
+ * -Sleep for 20ms (reasonable refresh rate), or wait for the frame marker with GAME_FRAME_PACING
  */
 void DrawObjects(){
+    PrevBall_t prevBalls[MAX_NUM_OF_BALLS];
+    bool ballOnScreen[MAX_NUM_OF_BALLS] = {false};
+    PrevPlayer_t prevPlayers[MAX_NUM_OF_PLAYERS];
+    int i;
+    bool paced = false;
+
+#if GAME_FRAME_PACING
+    //Without the FMARK handler the loop keeps its 20ms sleep
+    paced = FramePacing_Init(GAME_FRAME_PACING, 0);
+#endif
+
+    DirtyRect_Init(&FrameRegion, RepaintArea);
+    TileRender_Init(&FrameScene, BACK_COLOR, LCD_BlitRGB565);
+
+    for(i = 0; i < MAX_NUM_OF_BALLS; i++){
+        BallSprites[i].w = BALL_SIZE;
+        BallSprites[i].h = BALL_SIZE;
+        BallSprites[i].Pixels = 0;
+        BallSprites[i].Visible = false;
+        TileRender_AddSprite(&FrameScene, &BallSprites[i]);
+    }
+
+    for(i = 0; i < MAX_NUM_OF_PLAYERS; i++){
+        GeneralPlayerInfo_t *player = &GameState.players[i];
+        prevPlayers[i].Center = player->currentCenter;
+        PlayerSprites[i].x = player->currentCenter - PADDLE_LEN_D2;
+        PlayerSprites[i].y = PaddleTop(player->position);
+        PlayerSprites[i].w = PADDLE_LEN;
+        PlayerSprites[i].h = PADDLE_WID;
+        PlayerSprites[i].Color = player->color;
+        PlayerSprites[i].Pixels = 0;
+        PlayerSprites[i].Visible = true;
+        TileRender_AddSprite(&FrameScene, &PlayerSprites[i]);
 
+        //Moves only repaint strips, the whole paddle has to go out once (DrawPlayer's went with the Init)
+        AddPaddle(player->currentCenter, player->position, player->color);
+    }
+
+    while(1){
+        //Balls only send the edges they moved over
+        for(i = 0; i < MAX_NUM_OF_BALLS; i++){
+            Ball_t ball = GameState.balls[i];
+            if(ball.alive && ballOnScreen[i]){
+                UpdateBallOnScreen(&prevBalls[i], &ball, ball.color);
+            }
+            else if(ball.alive){
+                AddBall(ball.currentCenterX, ball.currentCenterY, ball.color);
+                prevBalls[i].CenterX = ball.currentCenterX;
+                prevBalls[i].CenterY = ball.currentCenterY;
+                ballOnScreen[i] = true;
+            }
+            else if(ballOnScreen[i]){
+                AddBall(prevBalls[i].CenterX, prevBalls[i].CenterY, BACK_COLOR);
+                ballOnScreen[i] = false;
+            }
+
+            BallSprites[i].x = ball.currentCenterX - BALL_SIZE_D2;
+            BallSprites[i].y = ball.currentCenterY - BALL_SIZE_D2;
+            BallSprites[i].Color = ball.color;
+            BallSprites[i].Visible = ball.alive;
+        }
+
+        //Paddles only send the columns they moved over, the scene keeps them on top of the balls
+        for(i = 0; i < MAX_NUM_OF_PLAYERS; i++){
+            GeneralPlayerInfo_t player = GameState.players[i];
+            UpdatePlayerOnScreen(&prevPlayers[i], &player);
+
+            PlayerSprites[i].x = player.currentCenter - PADDLE_LEN_D2;
+            PlayerSprites[i].Color = player.color;
+        }
+
+        //Frame starts on the marker, each area then goes out behind the scan
+        if(paced){
+            FramePacing_WaitFrame();
+        }
+
+        //One ordered pass over the merged areas, each composited from the scene
+        DirtyRect_Flush(&FrameRegion);
+
+        if(!paced){
+            sleep(20);
+        }
+    }
 }
 
 /*
@@ -44,6 +187,50 @@ void DrawObjects(){
  */
 void MoveLEDs();
 
+/*********************************************** Common Threads *********************************************************************/
 
-/*********************************************** Data Structures ********************************************************************/
+
+/*********************************************** Public Functions *********************************************************************/
+
+/*
+ * Draw players given center X center coordinate
+ */
+void DrawPlayer(GeneralPlayerInfo_t * player){
+    AddPaddle(player->currentCenter, player->position, player->color);
+}
+
+/*
+ * Updates player's paddle based on current and new center
+ *  - Only the columns the paddle left are erased and the columns it moved onto drawn,
+ *    O(displacement) pixels instead of the whole PADDLE_LEN x PADDLE_WID bar
+ *  - Moves of a paddle length or more no longer overlap and redraw the whole paddle
+ *  - Painted with the rest of the frame by DrawObjects
+ */
+void UpdatePlayerOnScreen(PrevPlayer_t * prevPlayerIn, GeneralPlayerInfo_t * outPlayer){
+    int16_t yStart = PaddleTop(outPlayer->position);
+
+    DirtyRect_AddMove(&FrameRegion,
+                      prevPlayerIn->Center - PADDLE_LEN_D2, yStart,
+                      outPlayer->currentCenter - PADDLE_LEN_D2, yStart,
+                      PADDLE_LEN, PADDLE_WID, outPlayer->color, BACK_COLOR);
+
+    prevPlayerIn->Center = outPlayer->currentCenter;
+}
+
+/*
+ * Function updates ball position on screen
+ *  - Only the trailing edges are erased and the leading edges drawn
+ *  - Painted with the rest of the frame by DrawObjects
+ */
+void UpdateBallOnScreen(PrevBall_t * previousBall, Ball_t * currentBall, uint16_t outColor){
+    DirtyRect_AddMove(&FrameRegion,
+                      previousBall->CenterX - BALL_SIZE_D2, previousBall->CenterY - BALL_SIZE_D2,
+                      currentBall->currentCenterX - BALL_SIZE_D2, currentBall->currentCenterY - BALL_SIZE_D2,
+                      BALL_SIZE, BALL_SIZE, outColor, BACK_COLOR);
+
+    previousBall->CenterX = currentBall->currentCenterX;
+    previousBall->CenterY = currentBall->currentCenterY;
+}
+
+/*********************************************** Public Functions *********************************************************************/
 
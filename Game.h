@@ -80,6 +80,10 @@
 /* Background color - Black */
 #define BACK_COLOR                   LCD_BLACK
 
+/* Panel frames per game frame on the FMARK frame marker (1, 2, 4 or 6), 0 sleeps 20ms a frame instead.
+ * Needs the panel's FMARK pad wired to FRAME_FMARK_PIN */
+#define GAME_FRAME_PACING            0
+
 /* Offset for printing player to avoid blips from left behind ball */
 #define PRINT_OFFSET                10
 
@@ -20,6 +20,7 @@ void main(void)
 
 //	initCC3100();
 
+//	G8RTOS_WatchdogStart();    //WDT_A is serviced by the kernel from here on
 //	G8RTOS_Launch();    //Starts G8RTOS
 
 	while(1){
@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+"""
+fontgen.py
+
+Generates BoardSupportPackage/src/LCD_FontTables.c, the glyph tables behind
+the Font_t descriptors in LCD_Font.h, from the 8x16 System font in
+BoardSupportPackage/src/AsciiLib.c.
+
+ - Font_System8x16: the AsciiLib glyphs as they are, 8 pixels per character
+ - Font_Proportional: the same glyphs moved to the left edge with their own
+   advance (used columns plus one blank column), space is 4 pixels
+
+Run it again whenever AsciiLib.c changes:
+    python3 tools/fontgen.py > BoardSupportPackage/src/LCD_FontTables.c
+"""
+
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+ASCIILIB = os.path.join(ROOT, 'BoardSupportPackage', 'src', 'AsciiLib.c')
+
+FIRST_CHAR = 32
+HEIGHT = 16
+SPACE_WIDTH = 4
+GAP = 1
+
+
+def read_system_font():
+    """Returns 95 glyphs of 16 row bytes from the ASCII_8X16_System table"""
+    with open(ASCIILIB) as f:
+        text = f.read()
+    section = text[text.index('#ifdef ASCII_8X16_System'):]
+    section = section[:section.index('#endif')]
+    glyphs = []
+    for row in re.findall(r'\{((?:\s*0x[0-9A-Fa-f]{2}\s*,?){16})\}', section):
+        glyphs.append([int(v, 16) for v in re.findall(r'0x[0-9A-Fa-f]{2}', row)])
+    if len(glyphs) != 95:
+        raise ValueError('expected 95 glyphs in AsciiLib.c, found %d' % len(glyphs))
+    return glyphs
+
+
+def proportional(glyph):
+    """Returns (advance, rows moved to the left edge)"""
+    used = 0
+    for row in glyph:
+        used |= row
+    if used == 0:
+        return SPACE_WIDTH, list(glyph)
+    left = 0
+    while not used & (0x80 >> left):
+        left += 1
+    right = 7
+    while not used & (0x80 >> right):
+        right -= 1
+    return right - left + 1 + GAP, [(row << left) & 0xFF for row in glyph]
+
+
+def table(glyphs):
+    lines = []
+    for i, glyph in enumerate(glyphs):
+        ch = chr(FIRST_CHAR + i)
+        name = {' ': 'space', '\\': 'backslash', '*': 'star'}.get(ch, ch)
+        lines.append('    ' + ','.join('0x%02X' % b for b in glyph) + ',    //%s' % name)
+    return '\n'.join(lines)
+
+
+def main():
+    glyphs = read_system_font()
+    widths, rows = zip(*[proportional(g) for g in glyphs])
+
+    out = '''/*
+ * LCD_FontTables.c
+ *
+ * Generated by tools/fontgen.py from AsciiLib.c (ASCII_8X16_System), do not edit
+ *  - Rows are one byte per glyph row, the most significant bit is the leftmost pixel
+ */
+
+#include <stdint.h>
+#include "LCD_Font.h"
+
+/*********************************************** Glyph Tables *************************************************************************/
+
+static const uint8_t System8x16Rows[95 * 16] = {{
+{fixed}
+}};
+
+static const uint8_t ProportionalRows[95 * 16] = {{
+{prop}
+}};
+
+static const uint8_t ProportionalWidths[95] = {{
+{widths}
+}};
+
+/*********************************************** Glyph Tables *************************************************************************/
+
+/*********************************************** Fonts ********************************************************************************/
+
+const Font_t Font_System8x16 = {{ {first}, {last}, 8, {height}, 0, System8x16Rows }};
+
+const Font_t Font_Proportional = {{ {first}, {last}, 8, {height}, ProportionalWidths, ProportionalRows }};
+
+/*********************************************** Fonts ********************************************************************************/
+'''.format(fixed=table(glyphs), prop=table(rows),
+           widths='\n'.join('    ' + ', '.join(str(w) for w in widths[i:i + 16]) + ','
+                            for i in range(0, 95, 16)),
+           first=FIRST_CHAR, last=FIRST_CHAR + 94, height=HEIGHT)
+    sys.stdout.write(out)
+
+
+if __name__ == '__main__':
+    main()
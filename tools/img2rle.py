@@ -0,0 +1,224 @@
+#!/usr/bin/env python3
+"""
+img2rle.py
+
+Converts a PNG into the palette indexed, run length encoded format read by
+BoardSupportPackage/src/RLEImage.c and writes it out as a C file holding a
+const RLEImage_t (flash only).
+
+ - Colors are reduced to RGB565 first, the panel cannot show more
+ - If there are still more than 256 colors the low bits are dropped one
+   at a time until they fit
+ - Only the Python standard library is used, 8 bit non interlaced PNGs
+   (gray, RGB, palette, with or without alpha) are read
+
+Usage:
+    python3 tools/img2rle.py splash.png SplashImage > SplashImage.c
+    python3 tools/img2rle.py splash.png SplashImage -o SplashImage.c
+
+Then declare it where it is drawn:
+    extern const RLEImage_t SplashImage;
+    RLEImage_Draw(&SplashImage, 0, 0, LCD_BlitRGB565);
+"""
+
+import argparse
+import struct
+import sys
+import zlib
+
+# Must match RLEImage.h
+RLE_LITERAL = 0x80
+RLE_MAX_COUNT = 128
+RLE_BUFFER_PIXELS = 1024
+
+# Transparent pixels (alpha under half) take this color
+DEFAULT_BACKGROUND = (0, 0, 0)
+
+
+def read_png(path):
+    """Returns (width, height, rows of (r, g, b) tuples)"""
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:8] != b'\x89PNG\r\n\x1a\n':
+        raise ValueError('%s is not a PNG' % path)
+
+    pos = 8
+    idat = b''
+    palette = []
+    header = None
+    while pos < len(data):
+        length, kind = struct.unpack('>I4s', data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b'IHDR':
+            header = struct.unpack('>IIBBBBB', body)
+        elif kind == b'PLTE':
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif kind == b'IDAT':
+            idat += body
+        elif kind == b'IEND':
+            break
+
+    width, height, depth, color, _, _, interlace = header
+    if depth != 8 or interlace != 0:
+        raise ValueError('only 8 bit non interlaced PNGs are supported')
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color]
+
+    raw = zlib.decompress(idat)
+    stride = width * channels
+    rows = []
+    previous = bytearray(stride)
+    pos = 0
+    for _ in range(height):
+        kind = raw[pos]
+        line = bytearray(raw[pos + 1:pos + 1 + stride])
+        pos += 1 + stride
+        for i in range(stride):
+            a = line[i - channels] if i >= channels else 0
+            b = previous[i]
+            c = previous[i - channels] if i >= channels else 0
+            if kind == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif kind == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif kind == 3:
+                line[i] = (line[i] + ((a + b) >> 1)) & 0xFF
+            elif kind == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                predictor = a if pa <= pb and pa <= pc else (b if pb <= pc else c)
+                line[i] = (line[i] + predictor) & 0xFF
+        previous = line
+
+        pixels = []
+        for x in range(width):
+            px = line[x * channels:(x + 1) * channels]
+            if color == 0:
+                rgb, alpha = (px[0],) * 3, 255
+            elif color == 2:
+                rgb, alpha = tuple(px), 255
+            elif color == 3:
+                rgb, alpha = palette[px[0]], 255
+            elif color == 4:
+                rgb, alpha = (px[0],) * 3, px[1]
+            else:
+                rgb, alpha = tuple(px[:3]), px[3]
+            pixels.append(rgb if alpha >= 128 else DEFAULT_BACKGROUND)
+        rows.append(pixels)
+    return width, height, rows
+
+
+def to_rgb565(rgb, drop):
+    """RGB888 to RGB565, with "drop" more low bits cleared in every channel"""
+    r, g, b = rgb
+    r, g, b = r >> 3, g >> 2, b >> 3
+    r &= ~((1 << drop) - 1) & 0x1F
+    g &= ~((1 << drop) - 1) & 0x3F
+    b &= ~((1 << drop) - 1) & 0x1F
+    return (r << 11) | (g << 5) | b
+
+
+def quantize(pixels):
+    """Returns (palette, indexes), fewest dropped bits that fit in 256 colors"""
+    for drop in range(6):
+        colors = [to_rgb565(p, drop) for p in pixels]
+        unique = set(colors)
+        if len(unique) <= 256:
+            # Most used first so the palette reads well in the C file
+            counts = {}
+            for c in colors:
+                counts[c] = counts.get(c, 0) + 1
+            palette = sorted(unique, key=lambda c: -counts[c])
+            lookup = {c: i for i, c in enumerate(palette)}
+            if drop:
+                sys.stderr.write('img2rle: dropped %d low bits to fit 256 colors\n' % drop)
+            return palette, [lookup[c] for c in colors]
+    raise ValueError('could not reduce the image to 256 colors')
+
+
+def encode(indexes):
+    """Packs palette indexes into run and literal packets"""
+    out = bytearray()
+    literal = []
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:RLE_MAX_COUNT]
+            del literal[:RLE_MAX_COUNT]
+            out.append(RLE_LITERAL | (len(chunk) - 1))
+            out.extend(chunk)
+
+    i = 0
+    while i < len(indexes):
+        run = 1
+        while i + run < len(indexes) and run < RLE_MAX_COUNT and indexes[i + run] == indexes[i]:
+            run += 1
+        # A run of 2 costs the same as 2 literals, only break a literal for 3 or more
+        if run >= 3 or (run == 2 and not literal):
+            flush_literal()
+            out.append(run - 1)
+            out.append(indexes[i])
+        else:
+            literal.extend(indexes[i:i + run])
+        i += run
+    flush_literal()
+    return out
+
+
+def c_array(values, per_line, fmt):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append('    ' + ', '.join(fmt % v for v in values[i:i + per_line]) + ',')
+    return '\n'.join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='PNG to RLEImage_t C source')
+    parser.add_argument('png')
+    parser.add_argument('name', help='C name of the RLEImage_t')
+    parser.add_argument('-o', '--output', help='C file to write (default stdout)')
+    args = parser.parse_args()
+
+    width, height, rows = read_png(args.png)
+    if width > RLE_BUFFER_PIXELS:
+        raise ValueError('image is wider than RLE_BUFFER_PIXELS (%d)' % RLE_BUFFER_PIXELS)
+
+    palette, indexes = quantize([p for row in rows for p in row])
+    data = encode(indexes)
+
+    source = '''/*
+ * {name}.c
+ *
+ * Generated by tools/img2rle.py from {png}, do not edit
+ *  - {width}x{height}, {colors} colors, {size} bytes of data ({raw} bytes raw)
+ */
+
+#include <stdint.h>
+#include "RLEImage.h"
+
+static const uint16_t {name}Palette[{colors}] = {{
+{palette}
+}};
+
+static const uint8_t {name}Data[{size}] = {{
+{data}
+}};
+
+const RLEImage_t {name} = {{
+    {width}, {height}, {colors}, {name}Palette, {size}, {name}Data
+}};
+'''.format(name=args.name, png=args.png.split('/')[-1], width=width, height=height,
+           colors=len(palette), size=len(data), raw=width * height * 2,
+           palette=c_array(palette, 8, '0x%04X'), data=c_array(list(data), 16, '0x%02X'))
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(source)
+    else:
+        sys.stdout.write(source)
+    sys.stderr.write('img2rle: %s %dx%d, %d colors, %d bytes (raw %d)\n'
+                     % (args.name, width, height, len(palette), len(data), width * height * 2))
+
+
+if __name__ == '__main__':
+    main()